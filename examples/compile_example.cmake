@@ -12,21 +12,28 @@ set(EXAMPLES_LIST
 				${EXAMPLES_DIR}/message/serialize_class.cpp
 				${EXAMPLES_DIR}/message/serialize_parse_reliable.cpp
 				${EXAMPLES_DIR}/message/signaling.cpp
-				${EXAMPLES_DIR}/message/no_response.cpp	
+				${EXAMPLES_DIR}/message/no_response.cpp
+				${EXAMPLES_DIR}/message/custom_option.cpp
 				${EXAMPLES_DIR}/uri/decompose.cpp
 				${EXAMPLES_DIR}/resource/discovery.cpp
+				${EXAMPLES_DIR}/resource/static_table.cpp
+				${EXAMPLES_DIR}/resource/pattern.cpp
 				${EXAMPLES_DIR}/transmission/raw_transaction.cpp
 				${EXAMPLES_DIR}/transmission/raw_engine.cpp
 				${EXAMPLES_DIR}/transmission/engine_server.cpp
 				${EXAMPLES_DIR}/transmission/request_get_block_wise.cpp
 				${EXAMPLES_DIR}/transmission/request_put_block_wise.cpp
 				${EXAMPLES_DIR}/transmission/response_block_wise.cpp
+				${EXAMPLES_DIR}/transmission/request_q_block.cpp
 				${EXAMPLES_DIR}/transmission/engine_tcp_client.cpp
 				${EXAMPLES_DIR}/transmission/engine_tcp_server.cpp
+				${EXAMPLES_DIR}/transmission/multicast_server.cpp
+				${EXAMPLES_DIR}/transmission/multicast_client.cpp
 				${EXAMPLES_DIR}/observe/client_observe.cpp
 				${EXAMPLES_DIR}/observe/server_observe.cpp
 				${EXAMPLES_DIR}/observe/tcp_client_observe.cpp
 				${EXAMPLES_DIR}/observe/tcp_server_observe.cpp
+				${EXAMPLES_DIR}/proxy/proxy.cpp
 				${EXAMPLES_DIR}/port/endpoint_ipv6.cpp
 				${EXAMPLES_DIR}/port/udp_server.cpp
 				${EXAMPLES_DIR}/port/udp_client.cpp
@@ -40,15 +47,21 @@ set(EXAMPLES_LIST_JSON ${EXAMPLES_DIR}/json/convert_to_json.cpp)
 
 #List of examples that must link to network at emscripten
 list(APPEND emscripten_net_list raw_transaction
+								static_table
+								pattern
 								raw_engine
 								engine_server
 								request_get_block_wise
 								request_put_block_wise
 								response_block_wise
+								request_q_block
 								engine_tcp_client
 								engine_tcp_server
+								multicast_server
+								multicast_client
 								client_observe
 								server_observe
+								proxy
 								endpoint_ipv6
 								udp_server
 								udp_client
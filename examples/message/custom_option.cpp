@@ -0,0 +1,151 @@
+/**
+ * This example shows how to define your own options (as vendor
+ * specific options), without changing the library.
+ *
+ * The options of a option code enum are registered at 'option_registry'
+ * (the configuration of each option: code, repeatable, type). The registry
+ * is built at compile time, so the option configuration is found by a
+ * table lookup (no search) when parsing/serializing.
+ *
+ * The option code enum is the 'OptionCode' template parameter of the
+ * option types and the parse/serialize functions.
+ *
+ * Option number ranges: https://tools.ietf.org/html/rfc7252#section-12.2
+ */
+#include <cstdint>
+#include <cstdio>
+
+#include "coap-te/log.hpp"		//Log header
+#include "coap-te.hpp"			//Convenient header
+#include "coap-te-debug.hpp"	//Convenient debug header
+
+using namespace CoAP::Message;
+using namespace CoAP::Log;
+
+#define BUFFER_LEN		128
+
+/**
+ * Our option codes: the standard options that we use and our options.
+ * Odd numbers are critical options, even numbers are elective.
+ */
+enum class vendor_code{
+	uri_path		= static_cast<int>(Option::code::uri_path),
+	content_format	= static_cast<int>(Option::code::content_format),
+	device_id		= 2049,		//Critical
+	trace			= 65000,	//Elective (experimental range)
+};
+
+static constexpr const Option::config<vendor_code> vendor_options[] = {
+	{vendor_code::uri_path,			true,	Option::type::string},
+	{vendor_code::content_format,	false,	Option::type::uint},
+	{vendor_code::device_id,		false,	Option::type::uint},
+	{vendor_code::trace,			true,	Option::type::opaque},
+};
+
+/**
+ * Registering our options. If you want all the standard options, use:
+ *
+ * static constexpr auto vendor_options = Option::extend_options(Option::options, custom);
+ */
+namespace CoAP{
+namespace Message{
+namespace Option{
+
+template<>
+struct option_registry<vendor_code>{
+	static constexpr const registry<vendor_code,
+			std::size(vendor_options),
+			registry_dense_size(vendor_options)> table{vendor_options};
+};
+
+}//Option
+}//Message
+}//CoAP
+
+using vendor_option = Option::option_template<vendor_code>;
+
+/**
+ * Auxiliar function
+ */
+static void exit_error(CoAP::Error& ec, const char* what = nullptr)
+{
+	error(ec, what);
+	exit(EXIT_FAILURE);
+}
+
+int main()
+{
+	status("Custom option example...");
+
+	/**
+	 * Registry checked at compile time
+	 */
+	static_assert(Option::get_config(vendor_code::device_id)->otype == Option::type::uint,
+			"Wrong type");
+	static_assert(Option::get_config(static_cast<vendor_code>(2050)) == nullptr,
+			"Not registered");
+
+	unsigned device = 0x1234;
+	std::uint8_t trace[] = {0xde, 0xad, 0xbe, 0xef};
+	vendor_option options[] = {
+			{vendor_code::trace, trace, sizeof(trace)},
+			{vendor_code::uri_path, "sensor"},
+			{vendor_code::device_id, device}
+	};
+
+	/**
+	 * Serializing
+	 */
+	CoAP::Error ec;
+	std::uint8_t buffer[BUFFER_LEN];
+	std::uint8_t token[] = {0x01, 0x02};
+	std::uint16_t mid = 0x1010;
+
+	unsigned size = make_header(buffer, BUFFER_LEN,
+						CoAP::Message::type::confirmable, code::get, mid,
+						token, sizeof(token), ec);
+	if(ec) exit_error(ec, "make_header");
+	size += make_options<vendor_code>(buffer + size, BUFFER_LEN - size,
+						options, sizeof(options) / sizeof(vendor_option), ec);
+	if(ec) exit_error(ec, "make_options");
+
+	status("Serialized [%u]", size);
+
+	/**
+	 * Parsing (the options are checked against our registry)
+	 */
+	message msg;
+	unsigned offset = parse_header(msg, buffer, size, ec);
+	if(ec) exit_error(ec, "parse_header");
+	parse_options<message, vendor_code>(msg, buffer + offset, size - offset, ec);
+	if(ec) exit_error(ec, "parse_options");
+
+	Option::Parser<vendor_code> parser(msg);
+	vendor_option const* op;
+	while((op = parser.next()) != nullptr)
+	{
+		auto const* config = Option::get_config(op->ocode);
+		std::printf("%5u|%s|%s[%u]: ",
+				static_cast<unsigned>(op->ocode),
+				op->is_critical() ? "critical" : "elective",
+				config->repeatable ? "repeatable" : "single",
+				op->length);
+		switch(config->otype)
+		{
+			case Option::type::string:
+				std::printf("%.*s\n", static_cast<int>(op->length),
+						static_cast<char const*>(op->value));
+				break;
+			case Option::type::uint:
+				std::printf("%u\n", Option::parse_unsigned(*op));
+				break;
+			default:
+				for(unsigned i = 0; i < op->length; i++)
+					std::printf("%02X", static_cast<std::uint8_t const*>(op->value)[i]);
+				std::printf("\n");
+				break;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
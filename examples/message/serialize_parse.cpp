@@ -31,6 +31,13 @@
  * make a list or use a array. Let it uncommented to see how to use a list
  */
 #define TEST_LIST
+/**
+ * If defined (has precedence over the above), shows how to use a option set:
+ * the options codes are defined at compile time (sorted and checked), and
+ * only the values are set at runtime. Good to messages that always have
+ * the same options.
+ */
+//#define TEST_OPTION_SET
 
 using namespace CoAP::Message;
 using namespace CoAP::Log;
@@ -68,7 +75,35 @@ int main()
 	CoAP::Message::accept content = accept::application_json;
 	const char* payload = "my data";
 
-#if !defined(TEST_LIST) && !defined(TEST_FACTORY)
+#if defined(TEST_OPTION_SET)
+	status(example_mod, "Testing option set...");
+
+	/**
+	 * The option codes in any order (they are sorted at compile time). The
+	 * values are set by the index of the code at the template list.
+	 */
+	Option::option_set<
+			Option::code::uri_path,
+			Option::code::uri_path,
+			Option::code::accept> options;
+
+	unsigned accept_value = static_cast<unsigned>(content);
+	options
+		.set<0>("sensor")
+		.set<1>("temp")
+		.set<2>(accept_value);
+
+	status(example_mod, "Serializing...");
+	std::size_t size = serialize(
+			buffer, BUFFER_LEN,					//Buffer/buffer length where data will be serialize
+			CoAP::Message::type::confirmable,	//Message type (check message/types.hpp)
+			code::get,							//Message code (check message/codes.hpp)
+			mid(),								//Message ID generator
+			token, sizeof(token),				//Token and token size
+			options,							//The option set declared above
+			payload, std::strlen(payload),		//Payload/payload length
+			ec);
+#elif !defined(TEST_LIST) && !defined(TEST_FACTORY)
 	status(example_mod, "Testing options array...");
 
 	/**
@@ -14,7 +14,8 @@
  * A overview of the resources:
  * -------
  * * time: Observable. Returns the device current time. If register to observe will receive
- * time every 30 seconds.
+ * time every 30 seconds. The period can be changed with the conditional attributes at the
+ * register query ('pmin=<seconds>', 'pmax=<seconds>'). Each 4th notification is confirmable.
  * -------
  * * sensors: Observable. Returns random values simulating a
  * read sensor. If you register to observe this resource, you can define the frequency
@@ -29,11 +30,10 @@
  * Notification can be sent in a confirmable or non-confirmable way. time and sensor resource
  * are sent non-confirmable, type resource is confirmable.
  *
- * \note When using confirmable type to send notification, it will allocate one transaction slot
- * that will be only released after receive a ack from the client. If there is no available slots,
- * You must wait to free one slot to send the remaining notifications. This behaivour is NOT handled
- * by the CoAP-te engine... So prefer using non-confirmable notifications or limit the number of
- * observers...
+ * The time and type notifications are sent using a notifier: the notification is serialized
+ * once, and just the header (type, message ID and token) is changed to each observer.
+ * Confirmable notifications are tracked by the notifier (not by the engine transactions), that
+ * retransmits and reports ACK/RST/timeout.
  *
  * This example is to be run with the 'client_observe' example.
  */
@@ -41,6 +41,7 @@
 #include <cstdio>
 #include <chrono>
 #include <thread>
+#include <mutex>
 //#include <iostream>
 
 #include "coap-te/log.hpp"				//Log header
@@ -88,7 +89,7 @@ using engine = CoAP::Transmission::engine<
 				CoAP::Transmission::transaction_cb,		/* transaction callback type */
 				endpoint>,								/* transaction endpoint type */
 			4>,										/* number of transaction */
-		CoAP::disable,								/* default callback disabled */
+		CoAP::Transmission::default_cb<endpoint>,	/* default callback (notifications ACK/RST) */
 		CoAP::Resource::resource<					/* resource */
 			CoAP::Resource::callback<endpoint>,			/* resource callback type */
 			true										/* enabling resource description */
@@ -124,8 +125,12 @@ using observe_list = CoAP::Observe::list_vector<CoAP::Observe::observe<endpoint,
 /**
  * The default observe container. It can hold a predefined number of observers... if
  * more observers try to register, it will reject! More suitable for constrained devices.
+ *
+ * The registry indexes the observers by endpoint/token (no linear search at
+ * register/deregister/reset), and iterates just the registered observers
+ * when notifying.
  */
-using observe_list = CoAP::Observe::list<
+using observe_list = CoAP::Observe::registry<
 						CoAP::Observe::observe<				//Observer type
 							endpoint,						//Endpoint
 							false							//Don't store order information (used just at clients)
@@ -134,16 +139,48 @@ using observe_list = CoAP::Observe::list<
 					>;
 #endif
 
+/**
+ * The time observers have each one its own scheduler, that defines when (pmin/pmax)
+ * and how (confirmable/non-confirmable) to notify.
+ */
+#ifdef USE_OBSERVER_VECTOR
+using time_observe_list = CoAP::Observe::list_vector<CoAP::Observe::scheduled_observe<endpoint>>;
+#else
+using time_observe_list = CoAP::Observe::registry<CoAP::Observe::scheduled_observe<endpoint>, 5>;
+#endif
+
+/**
+ * Default time notification attributes (pmin, pmax, st)
+ */
+static constexpr const CoAP::Observe::attributes time_attr{30, 0, 0};
+
 /**
  * Instantiation of the observer container
  */
-static observe_list time_list;		///< time observer container
+static time_observe_list time_list;	///< time observer container
 static observe_list type_list;		///< type observer container
 /**
  * Holds the last typed characters
  */
 static char typed = 0;
 
+/**
+ * Notifiers: serialize the notification once to all observers of a list.
+ * Template parameters: endpoint, max options/payload size, max pending
+ * confirmable notifications, and the number of slots. The pending size must
+ * hold one confirmable notification to each observer (the fan-out): if
+ * there is no room, the confirmable notification is not sent.
+ */
+using notifier = CoAP::Observe::notifier<endpoint, 64, 5, 2>;
+
+static notifier time_notifier;		///< time notifications (scheduled)
+static notifier type_notifier;		///< type notifications (confirmable)
+/**
+ * The notifiers are called from the notification threads and from the
+ * engine loop (ACK/retransmission)
+ */
+static std::mutex notifier_mtx;
+
 /**
  * As the sensor can send a notification at a frequency defined by the user,
  * we must hold the frequency value and the initial time it start to observe.
@@ -226,59 +263,43 @@ static void exit_error(CoAP::Error& ec, const char* what = nullptr)
  */
 
 /**
- * This thread will send every 30 seconds the device local time to all
- * registered observes...
+ * The time changes every second, but it will be notified only to the observers
+ * which scheduler is due (by default, every 30 seconds)...
  */
 static void thread_time(engine& engine)
 {
 	while(true)
 	{
-		CoAP::time_t t = CoAP::time() / 1000;
-		if((t % 30) == 0)
 		{
+			std::lock_guard<std::mutex> lock(notifier_mtx);
 			/**
-			 * Iterate thought the container
+			 * Resource updated (last value wins)
 			 */
-			for(unsigned i = 0; i < time_list.size(); i++)
-			{
-				/**
-				 * Check if is a valid observer
-				 */
-				if(time_list[i]->is_used())
-				{
-					debug(example_mod, "sending time");
-					/**
-					 * Making a request
-					 *
-					 * By default it uses non-confirmable type message
-					 */
-					engine::request req{*time_list[i]};
-
-					/**
-					 * All observe notification must be associated with a observe
-					 * option with a sync number.
-					 *
-					 * We are going to generate this number based on the system clock
-					 */
-					unsigned num = CoAP::Observe::generate_option_value_from_clock();
-					CoAP::Message::Option::node obs_op{CoAP::Message::Option::code::observe, num};
-					req.add_option(obs_op);
-
-					/**
-					 * Seting a payload
-					 */
-					char buff[20];
-					std::snprintf(buff, 20, "%llu", (long long unsigned)CoAP::time());
+			CoAP::Observe::update(time_list);
+			/**
+			 * All observe notification must be associated with a observe
+			 * option with a sync number.
+			 *
+			 * We are going to generate this number based on the system clock
+			 */
+			unsigned num = CoAP::Observe::generate_option_value_from_clock();
+			CoAP::Message::Option::node obs_op{CoAP::Message::Option::code::observe, num};
+			CoAP::Message::Option::List options;
+			options.add(obs_op);
 
-					req.payload(buff);
+			/**
+			 * Seting a payload
+			 */
+			char buff[20];
+			std::snprintf(buff, 20, "%llu", (long long unsigned)CoAP::time());
 
-					/**
-					 * Sending
-					 */
-					CoAP::Error ec;
-					engine.send(req, ec);
-				}
-			}
+			/**
+			 * Serializing once and sending to all observers due
+			 */
+			CoAP::Error ec;
+			time_notifier.notify_scheduled(engine, time_list,
+					CoAP::Message::code::content,
+					options, buff, std::strlen(buff), ec);
 		}
 		std::this_thread::sleep_for(std::chrono::seconds(1));
 	}
@@ -296,24 +317,45 @@ static void thread_time(engine& engine)
 /**
  * As the messages are sent confirmable, a ack message is expected back.
  *
- * If we do not receive a ack (transaction timeout) we are going to remove
- * the observer from the observe list.
+ * If we do not receive a ack (timeout) or receive a reset, we are going to
+ * remove the observer from the observe list.
  *
- * This callback will be call at timeout/success transaction
+ * This callback will be call at ack/reset/timeout of each notification
  */
-static void type_callback(const void* transaction,
-		engine::message const*,
+static void type_callback(endpoint const& ep,
+		void const* token, std::size_t token_len,
+		CoAP::Observe::notify_status nstatus,
 		void*) noexcept
 {
-	auto const* t = static_cast<engine::transaction_t const*>(transaction);
-	if(t->status() == CoAP::Transmission::status_t::timeout)	//Checking if it was timeout
-	{
-		/**
-		 * Message timeout, removing from list
-		 */
-		status(example_mod, "Type Observable timeout... removing from list");
-		type_list.remove(t->endpoint(), t->request());
-	}
+	if(nstatus == CoAP::Observe::notify_status::acknowledged) return;
+
+	/**
+	 * Notification timeout/reset, removing from list
+	 */
+	status(example_mod, "Type Observable %s... removing from list",
+			nstatus == CoAP::Observe::notify_status::timeout ? "timeout" : "reset");
+	CoAP::Message::message msg;
+	msg.token = token;
+	msg.token_len = token_len;
+	type_list.remove(ep, msg);
+}
+
+/**
+ * Same as above, to the time confirmable notifications
+ */
+static void time_callback(endpoint const& ep,
+		void const* token, std::size_t token_len,
+		CoAP::Observe::notify_status nstatus,
+		void*) noexcept
+{
+	if(nstatus == CoAP::Observe::notify_status::acknowledged) return;
+
+	status(example_mod, "Time Observable %s... removing from list",
+			nstatus == CoAP::Observe::notify_status::timeout ? "timeout" : "reset");
+	CoAP::Message::message msg;
+	msg.token = token;
+	msg.token_len = token_len;
+	time_list.remove(ep, msg);
 }
 
 /**
@@ -334,52 +376,35 @@ static void thread_type(engine& engine)
 		 */
 		if(i != typed)
 		{
-
 			typed = i;
-			for(unsigned j = 0; j < type_list.size(); j++)
-			{
-				if(type_list[j]->is_used())
-				{
-					debug(example_mod, "sending type");
-
-					/**
-					 * Making a confirmable request
-					 */
-					engine::request req{*type_list[j],
-						CoAP::Message::type::confirmable,
-						CoAP::Message::code::content};
-
-					/**
-					 * Setting callback that will remove observer if
-					 * transaction timeout
-					 */
-					req.callback(type_callback);
-
-					/**
-					 * All observe notification must be associated with a observe
-					 * option with a sync number.
-					 *
-					 * We are going to generate this number based on the system clock
-					 */
-					unsigned num = CoAP::Observe::generate_option_value_from_clock();
-					CoAP::Message::Option::node obs_op{CoAP::Message::Option::code::observe, num};
-					req.add_option(obs_op);
+			debug(example_mod, "sending type");
 
-					/**
-					 * Setting payload
-					 */
-					char buff[2];
-					std::snprintf(buff, 2, "%c", typed);
+			/**
+			 * All observe notification must be associated with a observe
+			 * option with a sync number.
+			 *
+			 * We are going to generate this number based on the system clock
+			 */
+			unsigned num = CoAP::Observe::generate_option_value_from_clock();
+			CoAP::Message::Option::node obs_op{CoAP::Message::Option::code::observe, num};
+			CoAP::Message::Option::List options;
+			options.add(obs_op);
 
-					req.payload(buff);
+			/**
+			 * Setting payload
+			 */
+			char buff[2];
+			std::snprintf(buff, 2, "%c", typed);
 
-					/**
-					 * Sending
-					 */
-					CoAP::Error ec;
-					engine.send(req, ec);
-				}
-			}
+			/**
+			 * Sending confirmable notifications to all observers
+			 */
+			CoAP::Error ec;
+			std::lock_guard<std::mutex> lock(notifier_mtx);
+			type_notifier.notify(engine, type_list,
+					CoAP::Message::type::confirmable,
+					CoAP::Message::code::content,
+					options, buff, 1, ec);
 		}
 		std::this_thread::sleep_for(std::chrono::seconds(1));
 		//Clearing buffer
@@ -491,6 +516,18 @@ int main()
 	engine coap_engine(std::move(socket),
 			CoAP::Message::message_id((unsigned)CoAP::time()));
 
+	/**
+	 * Notifications ACK/RST are not responses of engine transactions,
+	 * so they are received at the default callback
+	 */
+	coap_engine.default_cb([](endpoint const& ep, engine::message const* msg, void*) noexcept {
+		std::lock_guard<std::mutex> lock(notifier_mtx);
+		if(!type_notifier.response(ep, *msg))
+			time_notifier.response(ep, *msg);
+	});
+	type_notifier.callback(type_callback);
+	time_notifier.callback(time_callback);
+
 	/**
 	 * Resource instantiation
 	 */
@@ -532,8 +569,11 @@ int main()
 	while(coap_engine(ec))
 	{
 		/**
-		 * Your code
+		 * Retransmitting confirmable notifications
 		 */
+		std::lock_guard<std::mutex> lock(notifier_mtx);
+		type_notifier.check(coap_engine);
+		time_notifier.check(coap_engine);
 	}
 
 	ttime.join();
@@ -563,7 +603,7 @@ static void get_time_handler(engine::message const& request,
 	 * register/deregister as necessary. If it returns true you
 	 * must add the observe option
 	 */
-	if(time_list.process(response.endpoint(), request))
+	if(time_list.process(response.endpoint(), request, time_attr, 4))
 	{
 		status(example_mod, "Time resource obseravable register");
 		response.add_option(obs_op);
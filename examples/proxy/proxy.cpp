@@ -0,0 +1,146 @@
+/**
+ * This example shows how to use the CoAP-te proxy.
+ *
+ * The proxy listen for requests at port 5684 (downstream), and forwards
+ * the requests to the servers using a second socket (upstream):
+ *
+ * * Requests without Proxy-Uri option are forwarded to the server at
+ * 127.0.0.1:5683 (reverse proxy). Try it with the 'engine_server' example;
+ * * Requests with the Proxy-Uri option are forwarded to the host/port of the
+ * URI (forward proxy). Just IPv4 literals are resolved at this example.
+ *
+ * Responses to GET requests are cached while fresh (Max-Age).
+ */
+
+#include "coap-te/log.hpp"		//Log header
+#include "coap-te.hpp"			//Convenient header
+
+using namespace CoAP::Log;
+
+#define PROXY_PORT		5684					//Port to receive requests
+#define SERVER_PORT		CoAP::default_port		//5683
+#define SERVER_ADDR		"127.0.0.1"				//Reverse proxy server address
+
+/**
+ * Log module
+ */
+static constexpr module example_mod = {
+		/*.name = */"EXAMPLE",
+		/*.max_level = */CoAP::Log::type::debug
+};
+
+using endpoint = CoAP::Port::POSIX::endpoint_ipv4;
+
+/**
+ * Exchange list holds the map between client and server token/message ID.
+ * The template parameters are:
+ * (1) exchange type (endpoint, size of the response saved to answer
+ *     duplicated requests and, optionally, size to hold the request cache-key
+ *     options);
+ * (2) number of simultaneous exchanges.
+ */
+using exchange_list_t = CoAP::Proxy::exchange_list<
+		CoAP::Proxy::exchange<endpoint, 256>,	/* (1) exchange type (endpoint, saved response size) */
+		16>;									/* (2) number of exchanges */
+
+/**
+ * Response cache. The template parameters are:
+ * (1) number of responses to hold;
+ * (2) max response size;
+ * (3) optionally, max size of the request cache-key options (requests
+ *     with bigger cache-key are not cached).
+ *
+ * To disable cache, use CoAP::disable
+ */
+using cache_t = CoAP::Cache::list<
+		8,			/* (1) number of cached responses */
+		512>;		/* (2) max response size */
+
+/**
+ * Proxy
+ * (1) Connection type (downstream and upstream);
+ * (2) Message ID generator type;
+ * (3) Exchange list;
+ * (4) Cache type (or CoAP::disable);
+ * (5) Max packet size.
+ */
+using proxy = CoAP::Proxy::proxy<
+		CoAP::Port::POSIX::udp<endpoint>,	/* (1) socket type */
+		CoAP::Message::message_id,			/* (2) message id generator type */
+		exchange_list_t,					/* (3) exchange list */
+		cache_t,							/* (4) cache */
+		1152>;								/* (5) max packet size */
+
+/**
+ * Auxiliary function
+ */
+void exit_error(CoAP::Error& ec, const char* what = nullptr)
+{
+	error(example_mod, ec, what);
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * Forward callback: resolve the Proxy-Uri host to a endpoint
+ */
+bool forward_cb(CoAP::URI::uri<CoAP::URI::ip_type> const& uri,
+		endpoint& ep, void*) noexcept
+{
+	if(uri.uri_scheme != CoAP::URI::scheme::coap
+		|| uri.host.type != CoAP::URI::host_type::ipv4)
+		return false;
+
+	ep.set(uri.host.host.ip4.s_addr, uri.port);
+	return true;
+}
+
+int main()
+{
+	debug(example_mod, "Init proxy code...");
+
+	/**
+	* Window/Linux: Initialize random number generator
+	* Windows: initialize winsock library
+	*/
+	CoAP::init();
+
+	CoAP::Error ec;
+
+	/**
+	 * Downstream socket: bind to proxy port
+	 */
+	proxy::connection down;
+	endpoint ep_proxy{PROXY_PORT};
+	down.open(ec);
+	if(ec) exit_error(ec, "Error trying to open downstream socket...");
+	down.bind(ep_proxy, ec);
+	if(ec) exit_error(ec, "Error trying to bind downstream socket...");
+
+	/**
+	 * Upstream socket: any port
+	 */
+	proxy::connection up;
+	up.open(ec);
+	if(ec) exit_error(ec, "Error trying to open upstream socket...");
+
+	proxy coap_proxy(std::move(down), std::move(up),
+			CoAP::Message::message_id((unsigned)CoAP::time()));
+
+	endpoint ep_server{SERVER_ADDR, SERVER_PORT, ec};
+	if(ec) exit_error(ec, "Error parsing server address...");
+
+	coap_proxy.upstream(ep_server);
+	coap_proxy.forward(forward_cb);
+
+	status(example_mod, "Proxy listening at port %u", PROXY_PORT);
+	while(coap_proxy.run<50>(ec))
+	{
+		/**
+		 * Do other stuff
+		 */
+	}
+
+	if(ec) exit_error(ec);
+
+	return EXIT_SUCCESS;
+}
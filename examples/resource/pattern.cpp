@@ -0,0 +1,192 @@
+/**
+ * This example shows a server with parameter and wildcard resources.
+ *
+ * 	l0:			   root
+ * 			________|________
+ * 			|				|
+ * 	l1:	   dev			  files
+ * 			|				|
+ * 	l2:	   {id}			   **
+ * 		____|____
+ * 		|		|
+ * 	l3:	temp	reset
+ *
+ * * \/dev/{id}/temp [GET]: '{id}' matches any segment (/dev/1234/temp, /dev/abc/temp...);
+ * * \/dev/{id}/reset [POST];
+ * * \/files/... [GET]: the '**' resource matches all the remaining segments (/files/a/b/c...).
+ *
+ * A literal resource has precedence over a parameter, that has precedence
+ * over a wildcard (so /dev/all/temp could be a different resource).
+ *
+ * The matched segments are available at the handler (by the engine resource
+ * root). They point to the request, nothing is copied.
+ */
+
+#include <cstdio>
+
+#include "coap-te/log.hpp"		//Log header
+#include "coap-te.hpp"			//Convenient header
+#include "coap-te-debug.hpp"	//Convenient debug header
+
+using namespace CoAP::Log;
+
+#define COAP_PORT		CoAP::default_port		//5683
+#define HOST_ADDR		"127.0.0.1"				//Address
+#define BUFFER_LEN		64
+
+/**
+ * Log module
+ */
+static constexpr module example_mod = {
+		/*.name = */"EXAMPLE",
+		/*.max_level = */CoAP::Log::type::debug
+};
+
+using endpoint = CoAP::Port::POSIX::endpoint_ipv4;
+
+/**
+ * Engine definition (check 'raw_engine' example for a full description)
+ */
+using engine = CoAP::Transmission::engine<
+		CoAP::Port::POSIX::udp<endpoint>,
+		CoAP::Message::message_id,
+		CoAP::Transmission::transaction_list<
+			CoAP::Transmission::transaction<
+				512,
+				CoAP::Transmission::transaction_cb,
+				endpoint>,
+			4>,
+		CoAP::disable,
+		CoAP::Resource::resource<
+			CoAP::Resource::callback<endpoint>,
+			true>
+	>;
+
+static void get_temp_handler(engine::message const&,
+								engine::response& response, void*) noexcept;
+static void post_reset_handler(engine::message const&,
+								engine::response& response, void*) noexcept;
+static void get_files_handler(engine::message const&,
+								engine::response& response, void*) noexcept;
+
+/**
+ * Auxiliary function
+ */
+static void exit_error(CoAP::Error& ec, const char* what = nullptr)
+{
+	error(example_mod, ec, what);
+	exit(EXIT_FAILURE);
+}
+
+int main()
+{
+	debug(example_mod, "Pattern resources server init example...");
+
+	CoAP::init();
+
+	CoAP::Error ec;
+
+	engine::endpoint ep{HOST_ADDR, COAP_PORT, ec};
+	if(ec) exit_error(ec, "endpoint");
+
+	engine::connection socket;
+	socket.open(ec);
+	if(ec) exit_error(ec, "Error trying to open socket...");
+	socket.bind(ep, ec);
+	if(ec) exit_error(ec, "Error trying to bind socket...");
+
+	engine coap_engine(std::move(socket),
+			CoAP::Message::message_id((unsigned)CoAP::time()));
+
+	/**
+	 * The segment type is defined by the resource path
+	 */
+	engine::resource_node	res_dev{"dev"},
+							res_id{"{id}", "title='device'"},
+							res_temp{"temp", "rt=temperature", get_temp_handler},
+							res_reset{"reset", "title='reset device'", nullptr, post_reset_handler},
+							res_files{"files"},
+							res_all_files{"**", "title='files'", get_files_handler};
+
+	coap_engine.root_node().add_branch(res_dev, res_id, res_temp);
+	res_id.add_child(res_reset);
+	coap_engine.root_node().add_branch(res_files, res_all_files);
+
+	debug(example_mod, "Initiating CoAP engine loop...");
+	while(coap_engine.run<50>(ec));
+	if(ec) exit_error(ec);
+
+	return EXIT_SUCCESS;
+}
+
+/**
+ * The void* argument is the engine
+ */
+static engine::resource_root::captures_t const& captures(void* eng) noexcept
+{
+	return static_cast<engine*>(eng)->root_node().captures();
+}
+
+static void get_temp_handler(engine::message const&,
+								engine::response& response, void* eng) noexcept
+{
+	auto const* id = captures(eng).get("id");
+
+	char buf[BUFFER_LEN];
+	int size = std::snprintf(buf, BUFFER_LEN, "dev %.*s: %u",
+						static_cast<int>(id->length), id->value,
+						CoAP::random_generator() % 40);
+
+	debug(example_mod, "Called get temp handler [%.*s]",
+			static_cast<int>(id->length), id->value);
+
+	CoAP::Message::content_format format = CoAP::Message::content_format::text_plain;
+	CoAP::Message::Option::node content{format};
+
+	response
+			.code(CoAP::Message::code::content)
+			.add_option(content)
+			.payload(buf, size)
+			.serialize();
+}
+
+static void post_reset_handler(engine::message const&,
+								engine::response& response, void* eng) noexcept
+{
+	auto const* id = captures(eng).get("{id}");
+
+	status(example_mod, "Reseting device %.*s",
+			static_cast<int>(id->length), id->value);
+
+	response
+			.code(CoAP::Message::code::changed)
+			.serialize();
+}
+
+static void get_files_handler(engine::message const&,
+								engine::response& response, void* eng) noexcept
+{
+	debug(example_mod, "Called get files handler");
+
+	/**
+	 * Each segment matched by the wildcard is a capture
+	 */
+	auto const& caps = captures(eng);
+	char buf[BUFFER_LEN];
+	int size = 0;
+	for(unsigned i = 0; i < caps.size() && size < BUFFER_LEN; i++)
+	{
+		size += std::snprintf(buf + size, BUFFER_LEN - size, "/%.*s",
+						static_cast<int>(caps[i]->length), caps[i]->value);
+	}
+	if(size > BUFFER_LEN - 1) size = BUFFER_LEN - 1;
+
+	CoAP::Message::content_format format = CoAP::Message::content_format::text_plain;
+	CoAP::Message::Option::node content{format};
+
+	response
+			.code(CoAP::Message::code::content)
+			.add_option(content)
+			.payload(buf, size)
+			.serialize();
+}
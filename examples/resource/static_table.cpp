@@ -0,0 +1,185 @@
+/**
+ * This example shows a server that defines all its resources at compile
+ * time, using a static resource table.
+ *
+ * The static table is built (and its perfect hash computed) at compile time,
+ * and the /.well-known/core body is also precomputed. The request path is
+ * hashed only once, and compared only with one resource. Nothing is allocated
+ * or linked at runtime.
+ *
+ * Resources:
+ * * \/time [GET]: current time;
+ * * \/sensors/temp, \/sensors/light, \/sensors/humidity [GET]: random values;
+ * * \/.well-known/core [GET]: resource description (RFC6690);
+ *
+ * Resources added to the resource tree (root_node().add_branch...) are still
+ * searched if the path is not found at the static table.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "coap-te/log.hpp"		//Log header
+#include "coap-te.hpp"			//Convenient header
+#include "coap-te-debug.hpp"	//Convenient debug header
+
+using namespace CoAP::Log;
+
+#define COAP_PORT		CoAP::default_port		//5683
+#define HOST_ADDR		"127.0.0.1"				//Address
+
+/**
+ * Log module
+ */
+static constexpr module example_mod = {
+		/*.name = */"EXAMPLE",
+		/*.max_level = */CoAP::Log::type::debug
+};
+
+using endpoint = CoAP::Port::POSIX::endpoint_ipv4;
+
+/**
+ * Engine definition (check 'raw_engine' example for a full description)
+ */
+using engine = CoAP::Transmission::engine<
+		CoAP::Port::POSIX::udp<endpoint>,
+		CoAP::Message::message_id,
+		CoAP::Transmission::transaction_list<
+			CoAP::Transmission::transaction<
+				512,
+				CoAP::Transmission::transaction_cb,
+				endpoint>,
+			4>,
+		CoAP::disable,
+		CoAP::Resource::resource<
+			CoAP::Resource::callback<endpoint>,
+			true>
+	>;
+
+/**
+ * Handlers (defined below)
+ */
+static void get_time_handler(engine::message const&,
+								engine::response& response, void*) noexcept;
+static void get_sensor_handler(engine::message const&,
+								engine::response& response, void*) noexcept;
+static void get_discovery_handler(engine::message const&,
+								engine::response& response, void*) noexcept;
+
+/**
+ * Resource list. The path is the full path of the resource (without the
+ * leading slash).
+ */
+static constexpr const engine::resource resources[] = {
+	{"time", "title='time of device'", get_time_handler},
+	{"sensors/temp", "title='temperature';rt=sensor", get_sensor_handler},
+	{"sensors/light", "title='light';rt=sensor", get_sensor_handler},
+	{"sensors/humidity", "title='humidity';rt=sensor", get_sensor_handler},
+	{".well-known/core", get_discovery_handler}
+};
+
+/**
+ * The table (and its hash) is computed at compile time
+ */
+static constexpr const CoAP::Resource::static_table table{resources};
+static_assert(table.perfect(), "Perfect hash not found");
+
+/**
+ * /.well-known/core body, computed at compile time
+ */
+static constexpr const auto core = table.link_format<table.link_format_size()>();
+
+/**
+ * Auxiliary function
+ */
+static void exit_error(CoAP::Error& ec, const char* what = nullptr)
+{
+	error(example_mod, ec, what);
+	exit(EXIT_FAILURE);
+}
+
+int main()
+{
+	debug(example_mod, "Static table server init example...");
+
+	CoAP::init();
+
+	CoAP::Error ec;
+
+	engine::endpoint ep{HOST_ADDR, COAP_PORT, ec};
+	if(ec) exit_error(ec, "endpoint");
+
+	engine::connection socket;
+	socket.open(ec);
+	if(ec) exit_error(ec, "Error trying to open socket...");
+	socket.bind(ep, ec);
+	if(ec) exit_error(ec, "Error trying to bind socket...");
+
+	engine coap_engine(std::move(socket),
+			CoAP::Message::message_id((unsigned)CoAP::time()));
+
+	/**
+	 * Setting the static table to the engine
+	 */
+	coap_engine.root_node().table(&table);
+
+	status(example_mod, "Static table: %u resources", table.size());
+	status(example_mod, "Well-known core: %s", core.data);
+
+	debug(example_mod, "Initiating CoAP engine loop...");
+	while(coap_engine.run<50>(ec));
+	if(ec) exit_error(ec);
+
+	return EXIT_SUCCESS;
+}
+
+static void get_time_handler(engine::message const&,
+								engine::response& response, void*) noexcept
+{
+	debug(example_mod, "Called get time handler");
+
+	CoAP::Message::content_format format = CoAP::Message::content_format::text_plain;
+	CoAP::Message::Option::node content{format};
+
+	char time[15];
+	std::snprintf(time, 15, "%llu", (long long unsigned)CoAP::time());
+
+	response
+			.code(CoAP::Message::code::content)
+			.add_option(content)
+			.payload(time)
+			.serialize();
+}
+
+static void get_sensor_handler(engine::message const&,
+								engine::response& response, void*) noexcept
+{
+	debug(example_mod, "Called get sensor handler");
+
+	CoAP::Message::content_format format = CoAP::Message::content_format::text_plain;
+	CoAP::Message::Option::node content{format};
+
+	char value[10];
+	std::snprintf(value, 10, "%u", CoAP::random_generator() % 100);
+
+	response
+			.code(CoAP::Message::code::content)
+			.add_option(content)
+			.payload(value)
+			.serialize();
+}
+
+static void get_discovery_handler(engine::message const&,
+								engine::response& response, void*) noexcept
+{
+	debug(example_mod, "Called get discovery handler");
+
+	CoAP::Message::content_format format = CoAP::Message::content_format::application_link_format;
+	CoAP::Message::Option::node content{format};
+
+	response
+			.code(CoAP::Message::code::content)
+			.add_option(content)
+			.payload(core.data, core.size)
+			.serialize();
+}
@@ -207,14 +207,14 @@ int main()
 	 */
 	engine::resource_node	res_time{"time", "title='time of device'", get_time_handler},
 							res_sensors{"sensors"},
-								res_sensor_temp{"temp", get_sensor_handler},
-								res_sensor_light{"light", get_sensor_handler},
-								res_sensor_humidity{"humidity", get_sensor_handler},
+								res_sensor_temp{"temp", "rt=sensor.temp", get_sensor_handler},
+								res_sensor_light{"light", "rt=sensor.light", get_sensor_handler},
+								res_sensor_humidity{"humidity", "rt=sensor.humidity", get_sensor_handler},
 							res_actuators{"actuators"},
-										/* path     get                     post     put */
-								res_gpio0{"gpio0", get_actuator_handler<0>, nullptr, put_actuator_handler<0>},
-								res_gpio1{"gpio1", get_actuator_handler<1>, nullptr, put_actuator_handler<1>},
-								res_gpio2{"gpio2", get_actuator_handler<2>, nullptr, put_actuator_handler<2>},
+										/* path     description		get                     post     put */
+								res_gpio0{"gpio0", "rt=gpio;if=core.a", get_actuator_handler<0>, nullptr, put_actuator_handler<0>},
+								res_gpio1{"gpio1", "rt=gpio;if=core.a", get_actuator_handler<1>, nullptr, put_actuator_handler<1>},
+								res_gpio2{"gpio2", "rt=gpio;if=core.a", get_actuator_handler<2>, nullptr, put_actuator_handler<2>},
 										/* path			get							post			put */
 							res_dynamic{"dynamic", get_dynamic_list_handler, post_dynamic_handler, nullptr},
 							res_separate{"separate", get_separate_handler},
@@ -268,6 +268,16 @@ int main()
 	coap_engine.root_node().add_branch(res_well_known, res_core);
 #endif
 
+	/**
+	 * Indexing the resource tree: each child is found by a hash
+	 * table lookup, instead of searching all the siblings. The
+	 * template parameters are the node type and the number of
+	 * nodes that can be indexed.
+	 */
+	static CoAP::Resource::resource_index<engine::resource_node, 32> res_index;
+	if(!coap_engine.root_node().index(&res_index))
+		status(example_mod, "Resource index full, searching the tree node by node");
+
 	/**
 	 * "Printing" resource tree
 	 */
@@ -622,10 +632,11 @@ static void post_dynamic_handler(engine::message const& request,
 	 * Adding new resource
 	 *
 	 * If it fails when trying to add, means that the child
-	 * already existed
+	 * already existed. Adding by the root keeps the resource
+	 * index updated.
 	 */
 	int index = v - '0' - 1;
-	if(!node->add_child(dynamics[index]))
+	if(!eng->root_node().attach(*node, dynamics[index]))
 	{
 		/* child already added */
 		response
@@ -845,18 +856,38 @@ static void get_separate_handler(engine::message const& request,
  *
  * Respond to request with resource information as defined at RFC6690
  */
-static void get_discovery_handler(engine::message const&,
+static void get_discovery_handler(engine::message const& request,
 								engine::response& response, void* eng_ptr) noexcept
 {
-	char buffer[512];
+	/**
+	 * The link format is only generated again if the resource tree
+	 * has changed (e.g., dynamic resources created/deleted)
+	 */
+	static CoAP::Resource::discovery_cache<512> cache;
+	/**
+	 * Index to filter queries (e.g., ?rt=sensor.*, ?href=/act*),
+	 * also rebuilt only if the tree has changed
+	 */
+	static CoAP::Resource::discovery_index<engine::resource_node, 32> index;
+	static char filtered[512];
+
 	CoAP::Error ec;
 	engine* eng = static_cast<engine*>(eng_ptr);
 
 	/**
 	 * Constructing link format resource information
 	 */
-	std::size_t size = CoAP::Resource::discovery(eng->root_node().node(),
-			buffer, 512, ec);
+	std::size_t size;
+	char const* buffer;
+	CoAP::Message::Option::option query;
+	if(CoAP::Message::Option::get_option(request, query, CoAP::Message::Option::code::uri_query))
+	{
+		if(!index.update(eng->root_node())) ec = CoAP::errc::insufficient_buffer;
+		else size = index.discovery(request, filtered, 512, ec);
+		buffer = filtered;
+	}
+	else
+		buffer = cache.get(eng->root_node(), size, ec);
 
 	/**
 	 * Checking error
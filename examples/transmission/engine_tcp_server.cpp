@@ -34,6 +34,10 @@
  * ------
  * * separate: GET method only. Sends a separate response within a random time.
  * ------
+ * * big: GET method only. Responds a big representation using block-wise transfer. If
+ * both peers indicated Block-Wise-Transfer at the CSM message, BERT blocks (multiple of
+ * 1024 bytes per message) are used (RFC8323 section 6).
+ * ------
  * * .well-known/core: provide resource information as defined at RFC6690
  * ------
  * For brevity, all resources return data as strings (content_format::text_plain).
@@ -100,11 +104,11 @@ using connection = CoAP::Port::POSIX::tcp_server<endpoint_t>;			///< TCP server
 /**
  * Reliable connection MUST exchange CSM signaling message when connect.
  * This is our client configuration:
- * * Max message size = 1152 (default)
+ * * Max message size = 8192 (to send BERT blocks of up to 7 KB, if the peer allows)
  * * Accept block wise transfer
  */
 static constexpr const CoAP::Transmission::Reliable::csm_configure csm = {
-		/*.max_message_size = */CoAP::Transmission::Reliable::default_max_message_size,
+		/*.max_message_size = */8192,
 		/*.block_wise_transfer = */true
 };
 
@@ -115,15 +119,56 @@ static constexpr const CoAP::Transmission::Reliable::csm_configure csm = {
  * signaling information. If you don't need this information, i.e.,
  * just respond incoming request and ignore any CSM information you
  * can disable the use of connection list using CoAP::disable.
+ *
+ * The connection can also hold a receive buffer (second template parameter,
+ * size at least the max message size). The socket is read in large chunks,
+ * several messages are processed by read, and a message that arrives split
+ * in many TCP segments is kept until completed. Without it, each message
+ * is read from the socket field by field.
+ *
+ * And a send queue (third template parameter). If the peer is reading
+ * slowly, the data that the socket doesn't accept is queued and sent when
+ * the socket is writable again. The send queue template parameters are the
+ * size and the high/low watermarks. Use 'engine::writable(socket)' to check
+ * if a connection is above the high watermark (and stop sending to it), or
+ * install a watermark callback to be called when it crosses the watermarks.
+ * Notifications (requests made from observers) are not sent to a connection
+ * above the high watermark.
  */
+using connection_t = CoAP::Transmission::Reliable::Connection<
+							connection::handler,	/* (1) socket type */
+							csm.max_message_size,	/* (2) receive buffer size */
+							CoAP::Transmission::Reliable::send_queue<
+								4 * csm.max_message_size>	/* (3) send queue */
+							>;
+
 /**
  * (Un)comment the define statements above to change the connection list
  * implementation.
  */
 #define USE_CONNECTION_LIST_DEFAULT
 //#define USE_CONNECTION_LIST_VECTOR
+//#define USE_CONNECTION_LIST_TABLE
 
-#ifdef USE_CONNECTION_LIST_VECTOR
+#ifdef USE_CONNECTION_LIST_TABLE
+/**
+ * As connection_list_vector, uses dynamic allocation, so must be explicitly
+ * included
+ */
+#include "transmission/reliable/containers/connection_list_table.hpp"
+
+/**
+ * The connections are indexed by the socket descriptor, so finding
+ * a connection doesn't depend of the number of connections. Suitable
+ * to servers with many clients (POSIX).
+ *
+ * As template parameter, just the (1) connection type.
+ */
+using connection_list_t =
+		CoAP::Transmission::Reliable::connection_list_table<
+			connection_t		/* (1) Connection type */
+		>;
+#elif defined(USE_CONNECTION_LIST_VECTOR)
 /**
  * As connection_list_vector uses std::vector (i.e., dynamic allocation) as
  * internal container. As dynamic allocation is a feature not used in all CoAP-te
@@ -141,7 +186,7 @@ static constexpr const CoAP::Transmission::Reliable::csm_configure csm = {
  */
 using connection_list_t =
 		CoAP::Transmission::Reliable::connection_list_vector<
-			CoAP::Transmission::Reliable::Connection<connection::handler>		/* (1) Connection type */
+			connection_t		/* (1) Connection type */
 		>;
 #elif defined(USE_CONNECTION_LIST_DEFAULT)
 /**
@@ -155,7 +200,7 @@ using connection_list_t =
  */
 using connection_list_t =
 		CoAP::Transmission::Reliable::connection_list<
-			CoAP::Transmission::Reliable::Connection<connection::handler>,	/* (1) transaction type */
+			connection_t,	/* (1) transaction type */
 			4>;				/* (2) number of transaction */
 #else
 /**
@@ -281,6 +326,8 @@ static void get_separate_handler(engine::message const& request,
 								engine::response& response, void*) noexcept;
 static void get_discovery_handler(engine::message const& request,
 								engine::response& response, void*) noexcept;
+static void get_big_handler(engine::message const& request,
+								engine::response& response, void*) noexcept;
 
 /**
  * This default callback response to signal response
@@ -303,6 +350,18 @@ void default_callback(engine::socket,
 	CoAP::Debug::print_message(*response);
 }
 
+/**
+ * Called when the connection send queue reaches the high watermark
+ * (writable == false) and when it drains to the low watermark
+ * (writable == true). Notifications should be paused/resumed here.
+ */
+void watermark_callback(engine::socket socket,
+		bool writable,
+		void*) noexcept
+{
+	status(example_mod, "Socket [%d] %s", socket, writable ? "writable" : "NOT writable");
+}
+
 /**
  * Auxiliary function
  */
@@ -341,6 +400,12 @@ int main()
 	 */
 	coap_engine.default_cb(default_callback);
 
+	/**
+	 * Setting the callback called when a connection send queue crosses
+	 * the watermarks
+	 */
+	coap_engine.watermark_cb(watermark_callback);
+
 	/**
 	 * Setting the root callback
 	 *
@@ -367,6 +432,7 @@ int main()
 										/* path			get							post			put */
 							res_dynamic{"dynamic", get_dynamic_list_handler, post_dynamic_handler, nullptr},
 							res_separate{"separate", get_separate_handler},
+							res_big{"big", get_big_handler},
 							res_well_known{".well-known"},
 								res_core{"core", get_discovery_handler};
 
@@ -394,6 +460,7 @@ int main()
 			res_actuators,
 			res_dynamic,
 			res_separate,
+			res_big,
 			res_well_known);
 
 	/**
@@ -1017,3 +1084,33 @@ static void get_discovery_handler(engine::message const&,
 		.payload(buffer, size)
 		.serialize();
 }
+
+/**
+ * \/big [GET]
+ *
+ * Responds a big representation (bigger than a message). Each request receives a
+ * block of the representation, as asked by the Block2 option. If BERT was negotiated
+ * at the CSM, the blocks are as big as the peer Max-Message-Size allows.
+ */
+#define BIG_REPRESENTATION_SIZE		20000
+
+static void get_big_handler(engine::message const& request,
+								engine::response& response, void*) noexcept
+{
+	debug(example_mod, "Called get big handler");
+
+	static char big[BIG_REPRESENTATION_SIZE];
+	if(!big[0])
+	{
+		for(std::size_t i = 0; i < BIG_REPRESENTATION_SIZE; i++)
+			big[i] = 'a' + (i % 26);
+	}
+
+	CoAP::Message::content_format format = CoAP::Message::content_format::text_plain;
+	CoAP::Message::Option::node content{format};
+
+	response
+		.code(CoAP::Message::code::content)
+		.add_option(content)
+		.serialize_block2(request, big, BIG_REPRESENTATION_SIZE);
+}
@@ -0,0 +1,148 @@
+/**
+ * This example sends a request to the "All CoAP Nodes" multicast group
+ * (224.0.1.187), and collects all the responses received during the
+ * leisure period.
+ *
+ * https://tools.ietf.org/html/rfc7252#section-8.1
+ * https://tools.ietf.org/html/rfc7390#section-2.7
+ *
+ * Multicast requests must be non-confirmable. As there is no transaction,
+ * the responses are received at the default callback, and feed to a
+ * collector, that aggregates the responses with the token of the request
+ * (one by server).
+ *
+ * This example is to be run with the 'multicast_server' example.
+ */
+
+#include <cstdio>
+
+#include "coap-te/log.hpp"		//Log header
+#include "coap-te.hpp"			//Convenient header
+#include "coap-te-debug.hpp"	//Convenient debug header
+
+using namespace CoAP::Log;
+
+#define COAP_PORT			CoAP::default_port		//5683
+#define MULTICAST_ADDR		"224.0.1.187"			//All CoAP Nodes (IPv4)
+
+/**
+ * Time collecting responses (miliseconds). Must be bigger than the leisure
+ * of the servers.
+ */
+#define COLLECT_TIME		6000
+
+/**
+ * Log module
+ */
+static constexpr module example_mod = {
+		/*.name = */"EXAMPLE",
+		/*.max_level = */CoAP::Log::type::debug
+};
+
+using endpoint = CoAP::Port::POSIX::endpoint_ipv4;
+
+/**
+ * Engine definition (check 'raw_engine' example for a full description)
+ */
+using engine = CoAP::Transmission::engine<
+		CoAP::Port::POSIX::udp<endpoint>,
+		CoAP::Message::message_id,
+		CoAP::Transmission::transaction_list<
+			CoAP::Transmission::transaction<
+				512,
+				CoAP::Transmission::transaction_cb,
+				endpoint>,
+			4>,
+		CoAP::Transmission::default_cb<endpoint>,
+		CoAP::disable
+	>;
+
+/**
+ * Collector: (1) endpoint type; (2) max number of responses (servers);
+ * (3) max payload stored of each response.
+ */
+using collector = CoAP::Transmission::collector<endpoint, 32, 32>;
+static collector responses;
+
+/**
+ * Auxiliary function
+ */
+void exit_error(CoAP::Error& ec, const char* what = nullptr)
+{
+	error(example_mod, ec, what);
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * All responses are received here
+ */
+void default_callback(engine::endpoint const& ep,
+		CoAP::Message::message const* response,
+		void*) noexcept
+{
+	if(!responses.process(ep, *response))
+	{
+		debug(example_mod, "Response not collected");
+	}
+}
+
+int main()
+{
+	debug(example_mod, "Multicast client init example...");
+
+	CoAP::init();
+
+	CoAP::Error ec;
+
+	engine::connection conn;
+	conn.open(ec);
+	if(ec) exit_error(ec, "Error trying to open socket...");
+
+	engine coap_engine(std::move(conn),
+			CoAP::Message::message_id((unsigned)CoAP::time()));
+	coap_engine.default_cb(default_callback);
+
+	engine::endpoint group{MULTICAST_ADDR, COAP_PORT, ec};
+	if(ec) exit_error(ec);
+
+	CoAP::Message::Option::node path_op{CoAP::Message::Option::code::uri_path, "time"};
+
+	const char token[] = "mcast";
+
+	/**
+	 * Multicast request: non-confirmable
+	 */
+	engine::request request(group);
+	request.header(CoAP::Message::type::nonconfirmable, CoAP::Message::code::get)
+			.token(token)
+			.add_option(path_op);
+
+	responses.start(token, std::strlen(token), COLLECT_TIME);
+
+	/**
+	 * Non-confirmable request sent without using a transaction (internal buffer)
+	 */
+	coap_engine.send<true>(request, ec);
+	if(ec) exit_error(ec, "send");
+
+	status(example_mod, "Request sent to %s... collecting responses", MULTICAST_ADDR);
+
+	while(!responses.done() && coap_engine.run<50>(ec));
+	if(ec) exit_error(ec, "run");
+
+	status(example_mod, "Responses received: %u (discarded: %u)",
+			responses.size(), responses.discarded());
+	for(unsigned i = 0; i < responses.size(); i++)
+	{
+		collector::response_t const* res = responses[i];
+		char addr[20];
+		endpoint ep = res->ep;
+		std::printf("%s:%u [%s] %.*s%s\n",
+				ep.address(addr), ep.port(),
+				CoAP::Debug::code_string(res->mcode),
+				static_cast<int>(res->size()), res->payload,
+				res->truncated() ? "..." : "");
+	}
+
+	return EXIT_SUCCESS;
+}
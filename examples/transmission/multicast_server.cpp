@@ -0,0 +1,153 @@
+/**
+ * This example shows a server that joins the "All CoAP Nodes" multicast
+ * group (224.0.1.187), and answers the requests received by multicast.
+ *
+ * https://tools.ietf.org/html/rfc7252#section-8
+ * https://tools.ietf.org/html/rfc7390
+ *
+ * Requests received by multicast:
+ * * are never acknowledged (the response is non-confirmable);
+ * * errors responses (resource not found, method not allowed...) are suppressed;
+ * * the responses are sent at a random time inside the leisure period
+ * (configure::default_leisure_seconds), so the responses of all the servers
+ * of the group don't arrive at the same time to the client.
+ *
+ * Requests received by unicast are answered as usual.
+ *
+ * This example is to be run with the 'multicast_client' example (run as many
+ * servers as you want, at different machines).
+ */
+
+#include <cstdio>
+
+#include "coap-te/log.hpp"		//Log header
+#include "coap-te.hpp"			//Convenient header
+#include "coap-te-debug.hpp"	//Convenient debug header
+
+using namespace CoAP::Log;
+
+#define COAP_PORT			CoAP::default_port		//5683
+#define MULTICAST_ADDR		"224.0.1.187"			//All CoAP Nodes (IPv4)
+
+/**
+ * Log module
+ */
+static constexpr module example_mod = {
+		/*.name = */"EXAMPLE",
+		/*.max_level = */CoAP::Log::type::debug
+};
+
+/**
+ * Transmission configuration settings
+ * https://tools.ietf.org/html/rfc7252#section-4.8
+ */
+static constexpr const CoAP::Transmission::configure tconfigure = {
+	/*.ack_timeout_seconds 			= */2.0,	//ACK_TIMEOUT
+	/*.ack_random_factor 			= */1.5,	//ACK_RANDOM_FACTOR
+	/*.max_restransmission 			= */4,		//MAX_RETRANSMIT
+	/*.default_leisure_seconds 		= */5		//DEFAULT_LEISURE
+};
+
+using endpoint = CoAP::Port::POSIX::endpoint_ipv4;
+
+/**
+ * Engine definition (check 'raw_engine' example for a full description)
+ *
+ * The last parameter is the leisure list: the responses to multicast
+ * requests are hold here until its time to be sent. Template parameters:
+ * (1) endpoint type; (2) number of responses to hold; (3) max packet size.
+ *
+ * If the list is full, the response is sent at once. If you don't want a
+ * leisure list (CoAP::disable), the responses are always sent at once.
+ */
+using engine = CoAP::Transmission::engine<
+		CoAP::Port::POSIX::udp<endpoint>,
+		CoAP::Message::message_id,
+		CoAP::Transmission::transaction_list<
+			CoAP::Transmission::transaction<
+				512,
+				CoAP::Transmission::transaction_cb,
+				endpoint>,
+			4>,
+		CoAP::disable,
+		CoAP::Resource::resource<
+			CoAP::Resource::callback<endpoint>,
+			true>,
+		CoAP::Transmission::leisure_list<endpoint, 8, 512>
+	>;
+
+/**
+ * Auxiliary function
+ */
+void exit_error(CoAP::Error& ec, const char* what = nullptr)
+{
+	error(example_mod, ec, what);
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * \/time [GET]
+ */
+static void get_time_handler(engine::message const&,
+								engine::response& response, void*) noexcept
+{
+	debug(example_mod, "Called get time handler");
+
+	CoAP::Message::content_format format = CoAP::Message::content_format::text_plain;
+	CoAP::Message::Option::node content{format};
+
+	char time[15];
+	std::snprintf(time, 15, "%llu", (long long unsigned)CoAP::time());
+
+	response
+			.code(CoAP::Message::code::content)
+			.add_option(content)
+			.payload(time)
+			.serialize();
+}
+
+int main()
+{
+	debug(example_mod, "Multicast server init example...");
+
+	CoAP::init();
+
+	CoAP::Error ec;
+
+	/**
+	 * Binding to any address (to receive unicast and multicast requests)
+	 */
+	engine::endpoint ep{COAP_PORT};
+	engine::connection socket;
+
+	socket.open(ec);
+	if(ec) exit_error(ec, "Error trying to open socket...");
+	socket.bind(ep, ec);
+	if(ec) exit_error(ec, "Error trying to bind socket...");
+
+	/**
+	 * Joining the multicast group
+	 */
+	engine::endpoint group{MULTICAST_ADDR, COAP_PORT, ec};
+	if(ec) exit_error(ec, "multicast address");
+	socket.join(group, ec);
+	if(ec) exit_error(ec, "Error trying to join multicast group...");
+
+	status(example_mod, "Joined multicast group %s", MULTICAST_ADDR);
+
+	engine coap_engine(std::move(socket),
+			CoAP::Message::message_id((unsigned)CoAP::time()),
+			tconfigure);
+
+	engine::resource_node res_time{"time", "title='time of device'", get_time_handler};
+	coap_engine.root_node().add_branch(res_time);
+
+	debug(example_mod, "Initiating CoAP engine loop...");
+	/**
+	 * The engine loop also sends the responses of the leisure list
+	 */
+	while(coap_engine.run<50>(ec));
+	if(ec) exit_error(ec);
+
+	return EXIT_SUCCESS;
+}
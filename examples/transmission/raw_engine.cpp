@@ -362,5 +362,24 @@ int main()
 	}
 	if(ec) exit_error(ec, "run");
 
+	/**
+	 * Requests that are sent many times can be pre-serialized once (request
+	 * template). Sending is just a copy to the transaction buffer, patching
+	 * the message id. Token, option values (marked) and payload can be
+	 * changed in place.
+	 */
+	debug(example_mod, "Sending the same request from a template...");
+	CoAP::Message::request_template<64> req_template;
+	req_template.build(request.factory(), ec);
+	if(ec) exit_error(ec, "template");
+
+	response_flag = false;
+	req_template.token("tok02", 5);
+	coap_engine.send(request.endpoint(), req_template, request_cb, nullptr, ec);
+	if(ec) exit_error(ec, "send template");
+
+	while(!response_flag && coap_engine(ec));
+	if(ec) exit_error(ec, "run");
+
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,247 @@
+/**
+ * This example will show how to use Q-Block options (RFC9177) to
+ * transfer big chunks of data without waiting a round trip to
+ * each block.
+ *
+ * First, it makes a GET request to the '\/qdata' resource: the server
+ * sends the blocks at bursts (Q-Block2). The missing blocks are
+ * requested after a timeout.
+ *
+ * Then, it makes a PUT request to the same resource, sending the
+ * blocks at bursts (Q-Block1).
+ *
+ * Use this example together with "response_block_wise".
+ */
+
+#include <cstring>
+
+#include "coap-te/log.hpp"				//Log header
+#include "coap-te.hpp"			//Convenient header
+#include "coap-te-debug.hpp"	//Convenient debug header
+
+using namespace CoAP::Log;
+
+#define COAP_PORT		CoAP::default_port		//5683
+#define HOST_ADDR		"127.0.0.1"				//Address
+
+#define BUFFER_LEN			4048		//Local buffer size
+#define TRANSC_BUFFER_LEN	512			//Transaction buffer length
+#define TRANSFER_BLOCK_SIZE	64			//Block size
+#define MAX_MISSING			8			//Maximum missing blocks requested at once
+
+#define RESOURCE_DATA_PATH	"qdata"		//resource which will make a request
+
+/**
+ * Log module
+ */
+static constexpr module example_mod = {
+		/*.name = */"EXAMPLE",
+		/*.max_level = */CoAP::Log::type::debug
+};
+
+/**
+ * Engine definition. Check 'raw_engine' example for a full
+ * description os the options.
+ *
+ * The default callback receives the blocks that are not response
+ * of a transaction (the bursts).
+ */
+using engine = CoAP::Transmission::engine<
+		CoAP::Port::POSIX::udp<CoAP::Port::POSIX::endpoint_ipv4>,
+		CoAP::Message::message_id,
+		CoAP::Transmission::transaction_list<
+			CoAP::Transmission::transaction<
+					TRANSC_BUFFER_LEN,
+					CoAP::Transmission::transaction_cb,
+					CoAP::Port::POSIX::endpoint_ipv4>,
+				4>,
+		CoAP::Transmission::default_cb<
+			CoAP::Port::POSIX::endpoint_ipv4>,
+			CoAP::disable
+	>;
+
+/**
+ * Q-Block2 receiver (GET) and Q-Block1 sender (PUT)
+ */
+static CoAP::Transmission::q_block2_receiver<> receiver;
+static CoAP::Transmission::q_block_sender_list<engine::endpoint, 1> sender;
+
+/**
+ * Data received by the GET request, and sent back by the PUT request
+ */
+static char receive_data[BUFFER_LEN];
+static std::size_t receive_size = 0;
+static bool get_done = false;
+
+/**
+ * Auxiliary function
+ */
+void exit_error(CoAP::Error& ec, const char* what = nullptr)
+{
+	error(example_mod, ec, what);
+	exit(EXIT_FAILURE);
+}
+
+/**
+ * Sink of the data received (blocks may arrive out of order)
+ */
+static bool get_sink(CoAP::Transmission::block1_event event,
+						void const* data,
+						std::size_t offset,
+						std::size_t size,
+						void*) noexcept
+{
+	using namespace CoAP::Transmission;
+
+	if(event == block1_event::data)
+	{
+		if((offset + size) > BUFFER_LEN)
+		{
+			error(example_mod, "Data size to bigger than buffer!");
+			return false;
+		}
+		std::memcpy(receive_data + offset, data, size);
+	}
+	else if(event == block1_event::commit)
+	{
+		receive_size = size;
+		std::printf("Data received[%zu]:\n----------------------\n", size);
+		std::printf("%.*s", static_cast<int>(size), receive_data);
+		std::printf("---------------------\nAll data transfered!\n\n");
+		get_done = true;
+	}
+	return true;
+}
+
+/**
+ * Every message received: the first block is the response of the
+ * request transaction, the others arrive at the default callback.
+ */
+static void process_message(engine::endpoint const& ep, engine::message const& msg) noexcept
+{
+	if(receiver.add(msg, get_sink)) return;
+	if(sender.response(ep, msg))
+	{
+		status(example_mod, "Q-Block1 response received");
+		CoAP::Debug::print_message_string(msg);
+	}
+}
+
+void request_cb(void const* trans, engine::message const* response, void*) noexcept
+{
+	if(!response)
+	{
+		status(example_mod, "Response NOT received");
+		return;
+	}
+	process_message(static_cast<engine::transaction_t const*>(trans)->endpoint(), *response);
+}
+
+void default_cb(engine::endpoint const& ep, engine::message const* msg, void*) noexcept
+{
+	process_message(ep, *msg);
+}
+
+int main()
+{
+	debug(example_mod, "Init engine code...");
+
+	/**
+	 * Window/Linux: Initialize random number generator
+	 * Windows: initialize winsock library
+	 */
+	CoAP::init();
+
+	CoAP::Error ec;
+
+	/**
+	 * Socket
+	 */
+	engine::connection conn;
+
+	conn.open(ec);
+	if(ec) exit_error(ec, "Error trying to open socket...");
+
+	engine coap_engine(std::move(conn),
+			CoAP::Message::message_id((unsigned)CoAP::time()));
+	coap_engine.default_cb(default_cb);
+
+	/**
+	 * Endpoint that request will be sent
+	 */
+	engine::endpoint ep{HOST_ADDR, COAP_PORT, ec};
+	if(ec) exit_error(ec);
+
+	/**
+	 * Q-Block2 option of the first request informs the block size and
+	 * that the client supports Q-Block.
+	 */
+	unsigned qblock2;
+	CoAP::Message::Option::make_block(qblock2, 0, false, TRANSFER_BLOCK_SIZE);
+	CoAP::Message::Option::node path_op{CoAP::Message::Option::code::uri_path, RESOURCE_DATA_PATH};
+	CoAP::Message::Option::node qblock2_op{CoAP::Message::Option::code::q_block2, qblock2};
+
+	engine::request request(ep);
+	request.header(CoAP::Message::type::confirmable, CoAP::Message::code::get)
+			.token("qget")
+			.add_option(path_op)
+			.add_option(qblock2_op)
+			.callback(request_cb);
+
+	coap_engine.send(request, ec);
+	if(ec) exit_error(ec, "send");
+
+	/**
+	 * Receiving the blocks
+	 */
+	while(!get_done && coap_engine(ec))
+	{
+		if(receiver.aborted())
+		{
+			error(example_mod, "Representation changed while receiving");
+			return EXIT_FAILURE;
+		}
+		if(!receiver.expired()) continue;
+
+		/**
+		 * Asking the missing blocks
+		 */
+		unsigned values[MAX_MISSING];
+		CoAP::Message::Option::node nodes[MAX_MISSING];
+		unsigned count = receiver.missing(values, nodes, MAX_MISSING);
+
+		status(example_mod, "Requesting %u missing blocks", count);
+		CoAP::Message::Factory<TRANSC_BUFFER_LEN> fac;
+		CoAP::Message::Option::node path{CoAP::Message::Option::code::uri_path, RESOURCE_DATA_PATH};
+		fac.header(CoAP::Message::type::nonconfirmable, CoAP::Message::code::get)
+			.token("qget")
+			.add_option(path);
+		for(unsigned i = 0; i < count; i++)
+			fac.add_option(nodes[i]);
+
+		std::size_t size = fac.serialize(coap_engine.mid(), ec);
+		if(ec) exit_error(ec, "serialize");
+		coap_engine.send(ep, fac.buffer(), size, ec);
+	}
+	if(ec) exit_error(ec, "run");
+
+	/**
+	 * Sending back the data received (Q-Block1). The Uri-Path
+	 * option must be sent at all blocks.
+	 */
+	CoAP::Message::Option::option options[] = {
+		CoAP::Message::Option::option{CoAP::Message::Option::code::uri_path, RESOURCE_DATA_PATH}
+	};
+	auto* transfer = sender.add(ep, CoAP::Message::code::put, "qput", 4,
+						receive_data, receive_size, TRANSFER_BLOCK_SIZE,
+						options, sizeof(options) / sizeof(options[0]));
+	if(!transfer) exit_error(ec, "Q-Block1 transfer");
+
+	while(transfer->used && coap_engine(ec))
+		sender.check(coap_engine);
+	if(ec) exit_error(ec, "run");
+
+	status(example_mod, "Q-Block1 transfer finished");
+
+	return EXIT_SUCCESS;
+}
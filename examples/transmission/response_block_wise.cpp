@@ -8,8 +8,17 @@
  * * PUT method: all data received from the client will be copied
  * to a buffer and then printed.
  *
- * Use this example together with "request_get_block_wise" and
- * "request_put_block_wise".
+ * Making a request to "\/qdata" resource uses Q-Block transfer (RFC 9177):
+ * * GET method: blocks are sent at bursts, without waiting the client ask
+ * each one (Q-Block2);
+ * * PUT method: the client sends the blocks at bursts (Q-Block1).
+ *
+ * Use this example together with "request_get_block_wise",
+ * "request_put_block_wise" and "request_q_block".
+ *
+ * Making a GET request to "\/.well-known/core" returns the resources
+ * description block by block. Each block is generated when requested (no
+ * buffer to the full link format).
  */
 
 #include <cstdio>
@@ -26,7 +35,7 @@ using namespace CoAP::Log;
 #define TRANSACT_NUM	4
 
 #define DEFAULT_BLOCK_SIZE	128					//Size of block defined to the server
-#define RECEIVE_PUT_BUFFER	2048				//Receiving buffer size (for PUT method)
+#define RECEIVE_PUT_BUFFER	4096				//Receiving buffer size (for PUT method)
 
 /**
  * Text copied from https://www.planetary.org/worlds/pale-blue-dot
@@ -96,6 +105,21 @@ static void get_data_handler(engine::message const& request,
 								engine::response& response, void*) noexcept;
 static void put_data_handler(engine::message const& request,
 								engine::response& response, void*) noexcept;
+static void get_qdata_handler(engine::message const& request,
+								engine::response& response, void*) noexcept;
+static void put_qdata_handler(engine::message const& request,
+								engine::response& response, void*) noexcept;
+static void get_discovery_handler(engine::message const& request,
+								engine::response& response, void*) noexcept;
+
+/**
+ * Q-Block transfers
+ *
+ * The sender list holds the Q-Block2 transfers, and the receiver list the
+ * Q-Block1 transfers. Both must be checked at the engine loop.
+ */
+static CoAP::Transmission::q_block_sender_list<engine::endpoint, TRANSACT_NUM> qsenders;
+static CoAP::Transmission::q_block1_list<engine::endpoint, TRANSACT_NUM> qreceivers;
 
 /**
  * Auxiliary function
@@ -144,72 +168,68 @@ int main()
 	 * Each resource must provide a path name, and a callback function to
 	 * the method it support. (GET/POST/PUT/DELETE)
 	 */
-	engine::resource_node	res_data{"data", get_data_handler, nullptr, put_data_handler};
+	engine::resource_node	res_data{"data", get_data_handler, nullptr, put_data_handler},
+							res_qdata{"qdata", get_qdata_handler, nullptr, put_qdata_handler},
+							res_well_known{".well-known"},
+							res_core{"core", get_discovery_handler};
 
 	debug(example_mod, "Adding resources... [%u]", sizeof(huge_data));
 	/**
 	 * Adding resource to the tree
 	 */
-	coap_engine.root_node().add_child(res_data);
+	coap_engine.root_node().add_child(res_data, res_qdata, res_well_known);
+	res_well_known.add_child(res_core);
 
 	debug(example_mod, "Initiating CoAP engine loop...");
 	//CoAP engine loop.
-	while(coap_engine(ec));
+	while(coap_engine(ec))
+	{
+		/**
+		 * Sending the Q-Block2 bursts and asking the Q-Block1
+		 * missing blocks
+		 */
+		qsenders.check(coap_engine);
+		qreceivers.check(coap_engine);
+	}
 
 	return EXIT_SUCCESS;
 }
 
+/**
+ * Ongoing block2 transfers
+ *
+ * Keeps the representation of each transfer, so it is not generated again
+ * at every block requested (and the same ETag is sent at all blocks).
+ */
+static CoAP::Transmission::block2_list<engine::endpoint, TRANSACT_NUM> transfers;
+
 /**
  * GET method for \/data
  *
- * This handler will check the 'block2' option of the request, and respond
- * to the client accordingly
+ * The response is sliced according to the 'block2' option of the request.
+ * Block size negotiation, Size2 and ETag options are handled by the library.
  */
 static void get_data_handler(engine::message const& request,
 								engine::response& response, void*) noexcept
 {
 	using namespace CoAP::Message;
 
-	Option::option b2;
-
-	/**
-	 * Default block2 options, if none is sent by the client
-	 */
-	unsigned block_size = DEFAULT_BLOCK_SIZE,
-			block_num = 0,
-			offset = 0,
-			left = sizeof(huge_data);
-	bool more = true;
-
 	/**
-	 * Checking if block2 option is present
+	 * Checking if there is a ongoing transfer to this request. If not,
+	 * starting a new one.
 	 */
-	if(Option::get_option(request, b2, Option::code::block2))
+	auto* transfer = transfers.find(response.endpoint(), request);
+	if(!transfer)
 	{
-		unsigned value = Option::parse_unsigned(b2);
-
-		block_size = Option::block_size(value);
-		block_num = Option::block_number(value);
-		offset = Option::byte_offset(value);
-
-		/**
-		 * Checking if block required is valid
-		 */
-		if(offset > sizeof(huge_data))
+		transfer = transfers.add(response.endpoint(), request, huge_data, sizeof(huge_data));
+		if(!transfer)
 		{
-			error(example_mod, "Invalid block requested");
+			error(example_mod, "No free slot to transfer");
 			response
-				.code(code::bad_request)
-				.payload("out of bound")
+				.code(code::service_unavaiable)
 				.serialize();
 			return;
 		}
-		left -= offset;
-		/**
-		 * Setting more flag
-		 */
-		if(left < block_size)
-			more = false;
 	}
 
 	/**
@@ -218,139 +238,160 @@ static void get_data_handler(engine::message const& request,
 	content_format content{content_format::text_plain};
 	Option::node content_op{content};
 
-	/**
-	 * Option size2
-	 */
-	unsigned size2 = sizeof(huge_data);
-	Option::node size2_op{Option::code::size2, size2};
-
-	/**
-	 * Option block2
-	 */
-	unsigned block2;
-	Option::make_block(block2, block_num, more, block_size);
-	Option::node block2_op{Option::code::block2, block2};
-
 	/**
 	 * Sending response
 	 */
 	response
 		.code(code::content)
 		.add_option(content_op)
-		.add_option(size2_op)
-		.add_option(block2_op)
-		.payload(huge_data + offset, left > block_size ? block_size : left)
-		.serialize();
+		.serialize_block2(request, *transfer, DEFAULT_BLOCK_SIZE);
 }
 
 /**
- * PUT method for \/data
+ * GET method for \/.well-known/core
  *
- * This handler will check the 'block1' option of the request, and copy the data
- * sent to a local buffer. It will respond to the client accordingly and wait
- * for the next data to be sent. At end, prints all data received
+ * The link format is not stored: the transfer reads each block from the
+ * resource tree when requested ('discovery_read'). Only the size is
+ * calculated at the beginning of the transfer.
  */
-static void put_data_handler(engine::message const& request,
-								engine::response& response, void*) noexcept
+static void get_discovery_handler(engine::message const& request,
+								engine::response& response, void* eng_ptr) noexcept
 {
 	using namespace CoAP::Message;
 
-	status(example_mod, "Received put data request");
-	CoAP::Debug::print_message_string(request);
-
-	Option::option opt;
-
-	/**
-	 * Checking size of data to be transfered
-	 */
-	if(Option::get_option(request, opt, Option::code::size1))
+	auto* transfer = transfers.find(response.endpoint(), request);
+	if(!transfer)
 	{
-		unsigned size = Option::parse_unsigned(opt);
-		if(size > RECEIVE_PUT_BUFFER)
+		engine::resource_node& root = static_cast<engine*>(eng_ptr)->root_node().node();
+		transfer = transfers.add(response.endpoint(), request,
+						CoAP::Resource::discovery_read<engine::resource_node>,
+						&root,
+						CoAP::Resource::discovery_size(root));
+		if(!transfer)
 		{
-			/**
-			 * If data to be sent is too big, respond with error
-			 */
-			error(example_mod, "Data to receive bigger than buffer! Interrupting transfer!");
+			error(example_mod, "No free slot to transfer");
 			response
-				.code(code::request_entity_too_large)
+				.code(code::service_unavaiable)
 				.serialize();
 			return;
 		}
 	}
 
-	/**
-	 * Checking if is a block wise transfer
-	 */
-	if(Option::get_option(request, opt, Option::code::block1))
-	{
-		unsigned value = Option::parse_unsigned(opt);
+	content_format content{content_format::application_link_format};
+	Option::node content_op{content};
 
-		unsigned block_size = Option::block_size(value),
-				block_num = Option::block_number(value),
-				offset = Option::byte_offset(value);
-		bool more = Option::more(value);
-		/**
-		 * Checking if block required is valid
-		 */
-		if(offset > RECEIVE_PUT_BUFFER)
-		{
-			error(example_mod, "Message to big");
-			response
-				.code(code::request_entity_too_large)
-				.payload("out of bound")
-				.serialize();
-			return;
-		}
-		/**
-		 * Copying received data to buffer
-		 */
-		status(example_mod, "Copying to buffer [%lu]", request.payload_len);
-		std::memcpy(recv_buffer + offset, request.payload, request.payload_len);
+	response
+		.code(code::content)
+		.add_option(content_op)
+		.serialize_block2(request, *transfer, DEFAULT_BLOCK_SIZE);
+}
 
-		/**
-		 * Is there more blocks to be sent?
-		 */
-		if(!more)
-		{
-			/**
-			 * If no more blocks to receive, just print result
-			 */
+/**
+ * Ongoing block1 transfers
+ */
+static CoAP::Transmission::block1_list<engine::endpoint, TRANSACT_NUM> uploads;
+
+/**
+ * Sink of the data received by the PUT method.
+ *
+ * Each block is copied to a local buffer as it arrives (it could be written to
+ * a file, flash...). The data is just printed when all blocks are received.
+ * Q-Block1 blocks may arrive out of order, so the offset must be respected.
+ */
+static bool put_data_sink(CoAP::Transmission::block1_event event,
+							void const* data,
+							std::size_t offset,
+							std::size_t size,
+							void*) noexcept
+{
+	using namespace CoAP::Transmission;
+
+	switch(event)
+	{
+		case block1_event::data:
+			if((offset + size) > RECEIVE_PUT_BUFFER)
+			{
+				error(example_mod, "Data to receive bigger than buffer! Interrupting transfer!");
+				return false;
+			}
+			status(example_mod, "Copying to buffer [%lu]", size);
+			std::memcpy(recv_buffer + offset, data, size);
+			break;
+		case block1_event::commit:
 			status(example_mod, "Data received:\n----------------------\n");
-			std::printf("%s", recv_buffer);
+			std::printf("%.*s", static_cast<int>(size), recv_buffer);
 			status(example_mod, "---------------------\nAll data transfered!\n\n");
-		}
+			break;
+		case block1_event::abort:
+			error(example_mod, "Transfer aborted");
+			break;
+	}
+	return true;
+}
 
-		/**
-		 * Making block option
-		 */
-		unsigned block1;
-		Option::make_block(block1,
-							block_num,
-							more,
-							block_size < DEFAULT_BLOCK_SIZE ? block_size : DEFAULT_BLOCK_SIZE);	//Choosing smaller block size
-		Option::node block1_op{Option::code::block1, block1};
-
-		response
-			.code(more ? code::ccontinue : code::changed)
-			.add_option(block1_op)
-			.serialize();
+/**
+ * PUT method for \/data
+ *
+ * The 'block1' option of the request is handled by the library, that calls the
+ * sink with each block received, and responds with 2.31 Continue while there
+ * are more blocks. The handler just responds when all data is received.
+ */
+static void put_data_handler(engine::message const& request,
+								engine::response& response, void*) noexcept
+{
+	using namespace CoAP::Message;
+
+	status(example_mod, "Received put data request");
+	CoAP::Debug::print_message_string(request);
+
+	if(uploads.process(request, response, put_data_sink, nullptr, DEFAULT_BLOCK_SIZE)
+		!= CoAP::Transmission::block1_status::complete)
 		return;
-	}
+
+	response
+		.code(code::changed)
+		.serialize();
+}
+
+/**
+ * GET method for \/qdata
+ *
+ * First block is sent at the response, and the others at bursts by 'qsenders.check'.
+ * Requests for missing blocks are also handled here.
+ */
+static void get_qdata_handler(engine::message const& request,
+								engine::response& response, void*) noexcept
+{
+	using namespace CoAP::Message;
+
+	status(example_mod, "Received Q-Block2 get request");
 
 	/**
-	 * Not block wise transfer
-	 */
-	std::memcpy(recv_buffer, request.payload, request.payload_len);
-	/**
-	 * Printing received data
+	 * Options sent at all blocks
 	 */
-	status(example_mod, "Data received:\n----------------------\n");
-	std::printf("%s", recv_buffer);
-	status(example_mod, "---------------------\nAll data transfered!\n\n");
+	Option::option options[] = {
+		Option::option{content_format::text_plain}
+	};
+
+	qsenders.process(request, response, huge_data, sizeof(huge_data), DEFAULT_BLOCK_SIZE,
+						options, sizeof(options) / sizeof(options[0]));
+}
+
+/**
+ * PUT method for \/qdata
+ *
+ * Blocks are delivered to the same sink of the \/data resource (out of order).
+ */
+static void put_qdata_handler(engine::message const& request,
+								engine::response& response, void*) noexcept
+{
+	using namespace CoAP::Message;
+
+	if(qreceivers.process(request, response, put_data_sink)
+		!= CoAP::Transmission::block1_status::complete)
+		return;
 
 	response
 		.code(code::changed)
 		.serialize();
 }
-
@@ -8,12 +8,15 @@ set(SRC_DIR_PORT ${SRC_DIR}/port)
 set(SRC_DIR_URI ${SRC_DIR}/uri)
 set(SRC_DIR_RESOURCE ${SRC_DIR}/resource)
 set(SRC_DIR_OBSERVE ${SRC_DIR}/observe)
+set(SRC_DIR_CACHE ${SRC_DIR}/cache)
+set(SRC_DIR_PROXY ${SRC_DIR}/proxy)
 
 set(MAIN_SRC ${SRC_DIR}/error.cpp
 				${SRC_DIR_URI}/compose.cpp
 				${SRC_DIR_URI}/decompose.cpp
 				${SRC_DIR_INTERNAL}/helper.cpp
 				${SRC_DIR_INTERNAL}/decoder.cpp
+				${SRC_DIR_INTERNAL}/scan.cpp
 				${SRC_DIR_MESSAGE}/options/options.cpp
 				${SRC_DIR_MESSAGE}/options/template_class.cpp
 				${SRC_DIR_MESSAGE}/options/no_response.cpp
@@ -25,6 +28,7 @@ set(MAIN_SRC ${SRC_DIR}/error.cpp
 				${SRC_DIR_MESSAGE}/reliable/serialize.cpp
 				${SRC_DIR_MESSAGE}/reliable/parser.cpp
 				${SRC_DIR_TRANSMISSION}/functions.cpp
+				${SRC_DIR_TRANSMISSION}/q_block.cpp
 				${SRC_DIR_DEBUG}/helper.cpp
 				${SRC_DIR_DEBUG}/output_string.cpp
 				${SRC_DIR_DEBUG}/print_message.cpp
@@ -32,6 +36,9 @@ set(MAIN_SRC ${SRC_DIR}/error.cpp
 				${SRC_DIR_DEBUG}/print_uri.cpp
 				${SRC_DIR_RESOURCE}/link_format.cpp
 				${SRC_DIR_OBSERVE}/functions.cpp
+				${SRC_DIR_OBSERVE}/scheduler.cpp
+				${SRC_DIR_CACHE}/functions.cpp
+				${SRC_DIR_PROXY}/functions.cpp
 				)
 
 set(SRC_PORT_POSIX ${SRC_DIR_PORT}/posix/functions.cpp)
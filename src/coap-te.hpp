@@ -12,6 +12,7 @@
 
 //Message
 #include "coap-te/message/types.hpp"
+#include "coap-te/message/indexed.hpp"
 #include "coap-te/message/codes.hpp"
 #include "coap-te/message/options/functions.hpp"
 #include "coap-te/message/options/functions2.hpp"
@@ -19,6 +20,7 @@
 #include "coap-te/message/options/parser.hpp"
 #include "coap-te/message/serialize.hpp"
 #include "coap-te/message/factory.hpp"
+#include "coap-te/message/request_template.hpp"
 #include "coap-te/message/parser.hpp"
 #include "coap-te/message/message_id.hpp"
 #if COAP_TE_RELIABLE_CONNECTION == 1
@@ -33,8 +35,13 @@
 //Resource
 #include "coap-te/resource/types.hpp"
 #include "coap-te/resource/resource.hpp"
+#include "coap-te/resource/pattern.hpp"
+#include "coap-te/resource/index.hpp"
+#include "coap-te/resource/static_table.hpp"
 #include "coap-te/resource/node.hpp"
 #include "coap-te/resource/discovery.hpp"
+#include "coap-te/resource/discovery_cache.hpp"
+#include "coap-te/resource/discovery_index.hpp"
 
 //URI
 #include "coap-te/uri/types.hpp"
@@ -46,9 +53,15 @@
 #include "coap-te/transmission/functions.hpp"
 #include "coap-te/transmission/request.hpp"
 #include "coap-te/transmission/response.hpp"
+#include "coap-te/transmission/block_wise.hpp"
+#include "coap-te/transmission/q_block.hpp"
 #include "coap-te/transmission/transaction_list.hpp"
 #include "coap-te/transmission/transaction.hpp"
 #include "coap-te/transmission/engine.hpp"
+#if COAP_TE_MULTICAST == 1
+#include "coap-te/transmission/leisure_list.hpp"
+#include "coap-te/transmission/collector.hpp"
+#endif /* COAP_TE_MULTICAST == 1 */
 #if COAP_TE_RELIABLE_CONNECTION == 1
 #include "coap-te/transmission/reliable/types.hpp"
 #include "coap-te/transmission/reliable/functions.hpp"
@@ -69,8 +82,21 @@
 #include "coap-te/observe/functions.hpp"
 #include "coap-te/observe/observer.hpp"
 #include "coap-te/observe/list.hpp"
+#include "coap-te/observe/registry.hpp"
+#include "coap-te/observe/notifier.hpp"
+#include "coap-te/observe/scheduler.hpp"
 #endif /* COAP_TE_OBSERVABLE_RESOURCE == 1 */
 
+#if COAP_TE_PROXY == 1
+#include "coap-te/cache/cache.hpp"
+#include "coap-te/cache/functions.hpp"
+#include "coap-te/cache/list.hpp"
+#include "coap-te/proxy/types.hpp"
+#include "coap-te/proxy/functions.hpp"
+#include "coap-te/proxy/exchange_list.hpp"
+#include "coap-te/proxy/proxy.hpp"
+#endif /* COAP_TE_PROXY == 1 */
+
 #if COAP_TE_JSON_HELPER == 1
 #include "coap-te/helper/json/convert.hpp"
 #endif /* COAP_TE_JSON_HELPER == 1 */
@@ -1,48 +1,83 @@
 #ifndef CoAP_TE_CACHE_HPP__
 #define CoAP_TE_CACHE_HPP__
 
-#include <ctime>
-#include "message/codes.hpp"
+#include <cstdint>
+#include <cstdlib>
 
-using namespace CoAP::Message;
+#include "../port/port.hpp"
+#include "../message/codes.hpp"
 
 namespace CoAP{
 namespace Cache{
 
-static constexpr code cachable_response[] = {
-	code::content,
+//https://tools.ietf.org/html/rfc7252#section-5.6
+static constexpr CoAP::Message::code cachable_response[] = {
+	CoAP::Message::code::content,
 	//Client Error
-	code::bad_request,
-	code::unauthorized,
-	code::bad_option,
-	code::forbidden,
-	code::not_found,
-	code::method_not_allowed,
-	code::not_accpetable,
-	code::precondition_failed,
-	code::request_entity_too_large,
-	code::unsupported_content_format,
+	CoAP::Message::code::bad_request,
+	CoAP::Message::code::unauthorized,
+	CoAP::Message::code::bad_option,
+	CoAP::Message::code::forbidden,
+	CoAP::Message::code::not_found,
+	CoAP::Message::code::method_not_allowed,
+	CoAP::Message::code::not_accpetable,
+	CoAP::Message::code::precondition_failed,
+	CoAP::Message::code::request_entity_too_large,
+	CoAP::Message::code::unsupported_content_format,
 	//Server Error
-	code::internal_server_error,
-	code::not_implemented,
-	code::bad_gateway,
-	code::service_unavaiable,
-	code::gateway_timeout,
-	code::proxying_not_supported
+	CoAP::Message::code::internal_server_error,
+	CoAP::Message::code::not_implemented,
+	CoAP::Message::code::bad_gateway,
+	CoAP::Message::code::service_unavaiable,
+	CoAP::Message::code::gateway_timeout,
+	CoAP::Message::code::proxying_not_supported
 };
 
-static constexpr code mark_not_fresh[] = {
-	code::deleted,
-	code::changed
+//https://tools.ietf.org/html/rfc7252#section-5.9.1
+static constexpr CoAP::Message::code mark_not_fresh[] = {
+	CoAP::Message::code::created,
+	CoAP::Message::code::deleted,
+	CoAP::Message::code::changed
 };
 
+//https://tools.ietf.org/html/rfc7252#section-5.10.5
+static constexpr const unsigned default_max_age = 60; //seconds
+
 using etag_type = char[8];
 
+/**
+ * Size to hold the cache-key options of a request (see 'key_data')
+ */
+static constexpr const std::size_t default_key_size = 64;
+
+/**
+ * A cache entry holds the response serialized as received, from the
+ * first option to the end of the payload. Header and token are not
+ * stored, as they must be rewritten to the requester when served.
+ *
+ * The cache-key options of the request are also stored, as the hash
+ * may collide.
+ */
+template<unsigned MaxPacketSize,
+		std::size_t MaxKeySize = default_key_size>
 struct cache{
-	bool			fresh_;
-	etag_type		etag_;
-	void const*		value_;
-	std::time_t		fresh_until_;
+	bool				used = false;
+	std::uint32_t		key = 0;			///< Hash of all cache-key options
+	std::uint8_t		key_data[MaxKeySize];	///< Cache-key options (see 'key_data')
+	std::size_t			key_len = 0;
+	std::uint32_t		resource = 0;		///< Hash of the options that identify the resource
+	CoAP::Message::code	mcode = CoAP::Message::code::empty;
+	CoAP::time_t		fresh_until = 0;
+	std::size_t			max_age_offset = 0;	///< Offset of Max-Age value at buffer (0 if absent)
+	std::size_t			max_age_len = 0;
+	std::uint8_t		buffer[MaxPacketSize];
+	std::size_t			size = 0;
+
+	void clear() noexcept
+	{
+		used = false;
+		size = 0;
+	}
 };
 
 }//Cache
@@ -0,0 +1,32 @@
+#include "functions.hpp"
+
+namespace CoAP{
+namespace Cache{
+
+bool is_cachable(CoAP::Message::code mcode) noexcept
+{
+	for(std::size_t i = 0; i < sizeof(cachable_response) / sizeof(cachable_response[0]); i++)
+		if(cachable_response[i] == mcode) return true;
+	return false;
+}
+
+bool is_mark_not_fresh(CoAP::Message::code mcode) noexcept
+{
+	for(std::size_t i = 0; i < sizeof(mark_not_fresh) / sizeof(mark_not_fresh[0]); i++)
+		if(mark_not_fresh[i] == mcode) return true;
+	return false;
+}
+
+std::uint32_t hash(void const* data, std::size_t size, std::uint32_t init /* = hash_init */) noexcept
+{
+	std::uint8_t const* d = static_cast<std::uint8_t const*>(data);
+	while(size--)
+	{
+		init ^= *d++;
+		init *= 16777619u;	//FNV-1a prime
+	}
+	return init;
+}
+
+}//Cache
+}//CoAP
@@ -0,0 +1,58 @@
+#ifndef COAP_TE_CACHE_FUNCTIONS_HPP__
+#define COAP_TE_CACHE_FUNCTIONS_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "cache.hpp"
+#include "../error.hpp"
+#include "../message/types.hpp"
+
+namespace CoAP{
+namespace Cache{
+
+static constexpr const std::uint32_t hash_init = 2166136261u;	//FNV-1a offset basis
+
+bool is_cachable(CoAP::Message::code) noexcept;
+bool is_mark_not_fresh(CoAP::Message::code) noexcept;
+
+std::uint32_t hash(void const* data, std::size_t size, std::uint32_t init = hash_init) noexcept;
+
+/**
+ * Hash of all options that are part of the cache-key (options with the NoCacheKey
+ * bit set are not included)
+ *
+ * https://tools.ietf.org/html/rfc7252#section-5.4.2
+ */
+template<typename Message>
+std::uint32_t key(Message const&) noexcept;
+
+/**
+ * Cache-key options serialized (code, length and value of each option), to
+ * be compared byte by byte when the key hashes match.
+ *
+ * Returns the size used ('ec' set as insufficient_buffer if it doesn't fit)
+ */
+template<typename Message>
+std::size_t key_data(Message const&, void* buffer, std::size_t buffer_len,
+		CoAP::Error&) noexcept;
+
+/**
+ * Hash of just the options that identifies the resource (Uri-* and Proxy-*). Used
+ * to invalidate all entries of a resource after a unsafe request.
+ */
+template<typename Message>
+std::uint32_t resource_key(Message const&) noexcept;
+
+/**
+ * Max-Age option value (or the default value if the option is not present)
+ */
+template<typename Message>
+unsigned max_age(Message const&) noexcept;
+
+}//Cache
+}//CoAP
+
+#include "impl/functions_impl.hpp"
+
+#endif /* COAP_TE_CACHE_FUNCTIONS_HPP__ */
@@ -0,0 +1,102 @@
+#ifndef COAP_TE_CACHE_FUNCTIONS_IMPL_HPP__
+#define COAP_TE_CACHE_FUNCTIONS_IMPL_HPP__
+
+#include <cstring>
+
+#include "../functions.hpp"
+#include "../../message/options/options.hpp"
+#include "../../message/options/parser.hpp"
+#include "../../message/options/functions2.hpp"
+
+namespace CoAP{
+namespace Cache{
+
+template<bool AllCacheKey,
+		typename Message>
+static std::uint32_t make_key(Message const& msg) noexcept
+{
+	using namespace CoAP::Message;
+
+	std::uint32_t h = hash_init;
+	Option::Parser<Option::code> parser(msg);
+	Option::option const* opt;
+	while((opt = parser.next()) != nullptr)
+	{
+		if constexpr(AllCacheKey)
+		{
+			if(opt->is_no_cache_key()) continue;
+		}
+		else
+		{
+			if(opt->ocode != Option::code::uri_host
+				&& opt->ocode != Option::code::uri_port
+				&& opt->ocode != Option::code::uri_path
+				&& opt->ocode != Option::code::uri_query
+				&& opt->ocode != Option::code::proxy_uri
+				&& opt->ocode != Option::code::proxy_scheme)
+				continue;
+		}
+		std::uint16_t ocode = static_cast<std::uint16_t>(opt->ocode);
+		h = hash(&ocode, sizeof(ocode), h);
+		h = hash(&opt->length, sizeof(opt->length), h);
+		h = hash(opt->value, opt->length, h);
+	}
+	return h;
+}
+
+template<typename Message>
+std::uint32_t key(Message const& msg) noexcept
+{
+	return make_key<true>(msg);
+}
+
+template<typename Message>
+std::size_t key_data(Message const& msg, void* buffer, std::size_t buffer_len,
+		CoAP::Error& ec) noexcept
+{
+	using namespace CoAP::Message;
+
+	std::uint8_t* b = static_cast<std::uint8_t*>(buffer);
+	std::size_t size = 0;
+	Option::Parser<Option::code> parser(msg);
+	Option::option const* opt;
+	while((opt = parser.next()) != nullptr)
+	{
+		if(opt->is_no_cache_key()) continue;
+		if(4 + opt->length > buffer_len - size)
+		{
+			ec = CoAP::errc::insufficient_buffer;
+			return size;
+		}
+		std::uint16_t ocode = static_cast<std::uint16_t>(opt->ocode),
+					length = static_cast<std::uint16_t>(opt->length);
+		std::memcpy(b + size, &ocode, 2);
+		std::memcpy(b + size + 2, &length, 2);
+		std::memcpy(b + size + 4, opt->value, opt->length);
+		size += 4 + opt->length;
+	}
+	return size;
+}
+
+template<typename Message>
+std::uint32_t resource_key(Message const& msg) noexcept
+{
+	return make_key<false>(msg);
+}
+
+template<typename Message>
+unsigned max_age(Message const& msg) noexcept
+{
+	using namespace CoAP::Message;
+
+	Option::option opt;
+	if(!Option::get_option(msg, opt, Option::code::max_age))
+		return default_max_age;
+
+	return Option::parse_unsigned(opt);
+}
+
+}//Cache
+}//CoAP
+
+#endif /* COAP_TE_CACHE_FUNCTIONS_IMPL_HPP__ */
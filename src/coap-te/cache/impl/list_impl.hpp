@@ -0,0 +1,194 @@
+#ifndef COAP_TE_CACHE_LIST_IMPL_HPP__
+#define COAP_TE_CACHE_LIST_IMPL_HPP__
+
+#include <cstring>
+
+#include "../list.hpp"
+#include "../functions.hpp"
+#include "../../internal/helper.hpp"
+#include "../../message/serialize.hpp"
+#include "../../message/options/parser.hpp"
+
+namespace CoAP{
+namespace Cache{
+
+template<unsigned Size,
+		unsigned MaxPacketSize,
+		std::size_t MaxKeySize>
+list<Size, MaxPacketSize, MaxKeySize>::list(){}
+
+template<unsigned Size,
+		unsigned MaxPacketSize,
+		std::size_t MaxKeySize>
+constexpr unsigned
+list<Size, MaxPacketSize, MaxKeySize>::size() const noexcept
+{
+	return Size;
+}
+
+template<unsigned Size,
+		unsigned MaxPacketSize,
+		std::size_t MaxKeySize>
+typename list<Size, MaxPacketSize, MaxKeySize>::cache_t const*
+list<Size, MaxPacketSize, MaxKeySize>::
+find(std::uint32_t key, void const* key_data, std::size_t key_len) noexcept
+{
+	CoAP::time_t now = CoAP::time();
+	for(unsigned i = 0; i < Size; i++)
+	{
+		if(!list_[i].used || !match(list_[i], key, key_data, key_len)) continue;
+		if(list_[i].fresh_until <= now)
+		{
+			list_[i].clear();
+			return nullptr;
+		}
+		return &list_[i];
+	}
+	return nullptr;
+}
+
+template<unsigned Size,
+		unsigned MaxPacketSize,
+		std::size_t MaxKeySize>
+bool
+list<Size, MaxPacketSize, MaxKeySize>::
+add(std::uint32_t key,
+		void const* key_data, std::size_t key_len,
+		std::uint32_t resource,
+		CoAP::Message::message const& response,
+		std::uint8_t const* buffer) noexcept
+{
+	std::size_t offset = 4 + response.token_len,
+				size = response.size() - offset;
+	if(size > MaxPacketSize || key_len > MaxKeySize) return false;
+
+	unsigned age = max_age(response);
+	if(!age) return false;
+
+	/**
+	 * Same key, free (or stale) slot or the entry that will expire first
+	 */
+	CoAP::time_t now = CoAP::time();
+	cache_t* slot = nullptr;
+	for(unsigned i = 0; i < Size && !slot; i++)
+		if(list_[i].used && match(list_[i], key, key_data, key_len)) slot = &list_[i];
+	for(unsigned i = 0; i < Size && !slot; i++)
+		if(!list_[i].used || list_[i].fresh_until <= now) slot = &list_[i];
+	if(!slot)
+	{
+		slot = &list_[0];
+		for(unsigned i = 1; i < Size; i++)
+			if(list_[i].fresh_until < slot->fresh_until) slot = &list_[i];
+	}
+	slot->used = true;
+	slot->key = key;
+	std::memcpy(slot->key_data, key_data, key_len);
+	slot->key_len = key_len;
+	slot->resource = resource;
+	slot->mcode = response.mcode;
+	slot->fresh_until = now + static_cast<CoAP::time_t>(age) * 1000;
+	slot->size = size;
+	std::memcpy(slot->buffer, buffer + offset, size);
+
+	slot->max_age_offset = 0;
+	slot->max_age_len = 0;
+	CoAP::Message::Option::option opt;
+	if(CoAP::Message::Option::get_option(response, opt, CoAP::Message::Option::code::max_age)
+		&& opt.length <= sizeof(unsigned))
+	{
+		slot->max_age_offset = static_cast<std::uint8_t const*>(opt.value) - (buffer + offset);
+		slot->max_age_len = opt.length;
+	}
+
+	return true;
+}
+
+template<unsigned Size,
+		unsigned MaxPacketSize,
+		std::size_t MaxKeySize>
+void
+list<Size, MaxPacketSize, MaxKeySize>::
+invalidate(std::uint32_t resource) noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+		if(list_[i].used && list_[i].resource == resource)
+			list_[i].clear();
+}
+
+template<unsigned Size,
+		unsigned MaxPacketSize,
+		std::size_t MaxKeySize>
+void
+list<Size, MaxPacketSize, MaxKeySize>::
+clear() noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+		list_[i].clear();
+}
+
+template<unsigned Size,
+		unsigned MaxPacketSize,
+		std::size_t MaxKeySize>
+std::size_t
+list<Size, MaxPacketSize, MaxKeySize>::
+serialize(cache_t const& entry,
+		std::uint8_t* buffer, std::size_t buffer_len,
+		CoAP::Message::type mtype, std::uint16_t mid,
+		void const* token, std::size_t token_len,
+		CoAP::Error& ec) noexcept
+{
+	std::size_t offset = CoAP::Message::make_header(buffer, buffer_len,
+							mtype, entry.mcode, mid,
+							token, token_len, ec);
+	if(ec) return offset;
+
+	if(entry.size > (buffer_len - offset))
+	{
+		ec = CoAP::errc::insufficient_buffer;
+		return offset;
+	}
+	std::memcpy(buffer + offset, entry.buffer, entry.size);
+
+	if(entry.max_age_len)
+	{
+		CoAP::time_t now = CoAP::time();
+		unsigned remaining = entry.fresh_until > now ?
+				static_cast<unsigned>((entry.fresh_until - now) / 1000) : 0;
+		/**
+		 * Remaining time is always lower than the original value, so it always fits
+		 * the same option length (leading zeros are allowed)
+		 */
+		CoAP::Helper::interger_to_big_endian_array(buffer + offset + entry.max_age_offset,
+				remaining, entry.max_age_len);
+	}
+
+	return offset + entry.size;
+}
+
+template<unsigned Size,
+		unsigned MaxPacketSize,
+		std::size_t MaxKeySize>
+typename list<Size, MaxPacketSize, MaxKeySize>::cache_t*
+list<Size, MaxPacketSize, MaxKeySize>::
+operator[](unsigned index) noexcept
+{
+	return index >= Size ? nullptr : &list_[index];
+}
+
+template<unsigned Size,
+		unsigned MaxPacketSize,
+		std::size_t MaxKeySize>
+bool
+list<Size, MaxPacketSize, MaxKeySize>::
+match(cache_t const& entry, std::uint32_t key,
+		void const* key_data, std::size_t key_len) noexcept
+{
+	return entry.key == key
+			&& entry.key_len == key_len
+			&& std::memcmp(entry.key_data, key_data, key_len) == 0;
+}
+
+}//Cache
+}//CoAP
+
+#endif /* COAP_TE_CACHE_LIST_IMPL_HPP__ */
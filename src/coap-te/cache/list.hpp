@@ -0,0 +1,75 @@
+#ifndef COAP_TE_CACHE_LIST_HPP__
+#define COAP_TE_CACHE_LIST_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "cache.hpp"
+#include "../error.hpp"
+#include "../message/types.hpp"
+
+namespace CoAP{
+namespace Cache{
+
+/**
+ * Fixed size response cache. Entries are found by the cache-key of the
+ * request (hash, and then the cache-key options compared byte by byte),
+ * and are considered fresh until the Max-Age of the response elapses.
+ *
+ * https://tools.ietf.org/html/rfc7252#section-5.6
+ */
+template<unsigned Size,
+		unsigned MaxPacketSize,
+		std::size_t MaxKeySize = default_key_size>
+class list{
+	public:
+		using cache_t = cache<MaxPacketSize, MaxKeySize>;
+		static constexpr const std::size_t key_size = MaxKeySize;
+
+		list();
+
+		constexpr unsigned size() const noexcept;
+
+		/**
+		 * Key data as made by 'key_data'
+		 */
+		cache_t const* find(std::uint32_t key,
+				void const* key_data, std::size_t key_len) noexcept;
+
+		/**
+		 * Response buffer must be the buffer used to parse the message
+		 */
+		bool add(std::uint32_t key,
+				void const* key_data, std::size_t key_len,
+				std::uint32_t resource,
+				CoAP::Message::message const& response,
+				std::uint8_t const* buffer) noexcept;
+
+		void invalidate(std::uint32_t resource) noexcept;
+		void clear() noexcept;
+
+		/**
+		 * Serialize a fresh response from the cache entry, with the header/token
+		 * provided. If present, the Max-Age option is updated to the remaining
+		 * freshness time.
+		 */
+		static std::size_t serialize(cache_t const&,
+				std::uint8_t* buffer, std::size_t buffer_len,
+				CoAP::Message::type, std::uint16_t mid,
+				void const* token, std::size_t token_len,
+				CoAP::Error&) noexcept;
+
+		cache_t* operator[](unsigned index) noexcept;
+	private:
+		static bool match(cache_t const&, std::uint32_t key,
+				void const* key_data, std::size_t key_len) noexcept;
+
+		cache_t		list_[Size];
+};
+
+}//Cache
+}//CoAP
+
+#include "impl/list_impl.hpp"
+
+#endif /* COAP_TE_CACHE_LIST_HPP__ */
@@ -63,7 +63,12 @@ static void print_payload(CoAP::Message::Option::option_template<OptionCode> con
 	if constexpr(std::is_same<OptionCode, CoAP::Message::Option::code>::value)
 	{
 		if(op.ocode == CoAP::Message::Option::code::block1 ||
-			op.ocode == CoAP::Message::Option::code::block2)
+			op.ocode == CoAP::Message::Option::code::block2
+#if COAP_TE_Q_BLOCK == 1
+			|| op.ocode == CoAP::Message::Option::code::q_block1
+			|| op.ocode == CoAP::Message::Option::code::q_block2
+#endif /* COAP_TE_Q_BLOCK == 1 */
+			)
 		{
 			unsigned value;
 			CoAP::Helper::array_to_unsigned(static_cast<std::uint8_t const*>(op.value), op.length, value);
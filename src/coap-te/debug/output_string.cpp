@@ -106,6 +106,10 @@ const char* option_string(CoAP::Message::Option::code op) noexcept
 		case code::block1:			return "Block1";
 		case code::size2:			return "Size2";
 #endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+#if COAP_TE_Q_BLOCK == 1
+		case code::q_block1:		return "Q-Block1";
+		case code::q_block2:		return "Q-Block2";
+#endif /* COAP_TE_Q_BLOCK == 1 */
 		case code::max_age: 		return "Max-Age";
 		case code::proxy_uri: 		return "Proxy-Uri";
 		case code::proxy_scheme: 	return "Proxy-Scheme";
@@ -123,6 +127,9 @@ const char* option_string(CoAP::Message::Option::code op) noexcept
 #if COAP_TE_OPTION_NO_RESPONSE == 1
 		case code::no_response:		return "No response";
 #endif /* COAP_TE_OPTION_NO_RESPONSE == 1 */
+#if	COAP_TE_BLOCKWISE_TRANSFER == 1
+		case code::request_tag:		return "Request-Tag";
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
 		default:
 			break;
 	}
@@ -12,6 +12,27 @@
 #define COAP_TE_BLOCKWISE_TRANSFER	1
 #endif /* COAP_TE_BLOCKWISE_TRANSFER */
 
+/**
+ * RFC9177 - Constrained Application Protocol (CoAP) Block-Wise Transfer Options
+ * 				Supporting Robust Transmission
+ * https://tools.ietf.org/html/rfc9177
+ *
+ * Depends on COAP_TE_BLOCKWISE_TRANSFER
+ */
+#ifndef COAP_TE_Q_BLOCK
+#define COAP_TE_Q_BLOCK	1
+#endif /* COAP_TE_Q_BLOCK */
+
+/**
+ * Number of Block2 transfers held by the engine to the automatic Block2
+ * responses (see Response::representation)
+ *
+ * Depends on COAP_TE_BLOCKWISE_TRANSFER
+ */
+#ifndef COAP_TE_BLOCK2_TRANSFERS
+#define COAP_TE_BLOCK2_TRANSFERS	4
+#endif /* COAP_TE_BLOCK2_TRANSFERS */
+
 /**
  * RFC6690 - Constrained RESTful Environments (CoRE) Link Format
  * https://tools.ietf.org/html/rfc6690
@@ -28,6 +49,16 @@
 #define COAP_TE_RELIABLE_CONNECTION 1
 #endif /* COAP_TE_RELIABLE_CONNECTION */
 
+/**
+ * Reliable connections: cork the TCP socket (TCP_CORK, where available)
+ * while processing the messages of one read, so the responses are
+ * coalesced at fewer packets. Only used by connections without a send
+ * queue (that already hold the responses of one read).
+ */
+#ifndef COAP_TE_TCP_CORK
+#define COAP_TE_TCP_CORK 0
+#endif /* COAP_TE_TCP_CORK */
+
 /**
  * RFC7641 - Observing Resources in the Constrained Application Protocol (CoAP)
  * https://tools.ietf.org/html/rfc7641
@@ -60,6 +91,24 @@
 #define COAP_TE_OPTION_HOP_LIMIT 1
 #endif /* COAP_TE_OPTION_HOP_LIMIT */
 
+/**
+ * RFC7252 - Group Communication (multicast)
+ * https://tools.ietf.org/html/rfc7252#section-8
+ * RFC7390 - Group Communication for the Constrained Application Protocol (CoAP)
+ * https://tools.ietf.org/html/rfc7390
+ */
+#ifndef COAP_TE_MULTICAST
+#define COAP_TE_MULTICAST 1
+#endif /* COAP_TE_MULTICAST */
+
+/**
+ * RFC7252 - Proxying
+ * https://tools.ietf.org/html/rfc7252#section-5.7
+ */
+#ifndef COAP_TE_PROXY
+#define COAP_TE_PROXY 1
+#endif /* COAP_TE_PROXY */
+
 namespace CoAP{
 
 static constexpr std::uint16_t default_port = 5683;
@@ -19,6 +19,7 @@ const char* Error::message(int error)
 	{
 		case errc::insufficient_buffer:	return "insufficient buffer";
 		case errc::invalid_data:		return "invalid data";
+		case errc::not_built:			return "not built";
 		case errc::invalid_token_length: return "invalid token length";
 		case errc::message_too_small:	return "message too small";
 		case errc::version_invalid:		return "invalid version";
@@ -36,10 +37,13 @@ const char* Error::message(int error)
 		case errc::socket_receive:		return "socket receive";
 		case errc::socket_send:			return "socket bind";
 		case errc::socket_bind:			return "socket bind";
+		case errc::socket_option:		return "socket option";
 		case errc::transaction_ocupied:	return "transaction ocupied";
 		case errc::no_free_slots:		return "no transacition free slot";
 		case errc::buffer_empty:		return "buffer empty";
 		case errc::request_not_supported: return "request not supported";
+		case errc::send_queue_full:		return "send queue full";
+		case errc::not_writable:		return "not writable";
 		default:
 			break;
 	}
@@ -7,6 +7,7 @@ enum class errc : int{
 	//General
 	insufficient_buffer		= 10,
 	invalid_data,
+	not_built,
 	//message
 	code_invalid 			= 20,
 	invalid_token_length,
@@ -28,11 +29,14 @@ enum class errc : int{
 	socket_receive,
 	socket_send,
 	socket_bind,
+	socket_option,
 	//transmission
 	transaction_ocupied		= 60,
 	no_free_slots,
 	buffer_empty,
-	request_not_supported
+	request_not_supported,
+	send_queue_full,
+	not_writable
 };
 
 struct Error {
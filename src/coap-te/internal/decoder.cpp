@@ -1,35 +1,41 @@
 #include "decoder.hpp"
 #include "ascii.hpp"
+#include "scan.hpp"
 #include <cstdio>
 #include <cstring>
 
 namespace CoAP{
 namespace Helper{
 
+/**
+ * The runs of characters between '%' are found a word at a time (see 'find_char')
+ * and copied at once.
+ */
 std::size_t percent_decode(char* buffer_out, std::size_t buffer_out_len,
 					const char* buffer_in, std::size_t buffer_in_len) noexcept
 {
 	std::size_t j = 0;
 	for(std::size_t i = 0; i < buffer_in_len;)
 	{
+		std::size_t run = find_char(buffer_in + i, buffer_in_len - i, '%');
+		if(run > buffer_out_len - j)
+			return 0;
+
+		std::memcpy(buffer_out + j, buffer_in + i, run);
+		i += run; j += run;
+		if(i == buffer_in_len) break;
+
 		if(j >= buffer_out_len)
 			return 0;
 
-		if(buffer_in[i] == '%')
+		//Has '%'. Check if has 2 characters and if they are hexadecimal
+		if((buffer_in_len - i) > 2
+			&& is_hexa(buffer_in[i+1]) && is_hexa(buffer_in[i+2]))
 		{
-			//Has '%'. Check if has 2 characters
-			if((buffer_in_len - i) >= 2)
-			{
-				//Check if characters are hexadecimal
-				if(is_hexa(buffer_in[i+1]) && is_hexa(buffer_in[i+2]))
-				{
-					//Characters are hexadecimal
-					buffer_out[j] = static_cast<char>((hexa_char_to_int(buffer_in[i+1]) << 4) |
-									hexa_char_to_int(buffer_in[i+2]));
-					i += 3; j++;
-					continue;
-				}
-			}
+			buffer_out[j] = static_cast<char>((hexa_char_to_int(buffer_in[i+1]) << 4) |
+							hexa_char_to_int(buffer_in[i+2]));
+			i += 3; j++;
+			continue;
 		}
 		buffer_out[j] = buffer_in[i];
 		j++; i++;
@@ -44,24 +50,22 @@ std::size_t percent_decode(char* buffer, std::size_t buffer_len) noexcept
 	std::size_t j = 0;
 	for(std::size_t i = 0; i < buffer_len;)
 	{
-		if(buffer[i] == '%')
+		std::size_t run = find_char(buffer + i, buffer_len - i, '%');
+		if(j != i)
+			std::memmove(buffer + j, buffer + i, run);
+		i += run; j += run;
+		if(i == buffer_len) break;
+
+		//Has '%'. Check if has 2 characters and if they are hexadecimal
+		if((buffer_len - i) > 2
+			&& is_hexa(buffer[i+1]) && is_hexa(buffer[i+2]))
 		{
-			//Has '%'. Check if has 2 characters
-			if((buffer_len - i) >= 2)
-			{
-				//Check if characters are hexadecimal
-				if(is_hexa(buffer[i+1]) && is_hexa(buffer[i+2]))
-				{
-					//Characters are hexadecimal
-					buffer[j] = static_cast<char>((hexa_char_to_int(buffer[i+1]) << 4) |
-									hexa_char_to_int(buffer[i+2]));
-					i += 3; j++;
-					continue;
-				}
-			}
+			buffer[j] = static_cast<char>((hexa_char_to_int(buffer[i+1]) << 4) |
+							hexa_char_to_int(buffer[i+2]));
+			i += 3; j++;
+			continue;
 		}
-		if(j != i)
-			buffer[j] = buffer[i];
+		buffer[j] = buffer[i];
 		j++; i++;
 	}
 	if(j != buffer_len) buffer[j] = '\0';
@@ -2,7 +2,7 @@
 #define COAP_TE_HELPER_ENCODE_IMPL_HPP__
 
 #include "../encoder.hpp"
-#include <cstdio>
+#include "../scan.hpp"
 #include <cstring>
 
 namespace CoAP{
@@ -44,6 +44,24 @@ std::size_t percent_encoded_size(const char* buffer, std::size_t buffer_used,
 	return size_after_encoded;
 }
 
+/**
+ * With a list of characters, the characters to encode are found a word
+ * at a time (see 'find_chars')
+ */
+inline std::size_t percent_encoded_size(const char* buffer, std::size_t buffer_used,
+								encoder_list list,
+								std::size_t* changes = nullptr)
+{
+	std::size_t found = 0;
+	for(std::size_t i = find_chars(buffer, buffer_used, list.list_, list.size_);
+		i < buffer_used;
+		i += 1 + find_chars(buffer + i + 1, buffer_used - i - 1, list.list_, list.size_))
+		found++;
+
+	if(changes) *changes = found;
+	return buffer_used + 2 * found;
+}
+
 template<typename Functor>
 int percent_encode(char* buffer, std::size_t buffer_used, std::size_t buffer_len_total,
 					Functor func)
@@ -59,10 +77,13 @@ int percent_encode(char* buffer, std::size_t buffer_used, std::size_t buffer_len
 	{
 		if(func(buffer[i]))
 		{
-				char temp[4];
+				static constexpr const char hexa[] = "0123456789ABCDEF";
+				unsigned char c = static_cast<unsigned char>(buffer[i]);
 				changes_needed--;
-				std::snprintf(temp, 4, "%%%02X", buffer[i]);
-				std::memcpy(buffer + i + 2 * changes_needed, temp, 3);
+				char* dest = buffer + i + 2 * changes_needed;
+				dest[0] = '%';
+				dest[1] = hexa[c >> 4];
+				dest[2] = hexa[c & 0x0F];
 		}
 		else
 		{
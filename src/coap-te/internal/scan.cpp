@@ -0,0 +1,78 @@
+#include "scan.hpp"
+#include <cstring>
+
+namespace CoAP{
+namespace Helper{
+
+using word = std::size_t;
+
+static constexpr const word ones = ~static_cast<word>(0) / 0xFF;	//0x0101...
+static constexpr const word highs = ones * 0x80;					//0x8080...
+
+static inline word load_word(char const* buffer) noexcept
+{
+	word w;
+	std::memcpy(&w, buffer, sizeof(word));
+	return w;
+}
+
+/**
+ * Non zero if any byte of the word is zero
+ */
+static inline word has_zero(word w) noexcept
+{
+	return (w - ones) & ~w & highs;
+}
+
+static inline bool in_set(char c, char const* set, std::size_t set_len) noexcept
+{
+	for(std::size_t i = 0; i < set_len; i++)
+		if(c == set[i]) return true;
+	return false;
+}
+
+std::size_t find_char(char const* buffer, std::size_t length, char c) noexcept
+{
+	word const pattern = ones * static_cast<unsigned char>(c);
+
+	std::size_t i = 0;
+	for(; i + sizeof(word) <= length; i += sizeof(word))
+	{
+		if(has_zero(load_word(buffer + i) ^ pattern))
+			break;
+	}
+
+	for(; i < length; i++)
+		if(buffer[i] == c) return i;
+
+	return length;
+}
+
+std::size_t find_chars(char const* buffer, std::size_t length,
+		char const* set, std::size_t set_len) noexcept
+{
+	if(set_len == 1) return find_char(buffer, length, set[0]);
+
+	std::size_t i = 0;
+	for(; i + sizeof(word) <= length; i += sizeof(word))
+	{
+		word const w = load_word(buffer + i);
+		word match = 0;
+		for(std::size_t j = 0; j < set_len; j++)
+			match |= has_zero(w ^ (ones * static_cast<unsigned char>(set[j])));
+
+		if(match)
+		{
+			for(std::size_t j = i; j < i + sizeof(word); j++)
+				if(in_set(buffer[j], set, set_len)) return j;
+		}
+	}
+
+	for(; i < length; i++)
+		if(in_set(buffer[i], set, set_len)) return i;
+
+	return length;
+}
+
+}//Helper
+}//CoAP
@@ -0,0 +1,27 @@
+#ifndef COAP_TE_INTERNAL_SCAN_HPP__
+#define COAP_TE_INTERNAL_SCAN_HPP__
+
+#include <cstdlib>
+#include <cstdint>
+
+namespace CoAP{
+namespace Helper{
+
+/**
+ * Character search, a word (std::size_t) at a time
+ *
+ * Each word is compared to all the characters searched at once (SWAR, SIMD
+ * within a register), and only words that have a match are checked byte
+ * by byte. It is portable (no instruction set extension or alignment
+ * needed), so works at all ports.
+ *
+ * Returns the offset of the first character found, or 'length' if not found.
+ */
+std::size_t find_char(char const* buffer, std::size_t length, char c) noexcept;
+std::size_t find_chars(char const* buffer, std::size_t length,
+		char const* set, std::size_t set_len) noexcept;
+
+}//Helper
+}//CoAP
+
+#endif /* COAP_TE_INTERNAL_SCAN_HPP__ */
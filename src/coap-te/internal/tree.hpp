@@ -17,6 +17,7 @@ class branch{
 		T const& value() const noexcept{ return value_; }
 		branch* next() noexcept{ return next_; }
 		branch const* next() const noexcept{ return next_; }
+		branch* children() noexcept { return children_; }
 		branch const* children() const noexcept { return children_; }
 
 		template<typename U>
@@ -26,6 +26,7 @@ class Factory{
 		Factory& token(const char*) noexcept;
 
 		Factory& add_option(Option::node&) noexcept;
+		Factory& remove_option(Option::node&) noexcept;
 
 		Factory& payload(void const*, std::size_t) noexcept;
 		Factory& payload(const char*) noexcept;
@@ -34,6 +35,8 @@ class Factory{
 
 		CoAP::Message::type type() const noexcept;
 		CoAP::Message::code code() const noexcept;
+		void const* payload_data() const noexcept;
+		std::size_t payload_size() const noexcept;
 
 		template<bool SortOptions = true,
 				bool CheckOpOrder = !SortOptions,
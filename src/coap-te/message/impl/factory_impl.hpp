@@ -67,6 +67,16 @@ add_option(Option::node& node) noexcept
 	return *this;
 }
 
+template<std::size_t BufferSize, typename MessageID>
+Factory<BufferSize, MessageID>&
+Factory<BufferSize, MessageID>::
+remove_option(Option::node& node) noexcept
+{
+	opt_list_.remove(node);
+
+	return *this;
+}
+
 template<std::size_t BufferSize, typename MessageID>
 Factory<BufferSize, MessageID>&
 Factory<BufferSize, MessageID>::
@@ -207,6 +217,22 @@ code() const noexcept
 	return code_;
 }
 
+template<std::size_t BufferSize, typename MessageID>
+void const*
+Factory<BufferSize, MessageID>::
+payload_data() const noexcept
+{
+	return payload_;
+}
+
+template<std::size_t BufferSize, typename MessageID>
+std::size_t
+Factory<BufferSize, MessageID>::
+payload_size() const noexcept
+{
+	return payload_len_;
+}
+
 }//Message
 }//Factory
 
@@ -0,0 +1,111 @@
+#ifndef COAP_TE_MESSAGE_INDEXED_IMPL_HPP__
+#define COAP_TE_MESSAGE_INDEXED_IMPL_HPP__
+
+#include "../indexed.hpp"
+
+namespace CoAP{
+namespace Message{
+
+template<unsigned Size>
+indexed_message<Size>::indexed_message()
+{
+	static_assert(Size > 0, "Option index size must be > 0");
+	static_assert(Size < 0xFFFF, "Option index size must be < 65535");
+	clear_index();
+}
+
+template<unsigned Size>
+void indexed_message<Size>::clear() noexcept
+{
+	message::clear();
+	clear_index();
+}
+
+template<unsigned Size>
+void indexed_message<Size>::clear_index() noexcept
+{
+	entries_num = 0;
+	indexed = true;
+	for(unsigned i = 0; i < direct_codes; i++) first_[i] = 0;
+}
+
+template<unsigned Size>
+void indexed_message<Size>::add(unsigned ocode, std::size_t offset, std::size_t length) noexcept
+{
+	if(entries_num == Size
+		|| ocode > 0xFFFF
+		|| offset > 0xFFFF
+		|| length > 0xFFFF)
+	{
+		indexed = false;
+		return;
+	}
+
+	if(ocode < direct_codes && !first_[ocode])
+		first_[ocode] = static_cast<first_t>(entries_num + 1);
+
+	option_entry& e = entries[entries_num++];
+	e.ocode = static_cast<std::uint16_t>(ocode);
+	e.offset = static_cast<std::uint16_t>(offset);
+	e.length = static_cast<std::uint16_t>(length);
+}
+
+template<unsigned Size>
+template<typename OptionCode>
+option_entry const* indexed_message<Size>::find(OptionCode code) const noexcept
+{
+	unsigned ocode = static_cast<unsigned>(code);
+	if(ocode < direct_codes)
+		return first_[ocode] ? &entries[first_[ocode] - 1] : nullptr;
+
+	for(unsigned i = 0; i < entries_num; i++)
+	{
+		if(entries[i].ocode == ocode) return &entries[i];
+		if(entries[i].ocode > ocode) break;
+	}
+	return nullptr;
+}
+
+template<unsigned Size>
+option_entry const* indexed_message<Size>::next(option_entry const* entry) const noexcept
+{
+	option_entry const* n = entry + 1;
+	return n < entries + entries_num && n->ocode == entry->ocode ? n : nullptr;
+}
+
+template<unsigned Size>
+template<typename OptionCode>
+unsigned indexed_message<Size>::count(OptionCode code) const noexcept
+{
+	unsigned c = 0;
+	for(option_entry const* e = find(code); e; e = next(e)) c++;
+	return c;
+}
+
+template<unsigned Size>
+template<typename OptionCode>
+bool indexed_message<Size>::get(Option::option_template<OptionCode>& opt,
+		OptionCode code, unsigned count /* = 0 */) const noexcept
+{
+	option_entry const* e = find(code);
+	for(; e && count; count--) e = next(e);
+	if(!e) return false;
+
+	option(*e, opt);
+	return true;
+}
+
+template<unsigned Size>
+template<typename OptionCode>
+void indexed_message<Size>::option(option_entry const& entry,
+		Option::option_template<OptionCode>& opt) const noexcept
+{
+	opt.ocode = static_cast<OptionCode>(entry.ocode);
+	opt.length = entry.length;
+	opt.value = entry.length ? option_init + entry.offset : nullptr;
+}
+
+}//Message
+}//CoAP
+
+#endif /* COAP_TE_MESSAGE_INDEXED_IMPL_HPP__ */
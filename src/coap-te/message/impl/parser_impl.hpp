@@ -26,6 +26,12 @@ unsigned parse_options(Message& msg,
 			return offset;
 		delta = static_cast<unsigned>(opt.ocode);
 		msg.option_num++;
+		if constexpr(is_indexed_message<Message>::value)
+		{
+			msg.add(delta,
+				opt.value ? static_cast<std::uint8_t const*>(opt.value) - buffer : 0,
+				opt.length);
+		}
 	}
 	msg.options_len = offset;
 
@@ -52,20 +58,48 @@ unsigned parse_payload(Message& msg,
 	return offset;
 }
 
+template<typename Message>
+unsigned parse_body(Message& msg,
+		std::uint8_t const* const buffer, std::size_t buffer_len,
+		CoAP::Error& ec) noexcept
+{
+	if(buffer_len == 0) return 0;
+
+	unsigned offset = parse_options(msg, buffer, buffer_len, ec);
+	if(ec || (buffer_len - offset) == 0)
+		return offset;
+
+	offset += parse_payload(msg, buffer + offset, buffer_len - offset, ec);
+
+	return offset;
+}
+
+template<unsigned Size>
+unsigned parse(indexed_message<Size>& msg,
+		std::uint8_t const* const buffer, std::size_t buffer_len,
+		CoAP::Error& ec) noexcept
+{
+	msg.clear_index();
+
+	unsigned offset = parse_header(msg, buffer, buffer_len, ec);
+	if(ec || (buffer_len - offset) == 0)
+		return offset;
+
+	offset += parse_body(msg, buffer + offset, buffer_len - offset, ec);
+
+	return offset;
+}
+
 template<typename Message>
 bool query_by_key(Message const& msg,
 		const char* key, const void** value,
 		unsigned& length) noexcept
 {
-	Option::Parser<Option::code> parser(msg);
-	Option::option const *opt;
-
-	while((opt = parser.next()) != nullptr)
-	{
-		if(opt->ocode == Option::code::uri_query)
-		{
-			const char *nkey = key, *opt_value = static_cast<const char*>(opt->value);
-			unsigned len = opt->length;
+	bool found = false;
+	Option::for_each_option(msg, Option::code::uri_query,
+		[&](Option::option const& opt){
+			const char *nkey = key, *opt_value = static_cast<const char*>(opt.value);
+			unsigned len = opt.length;
 			int i = 0;
 			while(len && nkey[i] && nkey[i] == opt_value[i])
 			{
@@ -77,17 +111,19 @@ bool query_by_key(Message const& msg,
 				{
 					*value = (opt_value + i) + 1;
 					length = len;
-					return true;
+					found = true;
+					return false;
 				}
 				if(len == 0)
 				{
 					length = 0;
-					return true;
+					found = true;
+					return false;
 				}
 			}
-		}
-	}
-	return false;
+			return true;
+		});
+	return found;
 }
 
 }//Message
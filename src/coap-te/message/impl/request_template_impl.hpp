@@ -0,0 +1,228 @@
+#ifndef COAP_TE_MESSAGE_REQUEST_TEMPLATE_IMPL_HPP__
+#define COAP_TE_MESSAGE_REQUEST_TEMPLATE_IMPL_HPP__
+
+#include <cstring>
+
+#include "../request_template.hpp"
+#include "../parser.hpp"
+#include "../options/parser.hpp"
+
+namespace CoAP{
+namespace Message{
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+request_template<MaxSize, MaxRegions>::
+request_template()
+{
+	static_assert(MaxSize >= 4, "Template size must be >= 4 (header)");
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+template<bool SortOptions,
+		bool CheckOpOrder,
+		bool CheckOpRepeat,
+		std::size_t BufferSize,
+		typename MessageID>
+std::size_t
+request_template<MaxSize, MaxRegions>::
+build(Factory<BufferSize, MessageID> const& fac, CoAP::Error& ec) noexcept
+{
+	clear();
+
+	std::size_t size = fac.template serialize<SortOptions, CheckOpOrder, CheckOpRepeat>(
+							buffer_, MaxSize, 0, ec);
+	if(ec) return 0;
+
+	return build(buffer_, size, ec);
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+std::size_t
+request_template<MaxSize, MaxRegions>::
+build(std::uint8_t const* buffer, std::size_t size, CoAP::Error& ec) noexcept
+{
+	clear();
+	if(size > MaxSize)
+	{
+		ec = CoAP::errc::insufficient_buffer;
+		return 0;
+	}
+
+	message msg;
+	parse(msg, buffer, size, ec);
+	if(ec) return 0;
+
+	if(buffer != buffer_) std::memcpy(buffer_, buffer, size);
+	size_ = size;
+	payload_offset_ = msg.payload_len ?
+			static_cast<std::size_t>(static_cast<std::uint8_t const*>(msg.payload) - buffer) - 1
+			: size;
+
+	return size_;
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+void
+request_template<MaxSize, MaxRegions>::
+clear() noexcept
+{
+	size_ = 0;
+	payload_offset_ = 0;
+	regions_num_ = 0;
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+int
+request_template<MaxSize, MaxRegions>::
+mark(Option::code ocode, unsigned count /* = 0 */) noexcept
+{
+	if(regions_num_ == MaxRegions || !size_) return -1;
+
+	CoAP::Error ec;
+	message msg;
+	parse(msg, buffer_, size_, ec);
+	if(ec) return -1;
+
+	int index = -1;
+	Option::for_each_option(msg, ocode,
+		[&](Option::option const& opt){
+			if(count--) return true;
+
+			region& reg = regions_[regions_num_];
+			reg.offset = opt.length ?
+					static_cast<std::size_t>(static_cast<std::uint8_t const*>(opt.value) - buffer_)
+					: 0;
+			reg.length = opt.length;
+			index = static_cast<int>(regions_num_++);
+			return false;
+		});
+
+	return index;
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+bool
+request_template<MaxSize, MaxRegions>::
+token(void const* token, std::size_t token_len) noexcept
+{
+	if(!size_ || token_len != (buffer_[0] & 0x0F)) return false;
+
+	std::memcpy(buffer_ + 4, token, token_len);
+	return true;
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+bool
+request_template<MaxSize, MaxRegions>::
+value(unsigned index, void const* value, std::size_t length) noexcept
+{
+	if(index >= regions_num_ || regions_[index].length != length) return false;
+
+	std::memcpy(buffer_ + regions_[index].offset, value, length);
+	return true;
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+bool
+request_template<MaxSize, MaxRegions>::
+payload(void const* payload, std::size_t payload_len) noexcept
+{
+	if(!size_) return false;
+	if(!payload_len)
+	{
+		size_ = payload_offset_;
+		return true;
+	}
+
+	if(payload_offset_ + 1 + payload_len > MaxSize) return false;
+
+	buffer_[payload_offset_] = payload_marker;
+	std::memcpy(buffer_ + payload_offset_ + 1, payload, payload_len);
+	size_ = payload_offset_ + 1 + payload_len;
+
+	return true;
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+CoAP::Message::type
+request_template<MaxSize, MaxRegions>::
+type() const noexcept
+{
+	return static_cast<CoAP::Message::type>((buffer_[0] >> 4) & 0x03);
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+CoAP::Message::code
+request_template<MaxSize, MaxRegions>::
+code() const noexcept
+{
+	return static_cast<CoAP::Message::code>(buffer_[1]);
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+std::uint8_t const*
+request_template<MaxSize, MaxRegions>::
+buffer() const noexcept
+{
+	return buffer_;
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+std::size_t
+request_template<MaxSize, MaxRegions>::
+size() const noexcept
+{
+	return size_;
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+unsigned
+request_template<MaxSize, MaxRegions>::
+regions() const noexcept
+{
+	return regions_num_;
+}
+
+template<std::size_t MaxSize,
+		unsigned MaxRegions>
+std::size_t
+request_template<MaxSize, MaxRegions>::
+serialize(std::uint8_t* buffer, std::size_t buffer_len,
+		std::uint16_t mid, CoAP::Error& ec) const noexcept
+{
+	if(!size_)
+	{
+		ec = CoAP::errc::buffer_empty;
+		return 0;
+	}
+
+	if(size_ > buffer_len)
+	{
+		ec = CoAP::errc::insufficient_buffer;
+		return 0;
+	}
+
+	std::memcpy(buffer, buffer_, size_);
+	buffer[2] = static_cast<std::uint8_t>(mid >> 8);
+	buffer[3] = static_cast<std::uint8_t>(mid);
+
+	return size_;
+}
+
+}//Message
+}//CoAP
+
+#endif /* COAP_TE_MESSAGE_REQUEST_TEMPLATE_IMPL_HPP__ */
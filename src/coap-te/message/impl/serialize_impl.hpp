@@ -94,6 +94,30 @@ std::size_t serialize(std::uint8_t* buffer, std::size_t buffer_len,
 	return offset;
 }
 
+template<typename OptionCode,
+		OptionCode... Codes>
+std::size_t serialize(std::uint8_t* buffer, std::size_t buffer_len,
+		type mtype, code mcode, std::uint16_t message_id,
+		void const* const token, std::size_t token_len,
+		Option::option_set_template<OptionCode, Codes...> const& options,
+		void const* const payload, std::size_t payload_len,
+		CoAP::Error& ec) noexcept
+{
+	std::size_t offset = make_header(
+						buffer, buffer_len,
+						mtype, mcode, message_id,
+						token, token_len, ec);
+	if(ec) return offset;
+
+	offset += make_options(buffer + offset, buffer_len - offset, options, ec);
+	if(ec)return offset;
+
+	offset += make_payload(buffer + offset, buffer_len - offset, payload, payload_len, ec);
+	//No need to check ec return value because alredy end of function;
+
+	return offset;
+}
+
 template<typename OptionCode /* = Option::code */,
 		bool SortOptions /* = true */,
 		bool CheckOpOrder /* = !SortOptions */,
@@ -135,6 +159,15 @@ unsigned make_options(std::uint8_t* buffer,
 	return offset;
 }
 
+template<typename OptionCode,
+		OptionCode... Codes>
+unsigned make_options(std::uint8_t* buffer, std::size_t buffer_len,
+		Option::option_set_template<OptionCode, Codes...> const& options,
+		CoAP::Error& ec) noexcept
+{
+	return static_cast<unsigned>(options.serialize(buffer, buffer_len, ec));
+}
+
 template<typename OptionCode /* = Option::code */,
 		bool CheckOpOrder /* = true */,
 		bool CheckOpRepeat /* = true */>
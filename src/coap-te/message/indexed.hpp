@@ -0,0 +1,88 @@
+#ifndef COAP_TE_MESSAGE_INDEXED_HPP__
+#define COAP_TE_MESSAGE_INDEXED_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+
+#include "types.hpp"
+#include "options/template_class.hpp"
+
+namespace CoAP{
+namespace Message{
+
+static constexpr const unsigned default_option_index_size = 16;
+
+/**
+ * Position of a option at the message
+ */
+struct option_entry{
+	std::uint16_t	ocode = 0;
+	std::uint16_t	offset = 0;		///< Offset of the value from 'option_init'
+	std::uint16_t	length = 0;
+};
+
+/**
+ * Indexed message
+ *
+ * The options are indexed while the message is parsed (no other pass over the
+ * options is needed). The first occurrence of a option is found in O(1)
+ * (options with code < 'direct_codes'; the others are searched at the index),
+ * and repeated options are consecutive (options are ordered by code).
+ *
+ * If the message has more than Size options, or a option that doesn't fit at
+ * the entry (code, offset or length > 0xFFFF), the index is not used
+ * ('indexed' false), and the functions fallback to parse the options.
+ *
+ * It can be used wherever a 'message' is expected. Library functions that
+ * receive the message type as template parameter (get_option, query_by_key,
+ * for_each_option, resource search...) use the index.
+ */
+template<unsigned Size = default_option_index_size>
+struct indexed_message : public message{
+	static constexpr const unsigned direct_codes = 64;
+
+	indexed_message();
+
+	option_entry	entries[Size];
+	unsigned		entries_num = 0;
+	bool			indexed = true;
+
+	void clear() noexcept;
+	void clear_index() noexcept;
+	void add(unsigned ocode, std::size_t offset, std::size_t length) noexcept;
+
+	/**
+	 * First occurrence of the option (or nullptr)
+	 */
+	template<typename OptionCode>
+	option_entry const* find(OptionCode) const noexcept;
+	/**
+	 * Next occurrence of the same option (or nullptr)
+	 */
+	option_entry const* next(option_entry const*) const noexcept;
+
+	template<typename OptionCode>
+	unsigned count(OptionCode) const noexcept;
+	template<typename OptionCode>
+	bool get(Option::option_template<OptionCode>&, OptionCode, unsigned count = 0) const noexcept;
+	template<typename OptionCode>
+	void option(option_entry const&, Option::option_template<OptionCode>&) const noexcept;
+	private:
+		using first_t = typename std::conditional<(Size < 0xFF),
+							std::uint8_t, std::uint16_t>::type;
+		first_t			first_[direct_codes];		///< entry index + 1 (0 = not present)
+};
+
+template<typename Message>
+struct is_indexed_message : std::false_type{};
+
+template<unsigned Size>
+struct is_indexed_message<indexed_message<Size>> : std::true_type{};
+
+}//Message
+}//CoAP
+
+#include "impl/indexed_impl.hpp"
+
+#endif /* COAP_TE_MESSAGE_INDEXED_HPP__ */
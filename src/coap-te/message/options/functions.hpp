@@ -17,11 +17,17 @@ bool is_no_cache_key(OptionCode code) noexcept;
 
 #if	COAP_TE_BLOCKWISE_TRANSFER == 1
 
-unsigned block_size(unsigned) noexcept;
+/**
+ * 'reliable': SZX = 7 is BERT (reliable transports), else it's reserved
+ */
+unsigned block_size(unsigned, bool reliable = false) noexcept;
 unsigned block_szx(unsigned value) noexcept;
 bool more(unsigned) noexcept;
 unsigned block_number(unsigned) noexcept;
-unsigned byte_offset(unsigned) noexcept;
+unsigned byte_offset(unsigned, bool reliable = false) noexcept;
+#if COAP_TE_RELIABLE_CONNECTION == 1
+bool is_bert(unsigned) noexcept;
+#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
 
 bool make_block_raw(unsigned& value, unsigned number, bool more, unsigned size) noexcept;
 bool make_block(unsigned& value, unsigned number, bool more, unsigned size) noexcept;
@@ -0,0 +1,259 @@
+#ifndef COAP_TE_MESSAGE_OPTIONS_OPTION_SET_IMPL_HPP__
+#define COAP_TE_MESSAGE_OPTIONS_OPTION_SET_IMPL_HPP__
+
+#include <cstring>
+
+#include "../option_set.hpp"
+#include "../../../internal/helper.hpp"
+
+namespace CoAP{
+namespace Message{
+namespace Option{
+
+template<typename OptionCode,
+		OptionCode... Codes>
+option_set_template<OptionCode, Codes...>::
+option_set_template()
+{
+	static_assert(count > 0, "Option set must have at least one option");
+	static_assert(count <= 0xFF, "Option set max size is 255");
+	static_assert(registered(), "Option not registered");
+	static_assert(!repeated(), "Not repeatable option repeated");
+}
+
+template<typename OptionCode,
+		OptionCode... Codes>
+constexpr OptionCode
+option_set_template<OptionCode, Codes...>::
+code(unsigned index) noexcept
+{
+	return index < count ? codes_[index] : invalid<OptionCode>();
+}
+
+template<typename OptionCode,
+		OptionCode... Codes>
+constexpr bool
+option_set_template<OptionCode, Codes...>::
+registered() noexcept
+{
+	for(unsigned i = 0; i < count; i++)
+		if(!get_config(codes_[i])) return false;
+	return true;
+}
+
+template<typename OptionCode,
+		OptionCode... Codes>
+constexpr bool
+option_set_template<OptionCode, Codes...>::
+repeated() noexcept
+{
+	for(unsigned i = 0; i < count; i++)
+	{
+		config<OptionCode> const* config = get_config(codes_[i]);
+		if(!config || config->repeatable) continue;
+		for(unsigned j = i + 1; j < count; j++)
+			if(codes_[i] == codes_[j]) return true;
+	}
+	return false;
+}
+
+/**
+ * Sorts (stable, so repeated options keep the declaration order) and
+ * calculates the delta of each option header.
+ *
+ * https://tools.ietf.org/html/rfc7252#section-3.1
+ */
+template<typename OptionCode,
+		OptionCode... Codes>
+constexpr typename option_set_template<OptionCode, Codes...>::layout_t
+option_set_template<OptionCode, Codes...>::
+make_layout() noexcept
+{
+	layout_t layout{};
+	for(unsigned i = 0; i < count; i++)
+		layout.header[i].index = static_cast<std::uint8_t>(i);
+
+	for(unsigned i = 1; i < count; i++)
+	{
+		header_t h = layout.header[i];
+		unsigned j = i;
+		for(; j > 0 && codes_[layout.header[j - 1].index] > codes_[h.index]; j--)
+			layout.header[j] = layout.header[j - 1];
+		layout.header[j] = h;
+	}
+
+	unsigned last = 0;
+	for(unsigned i = 0; i < count; i++)
+	{
+		header_t& h = layout.header[i];
+		unsigned ocode = static_cast<unsigned>(codes_[h.index]),
+				delta = ocode - last;
+		last = ocode;
+		if(delta <= 12)
+		{
+			h.delta = static_cast<std::uint8_t>(delta);
+			h.ext_len = 0;
+		}
+		else if(delta <= 268)
+		{
+			h.delta = static_cast<std::uint8_t>(delta_special::one_byte_extend);
+			h.ext[0] = static_cast<std::uint8_t>(delta - 13);
+			h.ext_len = 1;
+		}
+		else
+		{
+			h.delta = static_cast<std::uint8_t>(delta_special::two_byte_extend);
+			h.ext[0] = static_cast<std::uint8_t>((delta - 269) >> 8);
+			h.ext[1] = static_cast<std::uint8_t>(delta - 269);
+			h.ext_len = 2;
+		}
+		layout.size += 1 + h.ext_len;
+	}
+
+	return layout;
+}
+
+template<typename OptionCode,
+		OptionCode... Codes>
+template<unsigned Index>
+option_set_template<OptionCode, Codes...>&
+option_set_template<OptionCode, Codes...>::
+set(char const* value) noexcept
+{
+	static_assert(Index < count, "Option index out of range");
+	static_assert(get_config(codes_[Index])->otype == type::string, "Option must be string");
+
+	values_[Index].value = value;
+	values_[Index].length = static_cast<unsigned>(std::strlen(value));
+
+	return *this;
+}
+
+template<typename OptionCode,
+		OptionCode... Codes>
+template<unsigned Index>
+option_set_template<OptionCode, Codes...>&
+option_set_template<OptionCode, Codes...>::
+set(unsigned& value) noexcept
+{
+	static_assert(Index < count, "Option index out of range");
+	static_assert(get_config(codes_[Index])->otype == type::uint, "Option must be unsigned");
+
+	CoAP::Helper::make_short_unsigned(value, values_[Index].length);
+	values_[Index].value = &value;
+
+	return *this;
+}
+
+template<typename OptionCode,
+		OptionCode... Codes>
+template<unsigned Index>
+option_set_template<OptionCode, Codes...>&
+option_set_template<OptionCode, Codes...>::
+set(void const* value, unsigned length) noexcept
+{
+	static_assert(Index < count, "Option index out of range");
+	static_assert(get_config(codes_[Index])->otype == type::opaque
+				|| get_config(codes_[Index])->otype == type::string,
+				"Option must be opaque or string");
+
+	values_[Index].value = value;
+	values_[Index].length = length;
+
+	return *this;
+}
+
+template<typename OptionCode,
+		OptionCode... Codes>
+template<unsigned Index>
+option_set_template<OptionCode, Codes...>&
+option_set_template<OptionCode, Codes...>::
+set() noexcept
+{
+	static_assert(Index < count, "Option index out of range");
+	static_assert(get_config(codes_[Index])->otype == type::empty, "Option must be empty");
+
+	values_[Index].value = nullptr;
+	values_[Index].length = 0;
+
+	return *this;
+}
+
+template<typename OptionCode,
+		OptionCode... Codes>
+option_template<OptionCode>
+option_set_template<OptionCode, Codes...>::
+get(unsigned index) const noexcept
+{
+	if(index >= count) return option_template<OptionCode>{};
+	return option_template<OptionCode>{codes_[index], values_[index].length, values_[index].value};
+}
+
+template<typename OptionCode,
+		OptionCode... Codes>
+std::size_t
+option_set_template<OptionCode, Codes...>::
+serialized_size() const noexcept
+{
+	std::size_t size = layout_.size;
+	for(unsigned i = 0; i < count; i++)
+	{
+		unsigned length = values_[i].length;
+		size += length + (length <= 12 ? 0 : (length < 269 ? 1 : 2));
+	}
+	return size;
+}
+
+template<typename OptionCode,
+		OptionCode... Codes>
+std::size_t
+option_set_template<OptionCode, Codes...>::
+serialize(std::uint8_t* buffer, std::size_t buffer_len,
+		CoAP::Error& ec) const noexcept
+{
+	if(serialized_size() > buffer_len)
+	{
+		ec = CoAP::errc::insufficient_buffer;
+		return 0;
+	}
+
+	std::size_t offset = 0;
+	for(unsigned i = 0; i < count; i++)
+	{
+		header_t const& h = layout_.header[i];
+		value_t const& v = values_[h.index];
+
+		std::uint8_t* header = buffer + offset++;
+		for(unsigned j = 0; j < h.ext_len; j++)
+			buffer[offset++] = h.ext[j];
+
+		unsigned length = v.length;
+		if(length <= 12)
+			*header = static_cast<std::uint8_t>(h.delta << 4 | length);
+		else if(length < 269)
+		{
+			*header = static_cast<std::uint8_t>(h.delta << 4
+						| static_cast<unsigned>(length_special::one_byte_extend));
+			buffer[offset++] = static_cast<std::uint8_t>(length - 13);
+		}
+		else
+		{
+			*header = static_cast<std::uint8_t>(h.delta << 4
+						| static_cast<unsigned>(length_special::two_byte_extend));
+			CoAP::Helper::interger_to_big_endian_array(buffer + offset,
+					static_cast<std::uint16_t>(length - 269));
+			offset += 2;
+		}
+
+		if(length) std::memcpy(buffer + offset, v.value, length);
+		offset += length;
+	}
+
+	return offset;
+}
+
+}//Option
+}//Message
+}//CoAP
+
+#endif /* COAP_TE_MESSAGE_OPTIONS_OPTION_SET_IMPL_HPP__ */
@@ -206,6 +206,11 @@ bool get_option(Message const& msg,
 		option_template<OptionCode>& opt,
 		OptionCode ocode, unsigned count /* = 0 */) noexcept
 {
+	if constexpr(is_indexed_message<Message>::value)
+	{
+		if(msg.indexed) return msg.get(opt, ocode, count);
+	}
+
 	Parser<OptionCode> parser(msg);
 	option_template<OptionCode> const* op;
 	unsigned c = 0;
@@ -223,6 +228,39 @@ bool get_option(Message const& msg,
 	return false;
 }
 
+template<typename OptionCode,
+		typename Message,
+		typename Func>
+bool for_each_option(Message const& msg,
+		OptionCode ocode, Func&& func) noexcept
+{
+	if constexpr(is_indexed_message<Message>::value)
+	{
+		if(msg.indexed)
+		{
+			option_template<OptionCode> opt;
+			for(option_entry const* e = msg.find(ocode); e; e = msg.next(e))
+			{
+				msg.option(*e, opt);
+				if(!func(static_cast<option_template<OptionCode> const&>(opt))) return false;
+			}
+			return true;
+		}
+	}
+
+	Parser<OptionCode> parser(msg);
+	option_template<OptionCode> const* op;
+	while((op = parser.next()) != nullptr)
+	{
+		if(op->ocode == ocode)
+		{
+			if(!func(*op)) return false;
+		}
+		else if(op->ocode > ocode) break;
+	}
+	return true;
+}
+
 }//Option
 }//Message
 }//CoAP
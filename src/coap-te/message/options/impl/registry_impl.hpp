@@ -0,0 +1,74 @@
+#ifndef COAP_TE_MESSAGE_OPTIONS_REGISTRY_IMPL_HPP__
+#define COAP_TE_MESSAGE_OPTIONS_REGISTRY_IMPL_HPP__
+
+#include "../registry.hpp"
+
+namespace CoAP{
+namespace Message{
+namespace Option{
+
+template<typename OptionCode,
+		unsigned Size,
+		unsigned DenseSize>
+template<typename Array>
+constexpr
+registry<OptionCode, Size, DenseSize>::
+registry(Array const& options) noexcept
+{
+	static_assert(Size > 0, "Registry size must be > 0");
+	static_assert(DenseSize > 0, "Registry dense size must be > 0");
+
+	for(unsigned i = 0; i < Size; i++)
+	{
+		options_[i] = options[i];
+		unsigned ocode = static_cast<unsigned>(options[i].ocode);
+		if(ocode < DenseSize)
+			index_[ocode] = static_cast<index_t>(i + 1);
+		else
+			sparse_ = true;
+	}
+}
+
+template<typename OptionCode,
+		unsigned Size,
+		unsigned DenseSize>
+constexpr typename registry<OptionCode, Size, DenseSize>::config_t const*
+registry<OptionCode, Size, DenseSize>::
+get(OptionCode ocode) const noexcept
+{
+	unsigned code = static_cast<unsigned>(ocode);
+	if(code < DenseSize)
+		return index_[code] ? &options_[index_[code] - 1] : nullptr;
+
+	if(sparse_)
+		for(unsigned i = 0; i < Size; i++)
+			if(options_[i].ocode == ocode)
+				return &options_[i];
+
+	return nullptr;
+}
+
+template<typename OptionCode,
+		typename StandardCode,
+		std::size_t N,
+		std::size_t M>
+constexpr std::array<config<OptionCode>, N + M>
+extend_options(config<StandardCode> const (&standard)[N],
+		config<OptionCode> const (&custom)[M]) noexcept
+{
+	std::array<config<OptionCode>, N + M> options{};
+	for(std::size_t i = 0; i < N; i++)
+		options[i] = config<OptionCode>{static_cast<OptionCode>(standard[i].ocode),
+										standard[i].repeatable,
+										standard[i].otype};
+	for(std::size_t i = 0; i < M; i++)
+		options[N + i] = custom[i];
+
+	return options;
+}
+
+}//Option
+}//Message
+}//CoAP
+
+#endif /* COAP_TE_MESSAGE_OPTIONS_REGISTRY_IMPL_HPP__ */
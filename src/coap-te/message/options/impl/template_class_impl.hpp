@@ -118,7 +118,7 @@ bool option_template<OptionCode>::is_no_cache_key() const noexcept
 }
 
 template<typename OptionCode>
-extern config<OptionCode> const* get_config(OptionCode) noexcept;
+constexpr config<OptionCode> const* get_config(OptionCode) noexcept;
 
 template<typename OptionCode>
 [[maybe_unused]] static bool
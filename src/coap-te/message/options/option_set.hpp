@@ -0,0 +1,112 @@
+#ifndef COAP_TE_MESSAGE_OPTIONS_OPTION_SET_HPP__
+#define COAP_TE_MESSAGE_OPTIONS_OPTION_SET_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../../error.hpp"
+#include "options.hpp"
+
+namespace CoAP{
+namespace Message{
+namespace Option{
+
+/**
+ * Compile time option set
+ *
+ * A fixed set of options: the codes are defined at compile time and the
+ * values at runtime. At compile time, the options are sorted and checked
+ * (registered, not repeated if not repeatable), and the delta of each
+ * option header is computed. Serializing only writes the option
+ * length and copies the values (no sort, no checks).
+ *
+ * The values are set by the index of the code at the template list
+ * (declaration order, not the sorted order). Values must be valid while
+ * serializing (nothing is copied).
+ *
+ * @code
+ * Option::option_set<Option::code::uri_query, Option::code::uri_path> set;
+ * set.set<0>("key=value").set<1>("sensor");
+ * @endcode
+ */
+template<typename OptionCode,
+		OptionCode... Codes>
+class option_set_template{
+	public:
+		static constexpr const unsigned count = sizeof...(Codes);
+
+		option_set_template();
+
+		static constexpr unsigned size() noexcept{ return count; }
+		static constexpr OptionCode code(unsigned index) noexcept;
+
+		/**
+		 * String option
+		 */
+		template<unsigned Index>
+		option_set_template& set(char const*) noexcept;
+		/**
+		 * Unsigned option (the value is changed, as when creating a option)
+		 */
+		template<unsigned Index>
+		option_set_template& set(unsigned&) noexcept;
+		/**
+		 * Opaque (or string) option
+		 */
+		template<unsigned Index>
+		option_set_template& set(void const*, unsigned) noexcept;
+		/**
+		 * Empty option
+		 */
+		template<unsigned Index>
+		option_set_template& set() noexcept;
+
+		option_template<OptionCode> get(unsigned index) const noexcept;
+
+		/**
+		 * Size of the options serialized
+		 */
+		std::size_t serialized_size() const noexcept;
+		std::size_t serialize(std::uint8_t* buffer, std::size_t buffer_len,
+				CoAP::Error&) const noexcept;
+	private:
+		struct value_t{
+			void const*	value = nullptr;
+			unsigned	length = 0;
+		};
+
+		/**
+		 * Header of each option (sorted order), computed at compile time
+		 */
+		struct header_t{
+			std::uint8_t	index = 0;		///< Index of the value
+			std::uint8_t	delta = 0;		///< Delta (header nibble)
+			std::uint8_t	ext[2] = {};	///< Delta extended
+			std::uint8_t	ext_len = 0;
+		};
+
+		struct layout_t{
+			header_t		header[count];
+			std::size_t		size = 0;		///< Size of all the delta headers
+		};
+
+		static constexpr layout_t make_layout() noexcept;
+		static constexpr bool registered() noexcept;
+		static constexpr bool repeated() noexcept;
+
+		static constexpr const OptionCode codes_[count] = {Codes...};
+		static constexpr const layout_t layout_ = make_layout();
+
+		value_t		values_[count];
+};
+
+template<code... Codes>
+using option_set = option_set_template<code, Codes...>;
+
+}//Option
+}//Message
+}//CoAP
+
+#include "impl/option_set_impl.hpp"
+
+#endif /* COAP_TE_MESSAGE_OPTIONS_OPTION_SET_HPP__ */
@@ -24,8 +24,19 @@ void create(option& option,
 
 #if	COAP_TE_BLOCKWISE_TRANSFER == 1
 
-unsigned block_size(unsigned value) noexcept
+/**
+ * BERT (SZX = 7) blocks are counted at 1024 bytes units. The payload is
+ * a multiple of 1024 bytes. Only at reliable transports: at UDP, SZX = 7
+ * is reserved.
+ *
+ * https://tools.ietf.org/html/rfc8323#section-6
+ * https://tools.ietf.org/html/rfc7959#section-2.2
+ */
+unsigned block_size(unsigned value, bool reliable [[maybe_unused]] /* = false */) noexcept
 {
+#if COAP_TE_RELIABLE_CONNECTION == 1
+	if(reliable && is_bert(value)) return 1024;
+#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
 	return CoAP::Helper::pow(2, (value & 0x7) + 4);
 }
 
@@ -44,11 +55,21 @@ unsigned block_number(unsigned value) noexcept
 	return value >> 4;
 }
 
-unsigned byte_offset(unsigned value) noexcept
+unsigned byte_offset(unsigned value, bool reliable [[maybe_unused]] /* = false */) noexcept
 {
+#if COAP_TE_RELIABLE_CONNECTION == 1
+	if(reliable && is_bert(value)) return (value & ~0xF) << 6;
+#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
 	return (value & ~0xF) << (value & 7);
 }
 
+#if COAP_TE_RELIABLE_CONNECTION == 1
+bool is_bert(unsigned value) noexcept
+{
+	return (value & 0x7) == 7;
+}
+#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
+
 bool make_block_raw(unsigned& value, unsigned number, bool more, unsigned size) noexcept
 {
 #if COAP_TE_RELIABLE_CONNECTION == 1
@@ -74,6 +95,11 @@ bool make_block(unsigned& value, unsigned number, bool more, unsigned size) noex
 		if(size == 1) break;
 	}
 
+	/**
+	 * SZX = 7 is not a size (reserved/BERT). Use 'make_block_raw'
+	 */
+	if(n_size < 4 || n_size > 10) return false;
+
 	return make_block_raw(value, number, more, n_size - 4);
 }
 
@@ -10,6 +10,7 @@
 #include "functions.hpp"
 #include "types.hpp"
 #include "list.hpp"
+#include "registry.hpp"
 
 namespace CoAP{
 namespace Message{
@@ -34,18 +35,27 @@ enum class code {
 	hop_limit		= 16,	//Hop-Limit
 #endif /* COAP_TE_OPTION_HOP_LIMIT == 1 */
 	accept			= 17,	//Accept
+#if COAP_TE_Q_BLOCK == 1
+	q_block1		= 19,	//Q-Block1
+#endif /* COAP_TE_Q_BLOCK == 1 */
 	location_query	= 20,	//Location-Query
 #if	COAP_TE_BLOCKWISE_TRANSFER == 1
 	block2			= 23,	//Block2
 	block1			= 27,	//Block1
 	size2			= 28,	//Size2
 #endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+#if COAP_TE_Q_BLOCK == 1
+	q_block2		= 31,	//Q-Block2
+#endif /* COAP_TE_Q_BLOCK == 1 */
 	proxy_uri		= 35,	//Proxy-Uri
 	proxy_scheme	= 39,	//Proxy-Scheme
 	size1			= 60,	//Size1
 #if COAP_TE_OPTION_NO_RESPONSE == 1
-	no_response		= 258	//No response
+	no_response		= 258,	//No response
 #endif /* COAP_TE_OPTION_NO_RESPONSE == 1 */
+#if	COAP_TE_BLOCKWISE_TRANSFER == 1
+	request_tag		= 292,	//Request-Tag (RFC9175)
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
 };
 
 static constexpr const config<code> options[] = {
@@ -66,18 +76,34 @@ static constexpr const config<code> options[] = {
 	{code::hop_limit,		false,	type::uint},
 #endif /* COAP_TE_OPTION_HOP_LIMIT == 1 */
 	{code::accept, 			false, 	type::uint},
+#if COAP_TE_Q_BLOCK == 1
+	{code::q_block1,		false,	type::uint},
+#endif /* COAP_TE_Q_BLOCK == 1 */
 	{code::location_query, 	true, 	type::string},
 #if	COAP_TE_BLOCKWISE_TRANSFER == 1
 	{code::block2,			false,	type::uint},
 	{code::block1,			false,	type::uint},
 	{code::size2,			false,	type::uint},
 #endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+#if COAP_TE_Q_BLOCK == 1
+	{code::q_block2,		true,	type::uint},
+#endif /* COAP_TE_Q_BLOCK == 1 */
 	{code::proxy_uri, 		false, 	type::string},
 	{code::proxy_scheme, 	false, 	type::string},
 	{code::size1, 			false, 	type::uint},
 #if COAP_TE_OPTION_NO_RESPONSE == 1
-	{code::no_response,		false,	type::uint}
+	{code::no_response,		false,	type::uint},
 #endif /* COAP_TE_OPTION_NO_RESPONSE == 1 */
+#if	COAP_TE_BLOCKWISE_TRANSFER == 1
+	{code::request_tag,		true,	type::opaque},
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+};
+
+template<>
+struct option_registry<code>{
+	static constexpr const registry<code,
+			std::size(options),
+			registry_dense_size(options)> table{options};
 };
 
 using option = option_template<code>;
@@ -99,6 +125,13 @@ static constexpr const config<csm> options_csm[] = {
 	{csm::block_wise_transfer,	false,	type::empty}
 };
 
+template<>
+struct option_registry<csm>{
+	static constexpr const registry<csm,
+			std::size(options_csm),
+			registry_dense_size(options_csm)> table{options_csm};
+};
+
 using option_csm = option_template<csm>;
 using node_csm = node_option<csm>;
 
@@ -110,6 +143,13 @@ static constexpr const config<ping_pong> options_ping_pong[] = {
 	{ping_pong::custody, 		false,	type::empty}
 };
 
+template<>
+struct option_registry<ping_pong>{
+	static constexpr const registry<ping_pong,
+			std::size(options_ping_pong),
+			registry_dense_size(options_ping_pong)> table{options_ping_pong};
+};
+
 using option_ping = option_template<ping_pong>;
 using node_ping = node_option<ping_pong>;
 using option_pong = option_template<ping_pong>;
@@ -125,6 +165,13 @@ static constexpr const config<release> options_release[] = {
 	{release::hold_off,				false,	type::uint}
 };
 
+template<>
+struct option_registry<release>{
+	static constexpr const registry<release,
+			std::size(options_release),
+			registry_dense_size(options_release)> table{options_release};
+};
+
 using option_release = option_template<release>;
 using node_release = node_option<release>;
 
@@ -136,47 +183,26 @@ static constexpr const config<abort> options_abort[] = {
 	{abort::bad_csm_option,		false,	type::uint}
 };
 
+template<>
+struct option_registry<abort>{
+	static constexpr const registry<abort,
+			std::size(options_abort),
+			registry_dense_size(options_abort)> table{options_abort};
+};
+
 using option_abort = option_template<abort>;
 using node_abort = node_option<abort>;
 
 #endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
 
+/**
+ * Option configuration (nullptr if the option code is not registered).
+ * See 'option_registry'.
+ */
 template<typename OptionCode>
-config<OptionCode> const * get_config(OptionCode ocode) noexcept
+constexpr config<OptionCode> const * get_config(OptionCode ocode) noexcept
 {
-	if constexpr(std::is_same<OptionCode, code>::value)
-	{
-		for(unsigned i = 0; i < sizeof(options) / sizeof(config<code>); i++)
-			if(ocode == options[i].ocode)
-				return &options[i];
-	}
-#if COAP_TE_RELIABLE_CONNECTION == 1
-	else if constexpr(std::is_same<OptionCode, csm>::value)
-	{
-		for(unsigned i = 0; i < sizeof(options_csm) / sizeof(config<csm>); i++)
-			if(ocode == options_csm[i].ocode)
-				return &options_csm[i];
-	}
-	else if constexpr(std::is_same<OptionCode, ping_pong>::value)
-	{
-		for(unsigned i = 0; i < sizeof(options_ping_pong) / sizeof(config<ping_pong>); i++)
-			if(ocode == options_ping_pong[i].ocode)
-				return &options_ping_pong[i];
-	}
-	else if constexpr(std::is_same<OptionCode, release>::value)
-	{
-		for(unsigned i = 0; i < sizeof(options_release) / sizeof(config<release>); i++)
-			if(ocode == options_release[i].ocode)
-				return &options_release[i];
-	}
-	else if constexpr(std::is_same<OptionCode, abort>::value)
-	{
-		for(unsigned i = 0; i < sizeof(options_abort) / sizeof(config<abort>); i++)
-			if(ocode == options_abort[i].ocode)
-				return &options_abort[i];
-	}
-#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
-	return nullptr;
+	return option_registry<OptionCode>::table.get(ocode);
 }
 
 }//Option
@@ -4,6 +4,7 @@
 #include "../types.hpp"
 #include "../../error.hpp"
 #include "template_class.hpp"
+#include "../indexed.hpp"
 
 namespace CoAP{
 namespace Message{
@@ -51,6 +52,16 @@ bool get_option(Message const& msg,
 		option_template<OptionCode>& opt,
 		OptionCode ocode, unsigned count = 0) noexcept;
 
+/**
+ * Calls 'func(option const&)' to each option 'ocode' of the message, until
+ * it returns false. Returns false if interrupted.
+ */
+template<typename OptionCode,
+		typename Message,
+		typename Func>
+bool for_each_option(Message const& msg,
+		OptionCode ocode, Func&& func) noexcept;
+
 }//Option
 }//Message
 }//CoAP
@@ -0,0 +1,117 @@
+#ifndef COAP_TE_MESSAGE_OPTIONS_REGISTRY_HPP__
+#define COAP_TE_MESSAGE_OPTIONS_REGISTRY_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+#include <array>
+#include <iterator>
+#include <type_traits>
+
+#include "types.hpp"
+
+namespace CoAP{
+namespace Message{
+namespace Option{
+
+/**
+ * Max option code that is searched by the dense table. Options with codes
+ * above (as the experimental range, 65000-65535) are searched linearly.
+ */
+static constexpr const unsigned registry_max_dense_code = 511;
+
+template<typename Array>
+constexpr unsigned max_code(Array const& options) noexcept
+{
+	unsigned max = 0;
+	for(std::size_t i = 0; i < std::size(options); i++)
+		if(static_cast<unsigned>(options[i].ocode) > max)
+			max = static_cast<unsigned>(options[i].ocode);
+	return max;
+}
+
+/**
+ * Dense table size of a option list
+ */
+template<typename Array>
+constexpr unsigned registry_dense_size(Array const& options) noexcept
+{
+	unsigned max = max_code(options);
+	return (max < registry_max_dense_code ? max : registry_max_dense_code) + 1;
+}
+
+/**
+ * Option registry
+ *
+ * Configuration (repeatable/type) of the options of a option code enum,
+ * with a dense table (built at compile time) indexed by the option code.
+ * So, 'get_config' doesn't search the options list.
+ *
+ * The option list is copied (so the registry doesn't depend of the list
+ * linkage). The codes must be unique. DenseSize is the size of the table (codes
+ * greater or equal are searched linearly).
+ */
+template<typename OptionCode,
+		unsigned Size,
+		unsigned DenseSize>
+class registry{
+	public:
+		using config_t = config<OptionCode>;
+
+		template<typename Array>
+		constexpr registry(Array const& options) noexcept;
+
+		constexpr config_t const* get(OptionCode) const noexcept;
+
+		constexpr unsigned size() const noexcept{ return Size; }
+		constexpr config_t const* options() const noexcept{ return options_; }
+	private:
+		using index_t = typename std::conditional<(Size < 0xFF),
+							std::uint8_t, std::uint16_t>::type;
+
+		config_t			options_[Size] = {};
+		index_t				index_[DenseSize] = {};	///< index + 1 (0 = invalid)
+		bool				sparse_ = false;
+};
+
+/**
+ * Option registry of the option code enum. Must define a static 'table'
+ * member (a 'registry'). To define your own options (as vendor specific),
+ * declare a option code enum with a option list, and specialize:
+ *
+ * @code
+ * namespace CoAP{ namespace Message{ namespace Option{
+ * template<>
+ * struct option_registry<my_code>{
+ * 	static constexpr const registry<my_code,
+ * 			std::size(my_options),
+ * 			registry_dense_size(my_options)> table{my_options};
+ * };
+ * }}}
+ * @endcode
+ *
+ * The option code enum is the 'OptionCode' template parameter of the parse/serialize
+ * functions (Option::parse, Option::Parser, make_options...). The standard
+ * options can be included at your list with 'extend_options'.
+ */
+template<typename OptionCode>
+struct option_registry;
+
+/**
+ * Concatenate the standard options (converted to the new option code) and
+ * the custom options
+ */
+template<typename OptionCode,
+		typename StandardCode,
+		std::size_t N,
+		std::size_t M>
+constexpr std::array<config<OptionCode>, N + M>
+extend_options(config<StandardCode> const (&standard)[N],
+		config<OptionCode> const (&custom)[M]) noexcept;
+
+}//Option
+}//Message
+}//CoAP
+
+#include "impl/registry_impl.hpp"
+
+#endif /* COAP_TE_MESSAGE_OPTIONS_REGISTRY_HPP__ */
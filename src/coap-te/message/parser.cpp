@@ -13,11 +13,7 @@ unsigned parse(message& msg,
 	if(ec || (buffer_len - offset) == 0)
 		return offset;
 
-	offset += parse_options(msg, buffer + offset, buffer_len - offset, ec);
-	if(ec || (buffer_len - offset) == 0)
-		return offset;
-
-	offset += parse_payload(msg, buffer + offset, buffer_len - offset, ec);
+	offset += parse_body(msg, buffer + offset, buffer_len - offset, ec);
 
 	return offset;
 }
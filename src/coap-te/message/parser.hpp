@@ -3,6 +3,7 @@
 
 #include "../error.hpp"
 #include "types.hpp"
+#include "indexed.hpp"
 #include "options/options.hpp"
 
 namespace CoAP{
@@ -24,10 +25,28 @@ unsigned parse_payload(Message& msg,
 		std::uint8_t const* const buffer, std::size_t buffer_len,
 		CoAP::Error& ec) noexcept;
 
+/**
+ * Parse the options and the payload (buffer must point after the header/token,
+ * i.e., the offset returned by 'parse_header'). Splitting the parse allows to
+ * check the header (as match a transaction) before decode the options.
+ */
+template<typename Message>
+unsigned parse_body(Message& msg,
+		std::uint8_t const* const buffer, std::size_t buffer_len,
+		CoAP::Error& ec) noexcept;
+
 unsigned parse(message& msg,
 		std::uint8_t const* const buffer, std::size_t buffer_len,
 		CoAP::Error&) noexcept;
 
+/**
+ * Parse indexing the options (see 'indexed_message')
+ */
+template<unsigned Size>
+unsigned parse(indexed_message<Size>& msg,
+		std::uint8_t const* const buffer, std::size_t buffer_len,
+		CoAP::Error&) noexcept;
+
 template<typename Message>
 bool query_by_key(Message const& msg,
 		const char* key, const void** value,
@@ -29,6 +29,7 @@ class Factory{
 		Factory& token(const char*) noexcept;
 
 		Factory& add_option(CoAP::Message::Option::node_option<OptionCode>&) noexcept;
+		Factory& remove_option(CoAP::Message::Option::node_option<OptionCode>&) noexcept;
 
 		Factory& payload(void const*, std::size_t) noexcept;
 		Factory& payload(const char*) noexcept;
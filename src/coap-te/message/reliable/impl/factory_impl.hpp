@@ -60,6 +60,17 @@ add_option(Option::node_option<OptionCode>& node) noexcept
 	return *this;
 }
 
+template<std::size_t BufferSize,
+	CoAP::Message::code Code>
+Factory<BufferSize, Code>&
+Factory<BufferSize, Code>::
+remove_option(Option::node_option<OptionCode>& node) noexcept
+{
+	opt_list_.remove(node);
+
+	return *this;
+}
+
 template<std::size_t BufferSize,
 	CoAP::Message::code Code>
 Factory<BufferSize, Code>&
@@ -69,6 +69,41 @@ unsigned parse_header(message& msg,
 	return offset;
 }
 
+std::size_t message_size(std::uint8_t const* const buffer, std::size_t buffer_len) noexcept
+{
+	if(buffer_len < 1) return 0;
+
+	unsigned shift = 0, len = 0;
+	extend_length length = static_cast<extend_length>(buffer[0] >> 4);
+	if(length == extend_length::one_byte)
+	{
+		shift = 1;
+		len = 13;
+	}
+	else if(length == extend_length::two_bytes)
+	{
+		shift = 2;
+		len = 269;
+	}
+	else if(length == extend_length::three_bytes)
+	{
+		shift = 3;
+		len = 65805;
+	}
+	else
+		len = static_cast<unsigned>(length);
+
+	if(buffer_len < 1 + shift) return 0;
+	if(shift)
+	{
+		unsigned value = 0;
+		CoAP::Helper::array_to_unsigned(&buffer[1], shift, value);
+		len += value;
+	}
+
+	return 1 /* length */ + shift + 1 /* code */ + (buffer[0] & 0x0F) /* token */ + len;
+}
+
 static unsigned parse_option_choose(message& msg,
 		std::uint8_t const* const buffer, std::size_t buffer_len,
 		CoAP::Error& ec) noexcept
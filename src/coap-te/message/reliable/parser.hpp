@@ -18,6 +18,17 @@ unsigned parse(message& msg,
 		std::uint8_t const* const buffer, std::size_t buffer_len,
 		CoAP::Error&) noexcept;
 
+/**
+ * Size of the message at the beginning of the buffer (length, token,
+ * code, options and payload), read from the length field. Returns 0
+ * if the buffer doesn't have the whole length field yet.
+ *
+ * Used to split a stream of messages.
+ *
+ * https://tools.ietf.org/html/rfc8323#section-3.2
+ */
+std::size_t message_size(std::uint8_t const* const buffer, std::size_t buffer_len) noexcept;
+
 }//Reliable
 }//Message
 }//CoAP
@@ -81,7 +81,7 @@ std::size_t set_message_length(std::uint8_t* buffer,
 	buffer[0] |= (opt_len != extend_length::normal ? (static_cast<std::uint8_t>(opt_len) << 4) : (size << 4));
 	if(shift)
 	{
-		CoAP::Helper::shift_right(buffer + shift, buffer_used - 1, shift);
+		CoAP::Helper::shift_right(buffer + 1, buffer_used - 1, shift);
 		CoAP::Helper::interger_to_big_endian_array(&buffer[1], size, shift);
 	}
 
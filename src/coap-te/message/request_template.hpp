@@ -0,0 +1,85 @@
+#ifndef COAP_TE_MESSAGE_REQUEST_TEMPLATE_HPP__
+#define COAP_TE_MESSAGE_REQUEST_TEMPLATE_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../error.hpp"
+#include "types.hpp"
+#include "codes.hpp"
+#include "factory.hpp"
+#include "options/options.hpp"
+
+namespace CoAP{
+namespace Message{
+
+/**
+ * Pre-serialized request
+ *
+ * The message is serialized once (from a factory or a serialized buffer),
+ * and the offsets of the message id, token, marked option values and
+ * payload are saved. Serializing is just a copy, patching the message id.
+ *
+ * Values changed are patched at the template buffer (so, are copied):
+ * * token and marked options: must keep the same length;
+ * * payload: any length (limited to MaxSize).
+ *
+ * MaxSize is the size of the message buffer, and MaxRegions the max number
+ * of options marked.
+ */
+template<std::size_t MaxSize,
+		unsigned MaxRegions = 4>
+class request_template{
+	public:
+		request_template();
+
+		template<bool SortOptions = true,
+				bool CheckOpOrder = !SortOptions,
+				bool CheckOpRepeat = true,
+				std::size_t BufferSize,
+				typename MessageID>
+		std::size_t build(Factory<BufferSize, MessageID> const&, CoAP::Error&) noexcept;
+		/**
+		 * From a serialized message (the message id is ignored)
+		 */
+		std::size_t build(std::uint8_t const* buffer, std::size_t size, CoAP::Error&) noexcept;
+		void clear() noexcept;
+
+		/**
+		 * Marks the value of a option as variable ('count' is the option number
+		 * of the same code, begining at 0). Returns the region index (to use
+		 * with 'value'), or -1 if not found or no space to mark.
+		 */
+		int mark(Option::code, unsigned count = 0) noexcept;
+
+		bool token(void const*, std::size_t) noexcept;
+		bool value(unsigned region, void const*, std::size_t) noexcept;
+		bool payload(void const*, std::size_t) noexcept;
+
+		CoAP::Message::type type() const noexcept;
+		CoAP::Message::code code() const noexcept;
+		std::uint8_t const* buffer() const noexcept;
+		std::size_t size() const noexcept;
+		unsigned regions() const noexcept;
+
+		std::size_t serialize(std::uint8_t* buffer, std::size_t buffer_len,
+				std::uint16_t mid, CoAP::Error&) const noexcept;
+	private:
+		struct region{
+			std::size_t		offset = 0;
+			std::size_t		length = 0;
+		};
+
+		std::uint8_t	buffer_[MaxSize];
+		std::size_t		size_ = 0;
+		std::size_t		payload_offset_ = 0;	///< Payload marker (= size_, if no payload)
+		region			regions_[MaxRegions];
+		unsigned		regions_num_ = 0;
+};
+
+}//Message
+}//CoAP
+
+#include "impl/request_template_impl.hpp"
+
+#endif /* COAP_TE_MESSAGE_REQUEST_TEMPLATE_HPP__ */
@@ -9,6 +9,7 @@
 #include "types.hpp"
 #include "codes.hpp"
 #include "options/options.hpp"
+#include "options/option_set.hpp"
 
 namespace CoAP{
 namespace Message{
@@ -43,6 +44,15 @@ unsigned make_option(std::uint8_t* buffer, std::size_t buffer_len,
 		OptionCode& last_option,
 		CoAP::Error& ec) noexcept;
 
+/**
+ * Option set: already sorted and checked at compile time
+ */
+template<typename OptionCode,
+		OptionCode... Codes>
+unsigned make_options(std::uint8_t* buffer, std::size_t buffer_len,
+		Option::option_set_template<OptionCode, Codes...> const&,
+		CoAP::Error& ec) noexcept;
+
 unsigned make_payload(uint8_t* buffer, std::size_t buffer_len,
 		void const* const payload, std::size_t payload_len,
 		CoAP::Error& ec) noexcept;
@@ -80,6 +90,15 @@ std::size_t serialize(std::uint8_t* buffer, std::size_t buffer_len,
 		void const* const payload, std::size_t payload_len,
 		CoAP::Error& ec) noexcept;
 
+template<typename OptionCode,
+		OptionCode... Codes>
+std::size_t serialize(std::uint8_t* buffer, std::size_t buffer_len,
+		type mtype, code mcode, std::uint16_t message_id,
+		void const* const token, std::size_t token_len,
+		Option::option_set_template<OptionCode, Codes...> const&,
+		void const* const payload, std::size_t payload_len,
+		CoAP::Error& ec) noexcept;
+
 class Serialize{
 	public:
 		Serialize(std::uint8_t* buffer, std::size_t buffer_size);
@@ -0,0 +1,433 @@
+#ifndef COAP_TE_OBSERVE_NOTIFIER_IMPL_HPP__
+#define COAP_TE_OBSERVE_NOTIFIER_IMPL_HPP__
+
+#include <cstring>
+
+#include "../notifier.hpp"
+#include "../../log.hpp"
+#include "../../message/serialize.hpp"
+#include "../../transmission/functions.hpp"
+
+namespace CoAP{
+namespace Observe{
+
+static constexpr CoAP::Log::module notifier_mod = {
+		/*.name = */"NOTIFY",
+		/*.max_level = */CoAP::Log::type::debug,
+		/*.enable = */true
+};
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+notifier()
+{
+	static_assert(Slots > 0, "Notifier must have at least one slot");
+	static_assert(MaxPending > 0, "Notifier pending list size must be > 0");
+	init();
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+notifier(CoAP::Transmission::configure const& config)
+	: config_(config)
+{
+	static_assert(Slots > 0, "Notifier must have at least one slot");
+	static_assert(MaxPending > 0, "Notifier pending list size must be > 0");
+	init();
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+void
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+init() noexcept
+{
+	for(unsigned i = 0; i < buckets(); i++)
+		mid_head_[i] = npos;
+	for(unsigned i = 0; i < MaxPending; i++)
+	{
+		mid_next_[i] = npos;
+		free_[i] = MaxPending - 1 - i;
+	}
+	free_count_ = MaxPending;
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+void
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+callback(notify_cb_t cb, void* data /* = nullptr */) noexcept
+{
+	cb_ = cb;
+	data_ = data;
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+bool
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+set(CoAP::Message::type mtype, CoAP::Message::code mcode,
+		CoAP::Message::Option::List& options,
+		void const* payload, std::size_t payload_len,
+		CoAP::Error& ec) noexcept
+{
+	using namespace CoAP::Message;
+
+	/**
+	 * Slots still referenced by pending notifications can't be overwritten
+	 */
+	unsigned index = Slots;
+	for(unsigned i = 0; i < Slots; i++)
+	{
+		if(slots_[i].refs == 0)
+		{
+			index = i;
+			break;
+		}
+	}
+	if(index == Slots)
+	{
+		debug(notifier_mod, "No free slot to serialize notification");
+		ec = CoAP::errc::no_free_slots;
+		return false;
+	}
+
+	slot_t& slot = slots_[index];
+	std::uint8_t* buffer = slot.buffer + header_reserve;
+
+	std::size_t size = make_options(buffer, MaxPacketSize, options.head(), ec);
+	if(ec) return false;
+	size += make_payload(buffer + size, MaxPacketSize - size, payload, payload_len, ec);
+	if(ec) return false;
+
+	slot.mtype = mtype;
+	slot.mcode = mcode;
+	slot.size = size;
+	current_ = index;
+
+	return true;
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+std::uint8_t*
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+make(slot_t& slot, CoAP::Message::type mtype,
+		std::uint16_t mid,
+		void const* token, std::size_t token_len,
+		CoAP::Error& ec) noexcept
+{
+	if(token_len > 8)
+	{
+		ec = CoAP::errc::invalid_token_length;
+		return nullptr;
+	}
+
+	/**
+	 * Header and token are written just before the options
+	 */
+	std::uint8_t* header = slot.buffer + header_reserve - 4 - token_len;
+	CoAP::Message::make_header(header, 4 + token_len,
+						mtype, slot.mcode, mid,
+						token, token_len, ec);
+
+	return ec ? nullptr : header;
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+template<typename Engine>
+bool
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+send(Engine& engine, Endpoint const& ep,
+		void const* token, std::size_t token_len,
+		CoAP::Error& ec) noexcept
+{
+	if(current_ >= Slots)
+	{
+		ec = CoAP::errc::buffer_empty;
+		return false;
+	}
+	return send(engine, ep, token, token_len, slots_[current_].mtype, ec);
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+template<typename Engine>
+bool
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+send(Engine& engine, Endpoint const& ep,
+		void const* token, std::size_t token_len,
+		CoAP::Message::type mtype,
+		CoAP::Error& ec) noexcept
+{
+	using namespace CoAP::Message;
+
+	if(current_ >= Slots)
+	{
+		ec = CoAP::errc::buffer_empty;
+		return false;
+	}
+	slot_t& slot = slots_[current_];
+
+	if(mtype == type::confirmable && free_count_ == 0)
+	{
+		debug(notifier_mod, "Pending list full, notification not sent");
+		ec = CoAP::errc::no_free_slots;
+		return false;
+	}
+
+	std::uint16_t mid = engine.mid();
+	std::uint8_t* buffer = make(slot, mtype, mid, token, token_len, ec);
+	if(!buffer) return false;
+
+	Endpoint to = ep;
+	engine.send(to, buffer, 4 + token_len + slot.size, ec);
+	if(ec) return false;
+
+	if(mtype == type::confirmable)
+	{
+		unsigned index = free_[--free_count_];
+		pending_t* p = &pending_[index];
+		p->used = true;
+		p->ep = ep;
+		p->mid = mid;
+		std::memcpy(p->token, token, token_len);
+		p->token_len = token_len;
+		p->slot = current_;
+		p->retransmission_remaining = config_.max_restransmission;
+		p->expiration_factor = CoAP::Transmission::expiration_timeout(config_);
+		p->next_expiration = CoAP::time()
+				+ static_cast<CoAP::time_t>(p->expiration_factor * 1000);
+		slot.refs++;
+
+		unsigned b = mid & (buckets() - 1);
+		mid_next_[index] = mid_head_[b];
+		mid_head_[b] = index;
+	}
+
+	return true;
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+template<typename Engine,
+		typename List>
+unsigned
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+notify(Engine& engine, List& list,
+		CoAP::Message::type mtype, CoAP::Message::code mcode,
+		CoAP::Message::Option::List& options,
+		void const* payload, std::size_t payload_len,
+		CoAP::Error& ec) noexcept
+{
+	if(mtype == CoAP::Message::type::confirmable)
+	{
+		unsigned observers = 0;
+		for(unsigned i = 0; i < list.size(); i++)
+		{
+			auto* obs = list[i];
+			if(obs && obs->is_used()) observers++;
+		}
+		if(observers > free_count_)
+		{
+			debug(notifier_mod, "No room to %u confirmable notifications [%u]",
+					observers, free_count_);
+			ec = CoAP::errc::no_free_slots;
+			return 0;
+		}
+	}
+
+	if(!set(mtype, mcode, options, payload, payload_len, ec))
+		return 0;
+
+	unsigned count = 0;
+	for(unsigned i = 0; i < list.size(); i++)
+	{
+		auto* obs = list[i];
+		if(!obs || !obs->is_used()) continue;
+
+		CoAP::Error ecs;
+		if(send(engine, obs->endpoint(), obs->token(), obs->token_len(), ecs))
+			count++;
+		else
+			ec = ecs;
+	}
+
+	debug(notifier_mod, "Notification sent to %u observers", count);
+	return count;
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+template<typename Engine,
+		typename List>
+unsigned
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+notify_scheduled(Engine& engine, List& list,
+		CoAP::Message::code mcode,
+		CoAP::Message::Option::List& options,
+		void const* payload, std::size_t payload_len,
+		CoAP::Error& ec) noexcept
+{
+	CoAP::time_t now = CoAP::time();
+	bool serialized = false;
+	unsigned count = 0;
+	for(unsigned i = 0; i < list.size(); i++)
+	{
+		auto* obs = list[i];
+		if(!obs || !obs->is_used()) continue;
+
+		/**
+		 * The scheduler is only committed after the notification is sent: if
+		 * it can't be serialized/sent, it stays due to the next call
+		 */
+		CoAP::Message::type mtype;
+		if(!obs->scheduler().due(now, mtype)) continue;
+
+		if(!serialized)
+		{
+			if(!set(mtype, mcode, options, payload, payload_len, ec))
+				return 0;
+			serialized = true;
+		}
+
+		CoAP::Error ecs;
+		if(send(engine, obs->endpoint(), obs->token(), obs->token_len(), mtype, ecs))
+		{
+			obs->scheduler().commit(now);
+			count++;
+		}
+		else
+			ec = ecs;
+	}
+
+	if(count) debug(notifier_mod, "Scheduled notification sent to %u observers", count);
+	return count;
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+template<typename Message>
+bool
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+response(Endpoint const& ep, Message const& msg) noexcept
+{
+	using namespace CoAP::Message;
+
+	if(msg.mtype != type::acknowledgment && msg.mtype != type::reset)
+		return false;
+
+	for(unsigned i = mid_head_[msg.mid & (buckets() - 1)]; i != npos; i = mid_next_[i])
+	{
+		pending_t& p = pending_[i];
+		if(p.mid != msg.mid || !(p.ep == ep))
+			continue;
+
+		release(i, msg.mtype == type::reset ?
+						notify_status::reset :
+						notify_status::acknowledged);
+		return true;
+	}
+	return false;
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+template<typename Engine>
+void
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+check(Engine& engine) noexcept
+{
+	CoAP::time_t now = CoAP::time();
+	for(unsigned i = 0; i < MaxPending; i++)
+	{
+		pending_t& p = pending_[i];
+		if(!p.used || now < p.next_expiration) continue;
+
+		if(p.retransmission_remaining == 0)
+		{
+			status(notifier_mod, "[%04X] Notification timeout", p.mid);
+			release(i, notify_status::timeout);
+			continue;
+		}
+
+		p.retransmission_remaining--;
+		p.expiration_factor *= 2;
+		p.next_expiration = now + static_cast<CoAP::time_t>(p.expiration_factor * 1000);
+
+		CoAP::Error ec;
+		slot_t& slot = slots_[p.slot];
+		std::uint8_t* buffer = make(slot, CoAP::Message::type::confirmable,
+							p.mid, p.token, p.token_len, ec);
+		if(!buffer) continue;
+
+		debug(notifier_mod, "[%04X] Retransmitting notification [%u]",
+				p.mid, p.retransmission_remaining);
+		engine.send(p.ep, buffer, 4 + p.token_len + slot.size, ec);
+	}
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+unsigned
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+pending() const noexcept
+{
+	return MaxPending - free_count_;
+}
+
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending,
+		unsigned Slots>
+void
+notifier<Endpoint, MaxPacketSize, MaxPending, Slots>::
+release(unsigned index, notify_status nstatus) noexcept
+{
+	pending_t& p = pending_[index];
+
+	unsigned* link = &mid_head_[p.mid & (buckets() - 1)];
+	while(*link != npos && *link != index) link = &mid_next_[*link];
+	if(*link == index) *link = mid_next_[index];
+	mid_next_[index] = npos;
+	free_[free_count_++] = index;
+
+	p.used = false;
+	slots_[p.slot].refs--;
+
+	if(cb_) cb_(p.ep, p.token, p.token_len, nstatus, data_);
+}
+
+}//Observe
+}//CoAP
+
+#endif /* COAP_TE_OBSERVE_NOTIFIER_IMPL_HPP__ */
@@ -0,0 +1,288 @@
+#ifndef COAP_TE_OBSERVE_REGISTRY_IMPL_HPP__
+#define COAP_TE_OBSERVE_REGISTRY_IMPL_HPP__
+
+#include <utility>
+
+#include "../registry.hpp"
+#include "../functions.hpp"
+
+namespace CoAP{
+namespace Observe{
+
+template<typename Endpoint, typename = void>
+struct endpoint_has_address : std::false_type{};
+
+template<typename Endpoint>
+struct endpoint_has_address<Endpoint,
+	std::void_t<decltype(std::declval<Endpoint&>().address())>> : std::true_type{};
+
+template<typename Endpoint>
+std::uint32_t
+endpoint_hash<Endpoint>::operator()(Endpoint const& ep) const noexcept
+{
+	std::uint16_t port = ep.port();
+	std::uint32_t h = CoAP::Cache::hash(&port, sizeof(port));
+	if constexpr(endpoint_has_address<Endpoint>::value)
+	{
+		/**
+		 * Some endpoint types don't have a const 'address' method
+		 */
+		Endpoint copy(ep);
+		auto addr = copy.address();
+		h = CoAP::Cache::hash(&addr, sizeof(addr), h);
+	}
+	return h;
+}
+
+/**
+ * Used to search/remove by token
+ */
+struct token_view{
+	void const*		token;
+	std::size_t		token_len;
+};
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+registry<Observe, Size, Hash>::registry()
+{
+	static_assert(Size > 0, "Registry size (capacity) must be > 0");
+
+	for(unsigned i = 0; i < Size; i++)
+	{
+		dense_[i] = i;
+		pos_[i] = i;
+	}
+	for(unsigned i = 0; i < buckets(); i++)
+	{
+		key_head_[i] = npos;
+		ep_head_[i] = npos;
+	}
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+unsigned
+registry<Observe, Size, Hash>::size() const noexcept
+{
+	return count_;
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+template<typename Message>
+std::uint32_t
+registry<Observe, Size, Hash>::
+key_hash(std::uint32_t ep_hash, Message const& msg) noexcept
+{
+	return CoAP::Cache::hash(msg.token, msg.token_len, ep_hash);
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+template<typename Message>
+unsigned
+registry<Observe, Size, Hash>::
+find_index(endpoint const& ep, Message const& msg, std::uint32_t key) const noexcept
+{
+	for(unsigned i = key_head_[key & (buckets() - 1)]; i != npos; i = key_next_[i])
+		if(key_[i] == key && list_[i].check(ep, msg))
+			return i;
+
+	return npos;
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+template<typename Message,
+		typename ...Args>
+bool registry<Observe, Size, Hash>::
+process(endpoint const& ep, Message const& msg, Args&& ...args) noexcept
+{
+	message_status status = process_message(msg);
+
+	if(status == message_status::register_) return add(ep, msg, std::forward<Args>(args)...);
+	else if(status == message_status::deregister)
+	{
+			remove(ep, msg);
+			return false;
+	}
+	return false;
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+template<typename Message,
+		typename ...Args>
+bool registry<Observe, Size, Hash>::
+add(endpoint const& ep, Message const& msg, Args&& ...args) noexcept
+{
+	std::uint32_t eh = hash_(ep),
+			key = key_hash(eh, msg);
+
+	unsigned index = find_index(ep, msg, key);
+	if(index != npos)
+	{
+		//Re-registration
+		list_[index].set(ep, msg, std::forward<Args>(args)...);
+		return true;
+	}
+
+	if(count_ == Size) return false;
+
+	index = dense_[count_++];
+	list_[index].set(ep, msg, std::forward<Args>(args)...);
+	key_[index] = key;
+	ep_[index] = eh;
+
+	unsigned kb = key & (buckets() - 1),
+			eb = eh & (buckets() - 1);
+	key_next_[index] = key_head_[kb];
+	key_head_[kb] = index;
+	ep_next_[index] = ep_head_[eb];
+	ep_head_[eb] = index;
+
+	return true;
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+template<typename Message>
+bool registry<Observe, Size, Hash>::
+remove(endpoint const& ep, Message const& msg) noexcept
+{
+	unsigned index = find_index(ep, msg, key_hash(hash_(ep), msg));
+	if(index == npos) return false;
+
+	erase(index);
+	return true;
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+bool registry<Observe, Size, Hash>::
+remove(endpoint const& ep, void const* token, std::size_t token_len) noexcept
+{
+	return remove(ep, token_view{token, token_len});
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+template<typename Message>
+Observe*
+registry<Observe, Size, Hash>::
+find(endpoint const& ep, Message const& msg) noexcept
+{
+	unsigned index = find_index(ep, msg, key_hash(hash_(ep), msg));
+	return index == npos ? nullptr : &list_[index];
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+Observe*
+registry<Observe, Size, Hash>::
+find(endpoint const& ep, void const* token, std::size_t token_len) noexcept
+{
+	return find(ep, token_view{token, token_len});
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+void
+registry<Observe, Size, Hash>::
+cancel() noexcept
+{
+	for(unsigned i = 0; i < count_; i++)
+		list_[dense_[i]].clear();
+	for(unsigned i = 0; i < buckets(); i++)
+	{
+		key_head_[i] = npos;
+		ep_head_[i] = npos;
+	}
+	count_ = 0;
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+void
+registry<Observe, Size, Hash>::
+cancel(endpoint const& ep) noexcept
+{
+	std::uint32_t eh = hash_(ep);
+	unsigned i = ep_head_[eh & (buckets() - 1)];
+	while(i != npos)
+	{
+		unsigned next = ep_next_[i];
+		if(ep_[i] == eh && list_[i].endpoint() == ep)
+			erase(i);
+		i = next;
+	}
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+Observe*
+registry<Observe, Size, Hash>::
+operator[](unsigned index) noexcept
+{
+	return index >= count_ ? nullptr : &list_[dense_[index]];
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+void
+registry<Observe, Size, Hash>::
+unlink(unsigned* head, unsigned* next, unsigned index) noexcept
+{
+	unsigned* link = head;
+	while(*link != npos)
+	{
+		if(*link == index)
+		{
+			*link = next[index];
+			return;
+		}
+		link = &next[*link];
+	}
+}
+
+template<typename Observe,
+		unsigned Size,
+		typename Hash>
+void
+registry<Observe, Size, Hash>::
+erase(unsigned index) noexcept
+{
+	unlink(&key_head_[key_[index] & (buckets() - 1)], key_next_, index);
+	unlink(&ep_head_[ep_[index] & (buckets() - 1)], ep_next_, index);
+	list_[index].clear();
+
+	/**
+	 * Moving the last used observer to the position of the removed
+	 */
+	unsigned last = dense_[--count_],
+			pos = pos_[index];
+	dense_[pos] = last;
+	pos_[last] = pos;
+	dense_[count_] = index;
+	pos_[index] = count_;
+}
+
+}//Observe
+}//CoAP
+
+#endif /* COAP_TE_OBSERVE_REGISTRY_IMPL_HPP__ */
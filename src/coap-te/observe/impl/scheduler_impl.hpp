@@ -0,0 +1,92 @@
+#ifndef COAP_TE_OBSERVE_SCHEDULER_IMPL_HPP__
+#define COAP_TE_OBSERVE_SCHEDULER_IMPL_HPP__
+
+#include <cstring>
+
+#include "../scheduler.hpp"
+#include "../../message/options/parser.hpp"
+
+namespace CoAP{
+namespace Observe{
+
+template<typename Message>
+bool parse_attributes(Message const& msg, attributes& attr) noexcept
+{
+	using namespace CoAP::Message;
+
+	bool found = false;
+	Option::Parser<Option::code> parser(msg);
+	Option::option const* opt;
+	while((opt = parser.next()) != nullptr)
+	{
+		if(opt->ocode != Option::code::uri_query) continue;
+
+		char const* value = static_cast<char const*>(opt->value);
+		unsigned length = opt->length;
+
+		unsigned key_len = 0;
+		while(key_len < length && value[key_len] != '=') key_len++;
+		if(key_len == length) continue;
+
+		/**
+		 * Value (only digits and a decimal point)
+		 */
+		double v = 0, frac = 0;
+		bool valid = key_len + 1 < length;
+		for(unsigned i = key_len + 1; i < length; i++)
+		{
+			char c = value[i];
+			if(c == '.' && frac == 0) frac = 1;
+			else if(c >= '0' && c <= '9')
+			{
+				if(frac != 0)
+				{
+					frac /= 10;
+					v += (c - '0') * frac;
+				}
+				else v = v * 10 + (c - '0');
+			}
+			else
+			{
+				valid = false;
+				break;
+			}
+		}
+		if(!valid) continue;
+
+		if(key_len == 4 && std::memcmp(value, "pmin", 4) == 0)
+			attr.pmin = static_cast<unsigned>(v);
+		else if(key_len == 4 && std::memcmp(value, "pmax", 4) == 0)
+			attr.pmax = static_cast<unsigned>(v);
+		else if(key_len == 2 && std::memcmp(value, "st", 2) == 0)
+			attr.st = v;
+		else continue;
+		found = true;
+	}
+	return found;
+}
+
+template<typename List>
+void update(List& list) noexcept
+{
+	for(unsigned i = 0; i < list.size(); i++)
+	{
+		auto* obs = list[i];
+		if(obs && obs->is_used()) obs->scheduler().update();
+	}
+}
+
+template<typename List>
+void update(List& list, double value) noexcept
+{
+	for(unsigned i = 0; i < list.size(); i++)
+	{
+		auto* obs = list[i];
+		if(obs && obs->is_used()) obs->scheduler().update(value);
+	}
+}
+
+}//Observe
+}//CoAP
+
+#endif /* COAP_TE_OBSERVE_SCHEDULER_IMPL_HPP__ */
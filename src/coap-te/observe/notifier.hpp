@@ -0,0 +1,213 @@
+#ifndef COAP_TE_OBSERVE_NOTIFIER_HPP__
+#define COAP_TE_OBSERVE_NOTIFIER_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "types.hpp"
+#include "../error.hpp"
+#include "../message/types.hpp"
+#include "../message/codes.hpp"
+#include "../message/options/options.hpp"
+#include "../transmission/types.hpp"
+
+namespace CoAP{
+namespace Observe{
+
+/**
+ * Final status of a notification sent to a observer
+ */
+enum class notify_status{
+	acknowledged = 0,	///< CON notification acknowledged
+	reset,				///< Observer answered with a reset (must be removed)
+	timeout				///< CON notification not acknowledged (must be removed)
+};
+
+/**
+ * Called when a CON notification is acknowledged/reset/timeout.
+ *
+ * https://tools.ietf.org/html/rfc7641#section-4.5
+ *
+ * Reset and timeout means that the observer is not interested anymore, and must be
+ * removed from the observer list.
+ */
+template<typename Endpoint>
+using notify_cb = void(*)(Endpoint const&,
+						void const* token, std::size_t token_len,
+						notify_status,
+						void* data) noexcept;
+
+/**
+ * Notification fan-out
+ *
+ * The notification (code, options and payload) is serialized once to a slot,
+ * leaving room to the header. To each observer, just the header (type, message
+ * ID and token) is patched in place, and the buffer is sent.
+ *
+ * Confirmable notifications are tracked at a pending list, referencing the slot
+ * (reference counted). The slot is only reused when all the notifications that
+ * reference it are acknowledged/reset/timeout. The pending list is indexed by
+ * message ID (hash table with chaining), and the free entries kept at a stack,
+ * so sending and matching a acknowledgment don't walk the list.
+ *
+ * 'MaxPending' must be sized to the fan-out: the number of observers that may
+ * have a confirmable notification not acknowledged at the same time. If the
+ * pending list is full, a confirmable notification is not sent (error
+ * 'no_free_slots'): it's never downgraded to non-confirmable.
+ *
+ * The acknowledgments must be feed at the 'response' method (engine default
+ * callback), and 'check' must be called periodically (retransmissions).
+ */
+template<typename Endpoint,
+		unsigned MaxPacketSize,
+		unsigned MaxPending = 8,
+		unsigned Slots = 2>
+class notifier{
+	public:
+		using endpoint_t = Endpoint;
+		using notify_cb_t = notify_cb<Endpoint>;
+
+		static constexpr const unsigned header_reserve = 4 + 8;	///< header + max token
+
+		notifier();
+		notifier(CoAP::Transmission::configure const&);
+
+		void callback(notify_cb_t, void* data = nullptr) noexcept;
+
+		/**
+		 * Serialize the notification (options and payload) once. The following 'send'
+		 * calls uses this notification.
+		 */
+		bool set(CoAP::Message::type, CoAP::Message::code,
+				CoAP::Message::Option::List& options,
+				void const* payload, std::size_t payload_len,
+				CoAP::Error&) noexcept;
+
+		/**
+		 * Send the notification set to one observer. A confirmable notification
+		 * fails with 'no_free_slots' if the pending list is full.
+		 */
+		template<typename Engine>
+		bool send(Engine&, Endpoint const&,
+				void const* token, std::size_t token_len,
+				CoAP::Error&) noexcept;
+		/**
+		 * Send the notification set to one observer, overriding the type set
+		 */
+		template<typename Engine>
+		bool send(Engine&, Endpoint const&,
+				void const* token, std::size_t token_len,
+				CoAP::Message::type,
+				CoAP::Error&) noexcept;
+
+		/**
+		 * Set the notification and send it to all observers of the list. The list must
+		 * provide 'size()' and 'operator[]', and the observers 'is_used()', 'endpoint()',
+		 * 'token()' and 'token_len()' (as CoAP::Observe::list/observe).
+		 *
+		 * A confirmable notification is only sent if there is room at the pending
+		 * list to all observers; if not, nothing is sent and 'ec' is set to
+		 * 'no_free_slots' (the caller must try again later, e.g. after some
+		 * acknowledgments).
+		 *
+		 * Returns the number of notifications sent.
+		 */
+		template<typename Engine,
+				typename List>
+		unsigned notify(Engine&, List&,
+				CoAP::Message::type, CoAP::Message::code,
+				CoAP::Message::Option::List& options,
+				void const* payload, std::size_t payload_len,
+				CoAP::Error&) noexcept;
+
+		/**
+		 * Send the notification just to the observers which scheduler is due (see
+		 * CoAP::Observe::scheduler and scheduled_observe), with the type defined by
+		 * the scheduler. The notification is only serialized if any observer is due.
+		 * The scheduler of a observer is only updated if its notification was sent
+		 * (if not, e.g. no free slot, it stays due to the next call).
+		 *
+		 * Returns the number of notifications sent.
+		 */
+		template<typename Engine,
+				typename List>
+		unsigned notify_scheduled(Engine&, List&,
+				CoAP::Message::code,
+				CoAP::Message::Option::List& options,
+				void const* payload, std::size_t payload_len,
+				CoAP::Error&) noexcept;
+
+		/**
+		 * Process a empty ACK/RST received. Returns true if it was a
+		 * response to a pending notification.
+		 */
+		template<typename Message>
+		bool response(Endpoint const&, Message const&) noexcept;
+
+		/**
+		 * Retransmit/timeout pending notifications
+		 */
+		template<typename Engine>
+		void check(Engine&) noexcept;
+
+		unsigned pending() const noexcept;
+		/**
+		 * Confirmable notifications that can still be sent
+		 */
+		unsigned available() const noexcept{ return free_count_; }
+	private:
+		static constexpr unsigned buckets() noexcept
+		{
+			unsigned b = 1;
+			while(b < MaxPending) b <<= 1;
+			return b;
+		}
+		static constexpr const unsigned npos = MaxPending;
+
+		struct slot_t{
+			unsigned				refs = 0;
+			CoAP::Message::type		mtype = CoAP::Message::type::nonconfirmable;
+			CoAP::Message::code		mcode = CoAP::Message::code::content;
+			std::size_t				size = 0;		///< Options and payload size
+			std::uint8_t			buffer[header_reserve + MaxPacketSize];
+		};
+
+		struct pending_t{
+			bool					used = false;
+			Endpoint				ep;
+			std::uint16_t			mid = 0;
+			std::uint8_t			token[8];
+			std::size_t				token_len = 0;
+			unsigned				slot = 0;
+			CoAP::time_t			next_expiration = 0;
+			double					expiration_factor = 0;
+			unsigned				retransmission_remaining = 0;
+		};
+
+		std::uint8_t* make(slot_t&, CoAP::Message::type,
+				std::uint16_t mid,
+				void const* token, std::size_t token_len,
+				CoAP::Error&) noexcept;
+		void init() noexcept;
+		void release(unsigned index, notify_status) noexcept;
+
+		slot_t							slots_[Slots];
+		pending_t						pending_[MaxPending];
+		unsigned						mid_head_[buckets()];		///< pending by message ID
+		unsigned						mid_next_[MaxPending];		///< next at the same bucket
+		unsigned						free_[MaxPending];			///< free pending (stack)
+		unsigned						free_count_ = 0;
+		unsigned						current_ = Slots;
+
+		CoAP::Transmission::configure	config_;
+
+		notify_cb_t						cb_ = nullptr;
+		void*							data_ = nullptr;
+};
+
+}//Observe
+}//CoAP
+
+#include "impl/notifier_impl.hpp"
+
+#endif /* COAP_TE_OBSERVE_NOTIFIER_HPP__ */
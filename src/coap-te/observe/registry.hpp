@@ -0,0 +1,106 @@
+#ifndef COAP_TE_OBSERVE_REGISTRY_HPP__
+#define COAP_TE_OBSERVE_REGISTRY_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+
+#include "types.hpp"
+#include "../cache/functions.hpp"
+
+namespace CoAP{
+namespace Observe{
+
+/**
+ * Default endpoint hash: the port and, if the endpoint provides it,
+ * the address. Provide your own hash functor to other endpoint types.
+ */
+template<typename Endpoint>
+struct endpoint_hash{
+	std::uint32_t operator()(Endpoint const&) const noexcept;
+};
+
+/**
+ * Observer registry
+ *
+ * Same interface of CoAP::Observe::list, but the observers are indexed by
+ * (endpoint, token) and by endpoint, using hash tables with chaining. Add,
+ * remove and find are O(1) average, and cancel(endpoint) just walks the
+ * observers of that endpoint.
+ *
+ * The index information is kept apart from the observers (arrays of indexes
+ * and hashes), and the used observers are kept dense at the beginning of
+ * the iteration order: 'size()' is the number of observers registered
+ * and 'operator[]' returns only used observers (fan-out doesn't walk free
+ * slots). Removing a observer changes the iteration order.
+ *
+ * The observer type must provide 'endpoint()' (as CoAP::Observe::observe).
+ */
+template<typename Observe,
+		unsigned Size,
+		typename Hash = endpoint_hash<typename Observe::endpoint_t>>
+class registry{
+	public:
+		using endpoint = typename Observe::endpoint_t;
+
+		registry();
+
+		constexpr unsigned capacity() const noexcept{ return Size; }
+		unsigned size() const noexcept;
+
+		template<typename Message, typename ...Args>
+		bool process(endpoint const&, Message const&, Args&&...) noexcept;
+
+		template<typename Message, typename ...Args>
+		bool add(endpoint const&, Message const&, Args&&...) noexcept;
+		template<typename Message>
+		bool remove(endpoint const&, Message const&) noexcept;
+		bool remove(endpoint const&, void const* token, std::size_t token_len) noexcept;
+
+		template<typename Message>
+		Observe* find(endpoint const&, Message const&) noexcept;
+		Observe* find(endpoint const&, void const* token, std::size_t token_len) noexcept;
+
+		void cancel() noexcept;
+		void cancel(endpoint const&) noexcept;
+
+		Observe* operator[](unsigned index) noexcept;
+	private:
+		static constexpr unsigned buckets() noexcept
+		{
+			unsigned b = 1;
+			while(b < Size) b <<= 1;
+			return b;
+		}
+		static constexpr const unsigned npos = Size;
+
+		template<typename Message>
+		unsigned find_index(endpoint const&, Message const&, std::uint32_t key) const noexcept;
+		template<typename Message>
+		static std::uint32_t key_hash(std::uint32_t ep_hash, Message const&) noexcept;
+
+		void unlink(unsigned* head, unsigned* next, unsigned index) noexcept;
+		void erase(unsigned index) noexcept;
+
+		Observe			list_[Size];
+
+		std::uint32_t	key_[Size];			///< (endpoint, token) hash
+		std::uint32_t	ep_[Size];			///< endpoint hash
+		unsigned		key_next_[Size];	///< next at the same key bucket
+		unsigned		ep_next_[Size];		///< next at the same endpoint bucket
+		unsigned		dense_[Size];		///< [0, count_) used, [count_, Size) free
+		unsigned		pos_[Size];			///< position of the observer at dense_
+
+		unsigned		key_head_[buckets()];
+		unsigned		ep_head_[buckets()];
+
+		unsigned		count_ = 0;
+		Hash			hash_;
+};
+
+}//Observe
+}//CoAP
+
+#include "impl/registry_impl.hpp"
+
+#endif /* COAP_TE_OBSERVE_REGISTRY_HPP__ */
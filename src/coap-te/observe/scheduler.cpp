@@ -0,0 +1,107 @@
+#include "scheduler.hpp"
+
+namespace CoAP{
+namespace Observe{
+
+scheduler::scheduler(attributes const& attr, unsigned con_every /* = 0 */) noexcept
+	: attr_(attr), con_every_(con_every){}
+
+void scheduler::attr(attributes const& attr) noexcept
+{
+	attr_ = attr;
+}
+
+attributes const& scheduler::attr() const noexcept
+{
+	return attr_;
+}
+
+void scheduler::con_every(unsigned n) noexcept
+{
+	con_every_ = n;
+}
+
+unsigned scheduler::con_every() const noexcept
+{
+	return con_every_;
+}
+
+void scheduler::update() noexcept
+{
+	pending_ = true;
+}
+
+void scheduler::update(double value) noexcept
+{
+	value_ = value;
+	if(attr_.st == 0 || !valued_)
+	{
+		pending_ = true;
+		return;
+	}
+
+	double diff = value > last_value_ ? value - last_value_ : last_value_ - value;
+	if(diff >= attr_.st) pending_ = true;
+}
+
+bool scheduler::check(CoAP::time_t now, CoAP::Message::type& mtype) noexcept
+{
+	if(!due(now, mtype)) return false;
+
+	commit(now);
+	return true;
+}
+
+bool scheduler::due(CoAP::time_t now, CoAP::Message::type& mtype) const noexcept
+{
+	CoAP::time_t elapsed = now - last_time_;
+	bool send = false;
+	if(pending_)
+		send = !notified_ || elapsed >= static_cast<CoAP::time_t>(attr_.pmin) * 1000;
+	if(!send && notified_ && attr_.pmax != 0)
+		send = elapsed >= static_cast<CoAP::time_t>(attr_.pmax) * 1000;
+
+	if(!send) return false;
+
+	mtype = con_every_ != 0 && ((count_ + 1) % con_every_) == 0 ?
+				CoAP::Message::type::confirmable :
+				CoAP::Message::type::nonconfirmable;
+
+	return true;
+}
+
+void scheduler::commit(CoAP::time_t now) noexcept
+{
+	count_++;
+	pending_ = false;
+	notified_ = true;
+	last_time_ = now;
+	last_value_ = value_;
+	valued_ = true;
+}
+
+bool scheduler::pending() const noexcept
+{
+	return pending_;
+}
+
+void scheduler::reset() noexcept
+{
+	count_ = 0;
+	pending_ = false;
+	notified_ = false;
+	valued_ = false;
+	last_time_ = 0;
+	last_value_ = 0;
+	value_ = 0;
+}
+
+void scheduler::start(CoAP::time_t now) noexcept
+{
+	reset();
+	notified_ = true;
+	last_time_ = now;
+}
+
+}//Observe
+}//CoAP
@@ -0,0 +1,140 @@
+#ifndef COAP_TE_OBSERVE_SCHEDULER_HPP__
+#define COAP_TE_OBSERVE_SCHEDULER_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "types.hpp"
+#include "observer.hpp"
+#include "../message/types.hpp"
+
+namespace CoAP{
+namespace Observe{
+
+/**
+ * Conditional attributes (pmin, pmax and st)
+ *
+ * https://tools.ietf.org/html/draft-ietf-core-conditional-attributes
+ *
+ * The periods are in seconds (as at the query); zero disables the attribute.
+ */
+struct attributes{
+	unsigned	pmin = 0;		///< Minimum period between notifications
+	unsigned	pmax = 0;		///< Maximum period without notification
+	double		st = 0;			///< Minimum change of a numeric value to notify
+};
+
+/**
+ * Fill the attributes with the 'pmin', 'pmax' and 'st' Uri-Query options of
+ * a message. Attributes not present are not changed. Returns true if any
+ * attribute was found.
+ */
+template<typename Message>
+bool parse_attributes(Message const&, attributes&) noexcept;
+
+/**
+ * Notification scheduler
+ *
+ * Decouples resource updates from notifications. The resource just calls
+ * 'update' at each change (the application keeps the last value... last
+ * value wins), and 'check' tells when a notification must be sent:
+ * - a update is pending and 'pmin' has elapsed since the last notification;
+ * - 'pmax' has elapsed since the last notification (even without update).
+ *
+ * When 'st' is set, the numeric updates that differ from the last value
+ * notified less than 'st' are ignored.
+ *
+ * The type of the notification is also defined: each Nth notification is
+ * sent confirmable (zero, never; one, always), the others non-confirmable.
+ *
+ * Can be used by resource (one scheduler to all observers) or by observer
+ * (see 'scheduled_observe').
+ */
+class scheduler{
+	public:
+		scheduler() = default;
+		scheduler(attributes const&, unsigned con_every = 0) noexcept;
+
+		void attr(attributes const&) noexcept;
+		attributes const& attr() const noexcept;
+
+		void con_every(unsigned) noexcept;
+		unsigned con_every() const noexcept;
+
+		void update() noexcept;
+		void update(double value) noexcept;
+
+		/**
+		 * Returns true if a notification must be sent now. The
+		 * notification type is set at 'mtype'.
+		 */
+		bool check(CoAP::time_t now, CoAP::Message::type& mtype) noexcept;
+		/**
+		 * Same as 'check', split in two: 'due' doesn't change the state, and
+		 * 'commit' must be called just after the notification was sent (if the
+		 * notification fails, it stays due).
+		 */
+		bool due(CoAP::time_t now, CoAP::Message::type& mtype) const noexcept;
+		void commit(CoAP::time_t now) noexcept;
+
+		bool pending() const noexcept;
+		void reset() noexcept;
+		/**
+		 * Reset, counting the register response (sent at 'now') as
+		 * the last notification
+		 */
+		void start(CoAP::time_t now) noexcept;
+	private:
+		attributes		attr_;
+		unsigned		con_every_ = 0;
+
+		unsigned		count_ = 0;
+		bool			pending_ = false;
+		bool			notified_ = false;
+		bool			valued_ = false;	///< last_value_ was notified
+		CoAP::time_t	last_time_ = 0;
+		double			last_value_ = 0;
+		double			value_ = 0;
+};
+
+/**
+ * Observer with its own scheduler. The attributes are read from the
+ * query of the register request (the ones not present are taken from
+ * 'defaults').
+ */
+template<typename Endpoint>
+class scheduled_observe : public observe<Endpoint, false>{
+	public:
+		template<typename Message>
+		void set(Endpoint const& ep, Message const& msg,
+				attributes const& defaults = attributes{},
+				unsigned con_every = 0) noexcept
+		{
+			observe<Endpoint, false>::set(ep, msg);
+
+			attributes attr = defaults;
+			parse_attributes(msg, attr);
+			sch_.attr(attr);
+			sch_.con_every(con_every);
+			sch_.start(CoAP::time());
+		}
+
+		CoAP::Observe::scheduler& scheduler() noexcept{ return sch_; }
+	private:
+		CoAP::Observe::scheduler	sch_;
+};
+
+/**
+ * Update the scheduler of all observers of a list (observers as 'scheduled_observe')
+ */
+template<typename List>
+void update(List&) noexcept;
+template<typename List>
+void update(List&, double value) noexcept;
+
+}//Observe
+}//CoAP
+
+#include "impl/scheduler_impl.hpp"
+
+#endif /* COAP_TE_OBSERVE_SCHEDULER_HPP__ */
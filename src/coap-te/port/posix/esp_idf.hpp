@@ -6,5 +6,6 @@
 #include "lwip/err.h"
 
 #include "sys/select.h"
+#include "sys/uio.h"
 
 #endif /* COAP_TE_PORT_POSIX_ESP_IDF_HPP__ */
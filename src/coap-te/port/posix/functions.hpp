@@ -14,6 +14,16 @@ inline bool init() noexcept{ return true; }
 template<typename Handler>
 bool nonblock_socket(Handler socket);
 
+/**
+ * Waits until any of the sockets is readable, or BlockTimeMs (negative
+ * waits forever). 'ready[i]' tells if 'sockets[i]' is readable.
+ *
+ * Returns false on error.
+ */
+template<int BlockTimeMs,
+		typename Handler>
+bool wait_readable(Handler const* sockets, unsigned count, bool* ready) noexcept;
+
 }//POSIX
 }//Port
 }//CoAP
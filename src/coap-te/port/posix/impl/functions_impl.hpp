@@ -23,6 +23,38 @@ bool nonblock_socket(Handler socket)
 #endif
 }
 
+template<int BlockTimeMs,
+		typename Handler>
+bool wait_readable(Handler const* sockets, unsigned count, bool* ready) noexcept
+{
+	struct timeval tv = {
+		/*.tv_sec = */BlockTimeMs / 1000,
+		/*.tv_usec = */(BlockTimeMs % 1000) * 1000
+	};
+
+	fd_set rfds;
+	FD_ZERO(&rfds);
+	[[maybe_unused]] Handler max = 0;
+	for(unsigned i = 0; i < count; i++)
+	{
+		FD_SET(sockets[i], &rfds);
+		max = sockets[i] > max ? sockets[i] : max;
+	}
+
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+	//First argument is ignored at Windows
+	int s = select(0, &rfds, NULL, NULL, BlockTimeMs  < 0 ? NULL : &tv);
+#else /* defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__) */
+	int s = select(max + 1, &rfds, NULL, NULL, BlockTimeMs  < 0 ? NULL : &tv);
+#endif /* defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__) */
+	if(s < 0) return false;
+
+	for(unsigned i = 0; i < count; i++)
+		ready[i] = FD_ISSET(sockets[i], &rfds);
+
+	return true;
+}
+
 }//POSIX
 }//Port
 }//CoAP
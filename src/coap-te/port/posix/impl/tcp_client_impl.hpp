@@ -279,6 +279,18 @@ receive(void* buffer, std::size_t buffer_len, CoAP::Error& ec) noexcept
 	return 0;
 }
 
+template<class Endpoint,
+		int Flags>
+void
+tcp_client<Endpoint, Flags>::
+cork(bool enable [[maybe_unused]]) noexcept
+{
+#ifdef TCP_CORK
+	int opt = enable;
+	::setsockopt(socket_, IPPROTO_TCP, TCP_CORK, &opt, sizeof(opt));
+#endif /* TCP_CORK */
+}
+
 }//POSIX
 }//Port
 }//CoAP
@@ -93,7 +93,7 @@ open_poll() noexcept
 	if(epoll_fd_ == -1)
 		return false;
 
-	if(!add_socket_poll(socket_, EPOLLIN | EPOLLOUT | EPOLLET))
+	if(!add_socket_poll(socket_, EPOLLIN | EPOLLET))
 		return false;
 #endif /* COAP_TE_USE_SELECT = 1 */
 	return true;
@@ -198,13 +198,15 @@ template<
 		unsigned MaxEvents /* = 32 */,
 		typename ReadCb,
 		typename OpenCb /* = void* */,
-		typename CloseCb /* = void* */>
+		typename CloseCb /* = void* */,
+		typename WriteCb /* = void* */>
 bool
 tcp_server<Endpoint, Flags>::
 run(CoAP::Error& ec,
 		ReadCb read_cb,
 		OpenCb open_cb/* = nullptr */ [[maybe_unused]],
-		CloseCb close_cb/* = nullptr */ [[maybe_unused]]) noexcept
+		CloseCb close_cb/* = nullptr */ [[maybe_unused]],
+		WriteCb write_cb/* = nullptr */ [[maybe_unused]]) noexcept
 {
 	struct epoll_event events[MaxEvents];
 
@@ -213,17 +215,38 @@ run(CoAP::Error& ec,
 	{
 		if (events[i].data.fd == socket_)
 		{
-			[[maybe_unused]] int c = accept(ec);
-			if constexpr(!std::is_same<void*, OpenCb>::value)
-			{
-				open_cb(c);
-			}
+			/**
+			 * Edge triggered: all pending connections must be accepted (if
+			 * non-blocking), or the next ones will wait a new connection
+			 */
+			do{
+				[[maybe_unused]] handler c = accept(ec);
+				if(ec)
+				{
+					if(errno == EAGAIN || errno == EWOULDBLOCK)
+						ec.clear();
+					break;
+				}
+				if constexpr(!std::is_same<void*, OpenCb>::value)
+				{
+					open_cb(c);
+				}
+			}while((Flags & MSG_DONTWAIT) != 0);
 		}
-		else if (events[i].events & EPOLLIN)
+		else
 		{
-			/* handle EPOLLIN event */
 			handler s = events[i].data.fd;
-			read_cb(s);
+			if (events[i].events & EPOLLIN)
+			{
+				/* handle EPOLLIN event */
+				read_cb(s);
+			}
+			if constexpr(!std::is_same<void*, WriteCb>::value)
+			{
+				/* socket can be written again: flush pending data */
+				if (events[i].events & EPOLLOUT)
+					write_cb(s);
+			}
 		}
 		/* check if the connection is closing */
 		if (events[i].events & (EPOLLRDHUP | EPOLLHUP))
@@ -248,13 +271,15 @@ template<
 		unsigned MaxEvents /* = 32 */,
 		typename ReadCb,
 		typename OpenCb /* = void* */,
-		typename CloseCb /* = void* */>
+		typename CloseCb /* = void* */,
+		typename WriteCb /* = void* */>
 bool
 tcp_server<Endpoint, Flags>::
 run(CoAP::Error& ec,
 		ReadCb read_cb,
 		OpenCb open_cb/* = nullptr */ [[maybe_unused]],
-		CloseCb close_cb/* = nullptr */ [[maybe_unused]]) noexcept
+		CloseCb close_cb/* = nullptr */ [[maybe_unused]],
+		WriteCb write_cb/* = nullptr */ [[maybe_unused]]) noexcept
 {
 	fd_set rfds;
 
@@ -398,6 +423,85 @@ send(handler to_socket, const void* buffer, std::size_t buffer_len, CoAP::Error&
 	return size;
 }
 
+template<class Endpoint,
+		int Flags>
+std::size_t
+tcp_server<Endpoint, Flags>::
+send(handler to_socket, const void* const* buffers,
+		std::size_t const* sizes, unsigned count, CoAP::Error& ec)  noexcept
+{
+#if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+	std::size_t total = 0;
+	for(unsigned i = 0; i < count; i++)
+	{
+		std::size_t size = send(to_socket, buffers[i], sizes[i], ec);
+		total += size;
+		if(ec || size < sizes[i]) break;
+	}
+	return total;
+#else /* defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__) */
+	static constexpr const unsigned max_iov = 16;
+	struct iovec iov[max_iov];
+
+	std::size_t total = 0;
+	for(unsigned i = 0; i < count;)
+	{
+		unsigned n = 0;
+		std::size_t batch = 0;
+		for(; n < max_iov && i < count; n++, i++)
+		{
+			iov[n].iov_base = const_cast<void*>(buffers[i]);
+			iov[n].iov_len = sizes[i];
+			batch += sizes[i];
+		}
+
+		ssize_t size = ::writev(to_socket, iov, static_cast<int>(n));
+		if(size < 0)
+		{
+			if constexpr((Flags & MSG_DONTWAIT) != 0)
+			{
+				if(errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					return total;
+				}
+			}
+			ec = CoAP::errc::socket_send;
+			return total;
+		}
+		total += static_cast<std::size_t>(size);
+		if(static_cast<std::size_t>(size) < batch) break;
+	}
+	return total;
+#endif /* defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__) */
+}
+
+template<class Endpoint,
+		int Flags>
+void
+tcp_server<Endpoint, Flags>::
+cork(handler socket [[maybe_unused]], bool enable [[maybe_unused]]) noexcept
+{
+#ifdef TCP_CORK
+	int opt = enable;
+	::setsockopt(socket, IPPROTO_TCP, TCP_CORK, &opt, sizeof(opt));
+#endif /* TCP_CORK */
+}
+
+template<class Endpoint,
+		int Flags>
+void
+tcp_server<Endpoint, Flags>::
+poll_write(handler socket [[maybe_unused]], bool enable [[maybe_unused]]) noexcept
+{
+#if COAP_TE_USE_SELECT != 1
+	struct epoll_event ev;
+	ev.events = EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLHUP;
+	if(enable) ev.events |= EPOLLOUT;
+	ev.data.fd = socket;
+	epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, socket, &ev);
+#endif /* COAP_TE_USE_SELECT != 1 */
+}
+
 #if COAP_TE_USE_SELECT == 1 || COAP_TE_TCP_SERVER_CLIENT_LIST == 1
 template<class Endpoint,
 		int Flags>
@@ -5,6 +5,16 @@
 #include "../functions.hpp"
 
 #include <cerrno>
+#include <cstring>
+
+/**
+ * Destination address of the received datagrams (to check multicast)
+ */
+#if COAP_TE_MULTICAST == 1 \
+	&& !(defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)) \
+	&& defined(IP_PKTINFO)
+#define COAP_TE_PORT_POSIX_PKTINFO	1
+#endif
 
 namespace CoAP{
 namespace Port{
@@ -122,6 +132,11 @@ std::size_t
 udp<Endpoint, Flags>::
 receive(void* buffer, std::size_t buffer_len, endpoint& ep, CoAP::Error& ec) noexcept
 {
+#if COAP_TE_MULTICAST == 1
+	multicast_ = false;
+	if(pktinfo_) return receive_info(buffer, buffer_len, ep, ec);
+#endif /* COAP_TE_MULTICAST == 1 */
+
 #if defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
 	/**
 	 * sockaddr_storage fits both IPv4 and IPv6
@@ -158,6 +173,15 @@ receive(void* buffer, std::size_t buffer_len, endpoint& ep, CoAP::Error& ec) noe
 	return recv;
 }
 
+template<class Endpoint,
+		int Flags>
+typename udp<Endpoint, Flags>::handler
+udp<Endpoint, Flags>::
+native() const noexcept
+{
+	return socket_;
+}
+
 template<class Endpoint,
 		int Flags>
 template<int BlockTimeMs>
@@ -192,6 +216,142 @@ receive(void* buffer, std::size_t buffer_len, endpoint& ep, CoAP::Error& ec) noe
 	return 0;
 }
 
+#if COAP_TE_MULTICAST == 1
+
+template<class Endpoint,
+		int Flags>
+void
+udp<Endpoint, Flags>::
+join(endpoint& group, CoAP::Error& ec) noexcept
+{
+	membership(group, true, ec);
+	if(ec) return;
+
+	/**
+	 * Asking the destination address of the datagrams received
+	 */
+#if COAP_TE_PORT_POSIX_PKTINFO == 1
+	int on = 1;
+	if(group.family() == AF_INET6)
+		pktinfo_ = ::setsockopt(socket_, IPPROTO_IPV6, IPV6_RECVPKTINFO, &on, sizeof(on)) == 0;
+	else
+		pktinfo_ = ::setsockopt(socket_, IPPROTO_IP, IP_PKTINFO, &on, sizeof(on)) == 0;
+#endif /* COAP_TE_PORT_POSIX_PKTINFO == 1 */
+}
+
+template<class Endpoint,
+		int Flags>
+void
+udp<Endpoint, Flags>::
+leave(endpoint& group, CoAP::Error& ec) noexcept
+{
+	membership(group, false, ec);
+}
+
+template<class Endpoint,
+		int Flags>
+bool
+udp<Endpoint, Flags>::
+multicast() const noexcept
+{
+	return multicast_;
+}
+
+template<class Endpoint,
+		int Flags>
+void
+udp<Endpoint, Flags>::
+membership(endpoint& group, bool join, CoAP::Error& ec) noexcept
+{
+	int ret;
+	if(group.family() == AF_INET6)
+	{
+		struct ipv6_mreq mreq;
+		std::memset(&mreq, 0, sizeof(mreq));
+		mreq.ipv6mr_multiaddr = reinterpret_cast<struct sockaddr_in6 const*>(group.native())->sin6_addr;
+		ret = ::setsockopt(socket_, IPPROTO_IPV6,
+				join ? IPV6_JOIN_GROUP : IPV6_LEAVE_GROUP,
+				reinterpret_cast<char const*>(&mreq), sizeof(mreq));
+	}
+	else
+	{
+		struct ip_mreq mreq;
+		std::memset(&mreq, 0, sizeof(mreq));
+		mreq.imr_multiaddr = reinterpret_cast<struct sockaddr_in const*>(group.native())->sin_addr;
+		mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+		ret = ::setsockopt(socket_, IPPROTO_IP,
+				join ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP,
+				reinterpret_cast<char const*>(&mreq), sizeof(mreq));
+	}
+
+	if(ret != 0) ec = CoAP::errc::socket_option;
+}
+
+template<class Endpoint,
+		int Flags>
+std::size_t
+udp<Endpoint, Flags>::
+receive_info(void* buffer, std::size_t buffer_len, endpoint& ep, CoAP::Error& ec) noexcept
+{
+#if COAP_TE_PORT_POSIX_PKTINFO == 1
+	struct iovec iov;
+	iov.iov_base = buffer;
+	iov.iov_len = buffer_len;
+
+	union{
+		struct cmsghdr	align;
+		std::uint8_t	buffer[CMSG_SPACE(sizeof(struct in6_pktinfo))];
+	}control;
+
+	struct msghdr msg;
+	std::memset(&msg, 0, sizeof(msg));
+	msg.msg_name = ep.native();
+	msg.msg_namelen = sizeof(struct sockaddr_storage);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control.buffer;
+	msg.msg_controllen = sizeof(control.buffer);
+
+	ssize_t recv = ::recvmsg(socket_, &msg, 0);
+	if(recv < 0)
+	{
+		if constexpr((Flags & MSG_DONTWAIT) != 0)
+		{
+			if(errno == EAGAIN || errno == EWOULDBLOCK)
+				return 0;
+		}
+		ec = CoAP::errc::socket_receive;
+		return 0;
+	}
+
+	for(struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+	{
+		if(cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO)
+		{
+			struct in_pktinfo info;
+			std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+			multicast_ = IN_MULTICAST(ntohl(info.ipi_addr.s_addr));
+		}
+		else if(cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO)
+		{
+			struct in6_pktinfo info;
+			std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+			multicast_ = IN6_IS_ADDR_MULTICAST(&info.ipi6_addr);
+		}
+	}
+
+	return static_cast<std::size_t>(recv);
+#else /* COAP_TE_PORT_POSIX_PKTINFO == 1 */
+	(void)buffer;
+	(void)buffer_len;
+	(void)ep;
+	ec = CoAP::errc::socket_receive;
+	return 0;
+#endif /* COAP_TE_PORT_POSIX_PKTINFO == 1 */
+}
+
+#endif /* COAP_TE_MULTICAST == 1 */
+
 }//POSIX
 }//Port
 }//CoAP
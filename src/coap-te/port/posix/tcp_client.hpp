@@ -40,6 +40,10 @@ class tcp_client{
 		void close() noexcept;
 
 		std::size_t send(const void*, std::size_t, CoAP::Error&)  noexcept;
+		/**
+		 * TCP_CORK: data is held until uncorked (no-op if not available)
+		 */
+		void cork(bool) noexcept;
 		std::size_t receive(void*, std::size_t, CoAP::Error&) noexcept;
 		template<int BlockTimeMs>
 		std::size_t receive(void*, std::size_t, CoAP::Error&) noexcept;
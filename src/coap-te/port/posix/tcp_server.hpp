@@ -38,15 +38,32 @@ class tcp_server{
 			unsigned MaxEvents = 32,
 			typename ReadCb,
 			typename OpenCb = void*,
-			typename CloseCb = void*>
+			typename CloseCb = void*,
+			typename WriteCb = void*>
 		bool run(CoAP::Error&,
-				ReadCb, OpenCb = nullptr, CloseCb = nullptr) noexcept;
+				ReadCb, OpenCb = nullptr, CloseCb = nullptr,
+				WriteCb = nullptr) noexcept;
 
 		std::size_t send(handler to_socket, const void*, std::size_t, CoAP::Error&)  noexcept;
+		/**
+		 * Sends all buffers with one call (writev). Returns the number of bytes
+		 * sent, that can be less than the total at non-blocking sockets.
+		 */
+		std::size_t send(handler to_socket, const void* const* buffers,
+				std::size_t const* sizes, unsigned count, CoAP::Error&) noexcept;
 		std::size_t receive(handler socket, void* buffer, std::size_t, CoAP::Error&) noexcept;
 
 		void close() noexcept;
 		void close_client(handler) noexcept;
+		/**
+		 * TCP_CORK: data is held until uncorked (no-op if not available)
+		 */
+		void cork(handler socket, bool) noexcept;
+		/**
+		 * Poll (or not) the client socket to be writable (EPOLLOUT), what
+		 * should be set only while there is data pending (no-op with select)
+		 */
+		void poll_write(handler socket, bool) noexcept;
 
 #if COAP_TE_USE_SELECT == 1 || COAP_TE_TCP_SERVER_CLIENT_LIST == 1
 		fd_set const& client_list() const noexcept;
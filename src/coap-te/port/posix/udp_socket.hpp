@@ -4,6 +4,7 @@
 #include <cstdlib>
 #include <cstdint>
 #include "../../error.hpp"
+#include "../../defines/defaults.hpp"
 #include "port.hpp"
 
 namespace CoAP{
@@ -30,12 +31,32 @@ class udp{
 
 		void close() noexcept;
 
+		handler native() const noexcept;
+
 		std::size_t send(const void*, std::size_t, endpoint&, CoAP::Error&)  noexcept;
 		std::size_t receive(void*, std::size_t, endpoint&, CoAP::Error&) noexcept;
 		template<int BlockTimeMs>
 		std::size_t receive(void*, std::size_t, endpoint&, CoAP::Error&) noexcept;
+#if COAP_TE_MULTICAST == 1
+		/**
+		 * Join/leave a multicast group (at any interface). After join, the
+		 * destination address of the received datagrams is checked (if the
+		 * system supports), and 'multicast' tells if the last datagram received
+		 * was sent to a multicast address.
+		 */
+		void join(endpoint& group, CoAP::Error&) noexcept;
+		void leave(endpoint& group, CoAP::Error&) noexcept;
+		bool multicast() const noexcept;
+#endif /* COAP_TE_MULTICAST == 1 */
 	private:
 		handler socket_;
+#if COAP_TE_MULTICAST == 1
+		void membership(endpoint& group, bool join, CoAP::Error&) noexcept;
+		std::size_t receive_info(void*, std::size_t, endpoint&, CoAP::Error&) noexcept;
+
+		bool	pktinfo_ = false;
+		bool	multicast_ = false;
+#endif /* COAP_TE_MULTICAST == 1 */
 };
 
 }//POSIX
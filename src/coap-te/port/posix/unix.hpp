@@ -2,6 +2,7 @@
 #define COAP_TE_PORT_POSIX_UNIX_HPP__
 
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 
 #ifdef __EMSCRIPTEN__
@@ -11,5 +12,6 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/epoll.h>
+#include <sys/uio.h>
 
 #endif /* COAP_TE_PORT_POSIX_UNIX_HPP__ */
@@ -0,0 +1,55 @@
+#ifndef COAP_TE_PROXY_EXCHANGE_LIST_HPP__
+#define COAP_TE_PROXY_EXCHANGE_LIST_HPP__
+
+#include <cstdint>
+
+#include "types.hpp"
+#include "../message/types.hpp"
+
+namespace CoAP{
+namespace Proxy{
+
+template<typename Exchange,
+		unsigned Size>
+class exchange_list{
+	public:
+		using exchange_t = Exchange;
+		using endpoint = typename Exchange::endpoint_t;
+
+		exchange_list();
+
+		constexpr unsigned size() const noexcept{ return Size; }
+
+		/**
+		 * If all slots are used, the done exchange that expires first
+		 * is reused
+		 */
+		Exchange* find_free_slot() noexcept;
+		/**
+		 * Search a request from client (duplicated request)
+		 */
+		Exchange* find_client(endpoint const&, std::uint16_t mid) noexcept;
+		/**
+		 * Search a ACK/RST from client to a message sent by the proxy
+		 */
+		Exchange* find_notify(endpoint const&, std::uint16_t mid) noexcept;
+		/**
+		 * Search a response from server. Empty messages are matched by message ID,
+		 * all others by token
+		 */
+		Exchange* find_server(endpoint const&, CoAP::Message::message const&) noexcept;
+
+		Exchange* operator[](unsigned index) noexcept
+		{
+			return index >= Size ? nullptr : &list_[index];
+		}
+	private:
+		Exchange	list_[Size];
+};
+
+}//Proxy
+}//CoAP
+
+#include "impl/exchange_list_impl.hpp"
+
+#endif /* COAP_TE_PROXY_EXCHANGE_LIST_HPP__ */
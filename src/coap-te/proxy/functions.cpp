@@ -0,0 +1,56 @@
+#include <cstring>
+
+#include "functions.hpp"
+#include "../internal/helper.hpp"
+
+namespace CoAP{
+namespace Proxy{
+
+std::size_t rewrite_header(std::uint8_t* buffer, std::size_t size, std::size_t buffer_len,
+		CoAP::Message::type mtype, std::uint16_t mid,
+		void const* token, std::size_t token_len,
+		CoAP::Error& ec) noexcept
+{
+	if(token_len > 8)
+	{
+		ec = CoAP::errc::invalid_token_length;
+		return size;
+	}
+
+	std::size_t old_token_len = buffer[0] & 0x0F;
+	if(size < (4 + old_token_len))
+	{
+		ec = CoAP::errc::message_too_small;
+		return size;
+	}
+
+	std::size_t rest = size - 4 - old_token_len;
+	if(token_len > old_token_len)
+	{
+		std::size_t diff = token_len - old_token_len;
+		if((size + diff) > buffer_len)
+		{
+			ec = CoAP::errc::insufficient_buffer;
+			return size;
+		}
+		if(rest) CoAP::Helper::shift_right(buffer + 4 + old_token_len, rest, diff);
+		size += diff;
+	}
+	else if(token_len < old_token_len)
+	{
+		std::size_t diff = old_token_len - token_len;
+		if(rest) CoAP::Helper::shift_left(buffer + 4 + token_len, rest, diff);
+		size -= diff;
+	}
+
+	buffer[0] = static_cast<std::uint8_t>((CoAP::Message::version << 6)
+					| (static_cast<std::uint8_t>(mtype) << 4)
+					| token_len);
+	CoAP::Helper::interger_to_big_endian_array(&buffer[2], mid);
+	std::memcpy(buffer + 4, token, token_len);
+
+	return size;
+}
+
+}//Proxy
+}//CoAP
@@ -0,0 +1,27 @@
+#ifndef COAP_TE_PROXY_FUNCTIONS_HPP__
+#define COAP_TE_PROXY_FUNCTIONS_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../error.hpp"
+#include "../message/types.hpp"
+
+namespace CoAP{
+namespace Proxy{
+
+/**
+ * Rewrite type, message ID and token of a serialized message in place. If
+ * the token length changes, options and payload are shifted inside the buffer.
+ *
+ * Returns the new message size.
+ */
+std::size_t rewrite_header(std::uint8_t* buffer, std::size_t size, std::size_t buffer_len,
+		CoAP::Message::type, std::uint16_t mid,
+		void const* token, std::size_t token_len,
+		CoAP::Error&) noexcept;
+
+}//Proxy
+}//CoAP
+
+#endif /* COAP_TE_PROXY_FUNCTIONS_HPP__ */
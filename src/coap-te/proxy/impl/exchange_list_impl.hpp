@@ -0,0 +1,98 @@
+#ifndef COAP_TE_PROXY_EXCHANGE_LIST_IMPL_HPP__
+#define COAP_TE_PROXY_EXCHANGE_LIST_IMPL_HPP__
+
+#include <cstring>
+
+#include "../exchange_list.hpp"
+
+namespace CoAP{
+namespace Proxy{
+
+template<typename Exchange,
+		unsigned Size>
+exchange_list<Exchange, Size>::exchange_list()
+{
+	static_assert(Size > 0, "Exchange list size (capacity) must be > 0");
+}
+
+template<typename Exchange,
+		unsigned Size>
+Exchange*
+exchange_list<Exchange, Size>::
+find_free_slot() noexcept
+{
+	Exchange* done = nullptr;
+	for(unsigned i = 0; i < Size; i++)
+	{
+		if(!list_[i].used)
+			return &list_[i];
+		if(list_[i].done && !list_[i].upstream_ack
+			&& (!done || list_[i].expiration < done->expiration))
+			done = &list_[i];
+	}
+
+	if(done) done->clear();
+	return done;
+}
+
+template<typename Exchange,
+		unsigned Size>
+Exchange*
+exchange_list<Exchange, Size>::
+find_client(endpoint const& ep, std::uint16_t mid) noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+		if(list_[i].used
+			&& list_[i].client_mid == mid
+			&& list_[i].client == ep)
+			return &list_[i];
+
+	return nullptr;
+}
+
+template<typename Exchange,
+		unsigned Size>
+Exchange*
+exchange_list<Exchange, Size>::
+find_notify(endpoint const& ep, std::uint16_t mid) noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+		if(list_[i].used
+			&& list_[i].acked
+			&& list_[i].notify_mid == mid
+			&& list_[i].client == ep)
+			return &list_[i];
+
+	return nullptr;
+}
+
+template<typename Exchange,
+		unsigned Size>
+Exchange*
+exchange_list<Exchange, Size>::
+find_server(endpoint const& ep, CoAP::Message::message const& msg) noexcept
+{
+	if(msg.mcode == CoAP::Message::code::empty)
+	{
+		for(unsigned i = 0; i < Size; i++)
+			if(list_[i].used
+				&& list_[i].server_mid == msg.mid
+				&& list_[i].server == ep)
+				return &list_[i];
+		return nullptr;
+	}
+
+	if(msg.token_len != token_size) return nullptr;
+	for(unsigned i = 0; i < Size; i++)
+		if(list_[i].used
+			&& std::memcmp(list_[i].server_token, msg.token, token_size) == 0
+			&& list_[i].server == ep)
+			return &list_[i];
+
+	return nullptr;
+}
+
+}//Proxy
+}//CoAP
+
+#endif /* COAP_TE_PROXY_EXCHANGE_LIST_IMPL_HPP__ */
@@ -0,0 +1,673 @@
+#ifndef COAP_TE_PROXY_PROXY_IMPL_HPP__
+#define COAP_TE_PROXY_PROXY_IMPL_HPP__
+
+#include <cstring>
+
+#include "../proxy.hpp"
+#include "../../log.hpp"
+#include "../../internal/helper.hpp"
+#include "../../message/parser.hpp"
+#include "../../message/serialize.hpp"
+#include "../../message/options/parser.hpp"
+#include "../../message/options/functions2.hpp"
+#include "../../transmission/functions.hpp"
+#include "../../uri/decompose.hpp"
+#include "../../cache/functions.hpp"
+
+namespace CoAP{
+namespace Proxy{
+
+static constexpr CoAP::Log::module proxy_mod = {
+		/*.name = */"PROXY",
+		/*.max_level = */CoAP::Log::type::debug,
+		/*.enable = */true
+};
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+proxy(Connection&& downstream, Connection&& upstream, MessageID&& message_id)
+	: down_(std::move(downstream)), up_(std::move(upstream)), mid_(std::move(message_id)),
+	  token_(CoAP::random_generator()){}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+proxy(Connection&& downstream, Connection&& upstream, MessageID&& message_id,
+		CoAP::Transmission::configure const& config)
+	: down_(std::move(downstream)), up_(std::move(upstream)), mid_(std::move(message_id)),
+	  token_(CoAP::random_generator()), config_(config){}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+void
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+upstream(endpoint const& ep) noexcept
+{
+	upstream_ = ep;
+	has_upstream_ = true;
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+void
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+forward(forward_cb cb, void* data /* = nullptr */) noexcept
+{
+	forward_cb_ = cb;
+	forward_data_ = data;
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+typename proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::cache_t&
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+cache() noexcept
+{
+	static_assert(has_cache, "Cache not enabled");
+	return cache_;
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+double
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+lifetime() const noexcept
+{
+	return CoAP::Transmission::max_transmist_wait(config_) * 1000;
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+void
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+reply(endpoint& ep, CoAP::Message::message const& msg, CoAP::Message::code mcode) noexcept
+{
+	CoAP::Error ec;
+	std::size_t size = CoAP::Transmission::make_response_code_error(msg, out_, packet_size, mcode);
+	down_.send(out_, size, ep, ec);
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+void
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+reply(exchange_t& ex, CoAP::Message::code mcode) noexcept
+{
+	CoAP::Error ec;
+	bool piggyback = ex.client_type == CoAP::Message::type::confirmable && !ex.acked;
+	std::size_t size = CoAP::Message::serialize(out_, packet_size,
+			piggyback ? CoAP::Message::type::acknowledgment : CoAP::Message::type::nonconfirmable,
+			mcode,
+			piggyback ? ex.client_mid : mid_(),
+			ex.client_token, ex.client_token_len,
+			static_cast<CoAP::Message::Option::node*>(nullptr),
+			nullptr, 0, ec);
+	if(!ec) down_.send(out_, size, ex.client, ec);
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+bool
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+forward_request(exchange_t& ex, endpoint& ep,
+		CoAP::Message::message const& msg, std::size_t size,
+		bool resolve, CoAP::Error& ec) noexcept
+{
+	using namespace CoAP::Message;
+
+	bool add_hop = false;
+#if COAP_TE_OPTION_HOP_LIMIT == 1
+	/**
+	 * https://tools.ietf.org/html/rfc8768#section-3
+	 */
+	Option::option hop;
+	if(Option::get_option(msg, hop, Option::code::hop_limit))
+	{
+		unsigned value = Option::parse_unsigned(hop);
+		if(value <= 1)
+		{
+			reply(ep, msg, code::hop_limit_reached);
+			return false;
+		}
+		CoAP::Helper::interger_to_big_endian_array(
+				buffer_ + (static_cast<std::uint8_t const*>(hop.value) - buffer_),
+				value - 1, hop.length);
+	}
+	else
+		add_hop = true;
+#endif /* COAP_TE_OPTION_HOP_LIMIT == 1 */
+
+	Option::List list;
+	alignas(Option::node) std::uint8_t uri_nodes[sizeof(Option::node) * max_forward_options];
+
+	Option::option puri;
+	bool forward = Option::get_option(msg, puri, Option::code::proxy_uri);
+	if(!forward)
+	{
+		if(resolve)
+		{
+			if(!has_upstream_)
+			{
+				status(proxy_mod, "Upstream not set");
+				reply(ep, msg, code::proxying_not_supported);
+				return false;
+			}
+			ex.server = upstream_;
+		}
+
+		/**
+		 * Reverse proxy: just the header is rewritten
+		 */
+		if(!add_hop)
+		{
+			size = rewrite_header(buffer_, size, packet_size,
+					msg.mtype, ex.server_mid,
+					ex.server_token, token_size, ec);
+			if(ec) return false;
+
+			up_.send(buffer_, size, ex.server, ec);
+			return !ec;
+		}
+	}
+	else
+	{
+		/**
+		 * Forward proxy: Proxy-Uri converted to Uri-Path/Uri-Query
+		 */
+		if(puri.length > max_proxy_uri_length)
+		{
+			reply(ep, msg, code::bad_option);
+			return false;
+		}
+
+		char uri_str[max_proxy_uri_length + 1];
+		std::memcpy(uri_str, puri.value, puri.length);
+		uri_str[puri.length] = '\0';
+
+		CoAP::URI::uri<CoAP::URI::ip_type> uri;
+		if(!CoAP::URI::decompose(uri, uri_str))
+		{
+			status(proxy_mod, "Proxy-Uri invalid");
+			reply(ep, msg, code::bad_option);
+			return false;
+		}
+
+		if(resolve)
+		{
+			if(!forward_cb_ || !forward_cb_(uri, ex.server, forward_data_))
+			{
+				status(proxy_mod, "Proxy-Uri not resolved");
+				reply(ep, msg, code::proxying_not_supported);
+				return false;
+			}
+		}
+
+		std::size_t uri_nodes_len = sizeof(uri_nodes);
+		if(!CoAP::URI::decompose_to_list(uri_nodes, uri_nodes_len, uri, list))
+		{
+			reply(ep, msg, code::request_entity_too_large);
+			return false;
+		}
+	}
+
+	Option::node nodes[max_forward_options];
+	unsigned node_num = 0;
+	Option::Parser<Option::code> parser(msg);
+	Option::option const* opt;
+	while((opt = parser.next()) != nullptr)
+	{
+		if(forward
+			&& (opt->ocode == Option::code::proxy_uri
+			|| opt->ocode == Option::code::proxy_scheme
+			|| opt->ocode == Option::code::uri_host
+			|| opt->ocode == Option::code::uri_port
+			|| opt->ocode == Option::code::uri_path
+			|| opt->ocode == Option::code::uri_query))
+			continue;
+		if(node_num == max_forward_options)
+		{
+			reply(ep, msg, code::request_entity_too_large);
+			return false;
+		}
+		nodes[node_num].value = *opt;
+		list.add(nodes[node_num++]);
+	}
+
+#if COAP_TE_OPTION_HOP_LIMIT == 1
+	unsigned hop_value = default_hop_limit;
+	Option::node hop_node;
+	if(add_hop)
+	{
+		hop_node.value = Option::option{Option::code::hop_limit, hop_value};
+		list.add(hop_node);
+	}
+#endif /* COAP_TE_OPTION_HOP_LIMIT == 1 */
+
+	size = serialize(out_, packet_size,
+				msg.mtype, msg.mcode, ex.server_mid,
+				ex.server_token, token_size,
+				list,
+				msg.payload, msg.payload_len,
+				ec);
+	if(ec) return false;
+
+	up_.send(out_, size, ex.server, ec);
+	return !ec;
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+void
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+process_downstream(endpoint& ep, std::size_t size, CoAP::Error& ec) noexcept
+{
+	using namespace CoAP::Message;
+
+	message msg;
+	parse(msg, buffer_, size, ec);
+	if(ec)
+	{
+		if(ec == CoAP::errc::insufficient_buffer)
+			reply(ep, msg, code::request_entity_too_large);
+		return;
+	}
+
+	if(!is_request(msg.mcode))
+	{
+		exchange_t* ex = list_.find_notify(ep, msg.mid);
+		if(!ex) return;
+
+		/**
+		 * Client acknowledging/rejecting a separate response or notification:
+		 * the confirmable from server is only acknowledged/rejected now
+		 */
+		if(ex->upstream_ack
+			&& (msg.mtype == type::acknowledgment || msg.mtype == type::reset))
+		{
+			std::size_t s = empty_message(msg.mtype, out_, packet_size, ex->upstream_mid, ec);
+			up_.send(out_, s, ex->server, ec);
+			ex->upstream_ack = false;
+		}
+		if(msg.mtype == type::reset) ex->clear();
+		return;
+	}
+
+	exchange_t* ex = list_.find_client(ep, msg.mid);
+	if(ex)
+	{
+		debug(proxy_mod, "[%04X] Duplicated request", msg.mid);
+		/**
+		 * Already responded: the response is sent again (not forwarded
+		 * upstream, the request must be processed only once)
+		 *
+		 * https://tools.ietf.org/html/rfc7252#section-4.5
+		 */
+		if(ex->done)
+		{
+			if(ex->response_len)
+				down_.send(ex->response, ex->response_len, ep, ec);
+			return;
+		}
+		forward_request(*ex, ep, msg, size, false, ec);
+		return;
+	}
+
+	bool observe = false;
+#if COAP_TE_OBSERVABLE_RESOURCE == 1
+	Option::option obs;
+	observe = Option::get_option(msg, obs, Option::code::observe);
+#endif /* COAP_TE_OBSERVABLE_RESOURCE == 1 */
+
+	std::uint32_t key = 0, resource = 0;
+	std::uint8_t key_data[exchange_t::key_size];
+	std::size_t key_len = 0;
+	bool cacheable = false;
+	if constexpr(has_cache)
+	{
+		key = CoAP::Cache::key(msg);
+		resource = CoAP::Cache::resource_key(msg);
+
+		CoAP::Error eck;
+		key_len = CoAP::Cache::key_data(msg, key_data, exchange_t::key_size, eck);
+		cacheable = !eck;
+		if(cacheable && msg.mcode == code::get && !observe)
+		{
+			auto const* entry = cache_.find(key, key_data, key_len);
+			if(entry)
+			{
+				debug(proxy_mod, "[%04X] Response from cache", msg.mid);
+				bool con = msg.mtype == type::confirmable;
+				std::size_t s = Cache::serialize(*entry, out_, packet_size,
+						con ? type::acknowledgment : type::nonconfirmable,
+						con ? msg.mid : mid_(),
+						msg.token, msg.token_len, ec);
+				if(!ec) down_.send(out_, s, ep, ec);
+				return;
+			}
+		}
+	}
+
+	ex = list_.find_free_slot();
+	if(!ex)
+	{
+		status(proxy_mod, "No free exchange slot");
+		reply(ep, msg, code::service_unavaiable);
+		return;
+	}
+
+	ex->client = ep;
+	ex->client_type = msg.mtype;
+	ex->client_mid = msg.mid;
+	ex->client_token_len = msg.token_len;
+	std::memcpy(ex->client_token, msg.token, msg.token_len);
+
+	ex->server_mid = mid_();
+	CoAP::Helper::interger_to_big_endian_array(ex->server_token, token_++, token_size);
+
+	ex->mcode = msg.mcode;
+	ex->key = key;
+	ex->resource = resource;
+	ex->cacheable = cacheable;
+	ex->key_len = cacheable ? key_len : 0;
+	if(ex->key_len) std::memcpy(ex->key_data, key_data, key_len);
+	ex->expiration = static_cast<CoAP::time_t>(static_cast<double>(CoAP::time()) + lifetime());
+
+	if(forward_request(*ex, ep, msg, size, true, ec))
+	{
+		debug(proxy_mod, "[%04X] Forwarded [%04X]", ex->client_mid, ex->server_mid);
+		ex->used = true;
+	}
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+void
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+process_upstream(endpoint& ep, std::size_t size, CoAP::Error& ec) noexcept
+{
+	using namespace CoAP::Message;
+
+	message msg;
+	parse(msg, buffer_, size, ec);
+	if(ec) return;
+
+	if(is_request(msg.mcode))
+	{
+		ec = CoAP::errc::request_not_supported;
+		return;
+	}
+
+	exchange_t* ex = list_.find_server(ep, msg);
+	if(!ex)
+	{
+		if(msg.mtype == type::confirmable)
+		{
+			std::size_t s = empty_message(type::reset, out_, packet_size, msg.mid, ec);
+			up_.send(out_, s, ep, ec);
+		}
+		return;
+	}
+
+	if(msg.mcode == code::empty)
+	{
+		if(ex->done) return;
+		if(msg.mtype == type::reset)
+		{
+			std::size_t s = empty_message(type::reset, out_, packet_size, ex->client_mid, ec);
+			down_.send(out_, s, ex->client, ec);
+			ex->clear();
+			return;
+		}
+		/**
+		 * Server will send a separate response
+		 */
+		if(msg.mtype == type::acknowledgment
+			&& ex->client_type == type::confirmable
+			&& !ex->acked)
+		{
+			std::size_t s = empty_message(type::acknowledgment, out_, packet_size, ex->client_mid, ec);
+			down_.send(out_, s, ex->client, ec);
+			ex->acked = true;
+		}
+		return;
+	}
+
+	/**
+	 * Server retransmission: client didn't acknowledged yet, so it's
+	 * forwarded again (same message ID); else, acknowledged again.
+	 */
+	if(msg.mtype == type::confirmable
+		&& ex->has_upstream_mid
+		&& ex->upstream_mid == msg.mid)
+	{
+		if(ex->upstream_ack)
+		{
+			size = rewrite_header(buffer_, size, packet_size,
+					type::confirmable, ex->notify_mid,
+					ex->client_token, ex->client_token_len, ec);
+			if(!ec) down_.send(buffer_, size, ex->client, ec);
+		}
+		else
+		{
+			std::size_t s = empty_message(type::acknowledgment, out_, packet_size, msg.mid, ec);
+			up_.send(out_, s, ep, ec);
+		}
+		return;
+	}
+
+	if(ex->done)
+	{
+		if(msg.mtype == type::confirmable)
+		{
+			std::size_t s = empty_message(type::reset, out_, packet_size, msg.mid, ec);
+			up_.send(out_, s, ep, ec);
+		}
+		return;
+	}
+
+	/**
+	 * Confirmable is only acknowledged to the server when the client
+	 * acknowledge it
+	 */
+	ex->upstream_mid = msg.mid;
+	ex->has_upstream_mid = true;
+	ex->upstream_ack = msg.mtype == type::confirmable;
+
+	bool observe = false;
+#if COAP_TE_OBSERVABLE_RESOURCE == 1
+	Option::option obs;
+	observe = is_success(msg.mcode) && Option::get_option(msg, obs, Option::code::observe);
+#endif /* COAP_TE_OBSERVABLE_RESOURCE == 1 */
+
+	if constexpr(has_cache)
+	{
+		if(ex->mcode == code::get)
+		{
+			if(!observe && ex->cacheable && CoAP::Cache::is_cachable(msg.mcode))
+				cache_.add(ex->key, ex->key_data, ex->key_len, ex->resource, msg, buffer_);
+		}
+		else if(CoAP::Cache::is_mark_not_fresh(msg.mcode))
+			cache_.invalidate(ex->resource);
+	}
+
+	type mtype;
+	std::uint16_t mid;
+	if(msg.mtype == type::acknowledgment
+		&& ex->client_type == type::confirmable
+		&& !ex->acked)
+	{
+		mtype = type::acknowledgment;
+		mid = ex->client_mid;
+	}
+	else
+	{
+		mtype = msg.mtype == type::confirmable ? type::confirmable : type::nonconfirmable;
+		mid = mid_();
+	}
+	ex->acked = true;
+	ex->notify_mid = mid;
+
+	size = rewrite_header(buffer_, size, packet_size,
+			mtype, mid,
+			ex->client_token, ex->client_token_len, ec);
+	if(ec) return;
+	down_.send(buffer_, size, ex->client, ec);
+
+	if(observe)
+	{
+		ex->observe = true;
+		ex->expiration = static_cast<CoAP::time_t>(static_cast<double>(CoAP::time())
+							+ CoAP::Cache::max_age(msg) * 1000 + lifetime());
+		return;
+	}
+
+	/**
+	 * Kept to answer duplicated requests
+	 */
+	ex->done = true;
+	ex->response_len = 0;
+	if(size <= exchange_t::response_size)
+	{
+		std::memcpy(ex->response, buffer_, size);
+		ex->response_len = size;
+	}
+	ex->expiration = static_cast<CoAP::time_t>(static_cast<double>(CoAP::time())
+						+ CoAP::Transmission::max_transmit_span(config_) * 1000);
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+void
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+check_exchanges() noexcept
+{
+	CoAP::time_t now = CoAP::time();
+	exchange_t* ex;
+	unsigned i = 0;
+	while((ex = list_[i++]) != nullptr)
+	{
+		if(!ex->used || ex->expiration > now) continue;
+
+		if(!ex->observe && !ex->done)
+		{
+			status(proxy_mod, "[%04X] Upstream timeout", ex->client_mid);
+			reply(*ex, CoAP::Message::code::gateway_timeout);
+		}
+		ex->clear();
+	}
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+template<int BlockTimeMs>
+bool
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+run(CoAP::Error& ec) noexcept
+{
+	endpoint ep;
+	std::size_t size;
+	bool ready[2] = {true, true};
+
+	/**
+	 * Waiting both connections, so none is starved
+	 */
+	if constexpr (BlockTimeMs != 0)
+	{
+#if COAP_TE_PORT_POSIX == 1
+		typename Connection::handler sockets[2] = {down_.native(), up_.native()};
+		if(!CoAP::Port::POSIX::wait_readable<BlockTimeMs>(sockets, 2, ready))
+		{
+			ec = CoAP::errc::socket_receive;
+			return false;
+		}
+#else /* COAP_TE_PORT_POSIX == 1 */
+		ready[0] = false;
+		size = down_.template receive<BlockTimeMs>(buffer_, packet_size, ep, ec);
+		if(ec) return false;
+		if(size) process_downstream(ep, size, ec);
+#endif /* COAP_TE_PORT_POSIX == 1 */
+	}
+
+	if(ready[0])
+	{
+		size = down_.receive(buffer_, packet_size, ep, ec);
+		if(ec) return false;
+		if(size)
+		{
+			debug(proxy_mod, "Downstream received %zu bytes", size);
+			process_downstream(ep, size, ec);
+		}
+	}
+
+	if(ready[1])
+	{
+		size = up_.receive(buffer_, packet_size, ep, ec);
+		if(ec) return false;
+		if(size)
+		{
+			debug(proxy_mod, "Upstream received %zu bytes", size);
+			process_upstream(ep, size, ec);
+		}
+	}
+
+	check_exchanges();
+
+	return true;
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache,
+	unsigned MaxPacketSize>
+bool
+proxy<Connection, MessageID, ExchangeList, Cache, MaxPacketSize>::
+operator()(CoAP::Error& ec) noexcept
+{
+	return run(ec);
+}
+
+}//Proxy
+}//CoAP
+
+#endif /* COAP_TE_PROXY_PROXY_IMPL_HPP__ */
@@ -0,0 +1,130 @@
+#ifndef COAP_TE_PROXY_PROXY_HPP__
+#define COAP_TE_PROXY_PROXY_HPP__
+
+#include <cstdint>
+#include <type_traits>
+
+#include "../defines/defaults.hpp"
+#include "../error.hpp"
+
+#include "types.hpp"
+#include "functions.hpp"
+#include "../message/types.hpp"
+#include "../transmission/types.hpp"
+
+namespace CoAP{
+namespace Proxy{
+
+/**
+ * CoAP-to-CoAP proxy
+ *
+ * https://tools.ietf.org/html/rfc7252#section-5.7
+ *
+ * Requests are received from clients at the downstream connection, and forwarded
+ * to the servers using the upstream connection. Token and message ID are mapped
+ * between both sides (the exchange list).
+ *
+ * * Reverse proxy: requests without Proxy-Uri are forwarded to the endpoint set
+ * with 'upstream'. The received buffer is forwarded as is, just the header
+ * (type/message ID/token) is rewritten;
+ * * Forward proxy: requests with Proxy-Uri are forwarded to the endpoint resolved
+ * by the 'forward' callback. The Proxy-Uri option is converted to Uri-Path/Uri-Query
+ * options.
+ *
+ * Responses to GET requests are cached (if Cache is not CoAP::disable) while fresh
+ * (Max-Age option). Unsafe requests invalidate the cache entries of the resource.
+ *
+ * The proxy does not retransmit messages. Confirmable requests relies on the client
+ * retransmission: duplicated requests are forwarded again with the same message ID
+ * while waiting the response; after, the saved response is sent again (see exchange).
+ * Confirmable responses from server are only acknowledged when the client
+ * acknowledges it (server retransmissions are forwarded).
+ *
+ * Requests without Hop-Limit are forwarded with 'default_hop_limit'.
+ */
+template<typename Connection,
+	typename MessageID,
+	typename ExchangeList,
+	typename Cache = CoAP::disable,
+	unsigned MaxPacketSize = 1152>
+class proxy{
+		using empty = struct{};
+	public:
+		using connection = Connection;
+		using endpoint = typename Connection::endpoint;
+		using exchange_list = ExchangeList;
+		using exchange_t = typename ExchangeList::exchange_t;
+		using forward_cb = CoAP::Proxy::forward_cb<endpoint>;
+
+		static constexpr const bool has_cache = !std::is_same<Cache, CoAP::disable>::value;
+		using cache_t = typename std::conditional<has_cache, Cache, empty>::type;
+
+		static constexpr const unsigned packet_size = MaxPacketSize;
+
+		proxy(Connection&& downstream, Connection&& upstream, MessageID&& message_id);
+		proxy(Connection&& downstream, Connection&& upstream, MessageID&& message_id,
+				CoAP::Transmission::configure const&);
+
+		static constexpr unsigned max_packet_size()
+		{
+			return packet_size;
+		}
+
+		constexpr Connection& downstream() noexcept{ return down_; }
+		constexpr Connection& upstream() noexcept{ return up_; }
+
+		/**
+		 * Reverse proxy: endpoint that requests without Proxy-Uri are forwarded
+		 */
+		void upstream(endpoint const&) noexcept;
+		/**
+		 * Forward proxy: resolve the endpoint of the Proxy-Uri option
+		 */
+		void forward(forward_cb, void* data = nullptr) noexcept;
+
+		cache_t& cache() noexcept;
+
+		template<int BlockTimeMs = 0>
+		bool run(CoAP::Error& ec) noexcept;
+		bool operator()(CoAP::Error& ec) noexcept;
+
+		void check_exchanges() noexcept;
+	private:
+		void process_downstream(endpoint& ep, std::size_t size, CoAP::Error&) noexcept;
+		void process_upstream(endpoint& ep, std::size_t size, CoAP::Error&) noexcept;
+
+		bool forward_request(exchange_t&, endpoint& ep,
+				CoAP::Message::message const&, std::size_t size,
+				bool resolve, CoAP::Error&) noexcept;
+
+		void reply(endpoint& ep, CoAP::Message::message const&, CoAP::Message::code) noexcept;
+		void reply(exchange_t&, CoAP::Message::code) noexcept;
+
+		double lifetime() const noexcept;
+
+		Connection		down_;
+		Connection		up_;
+		MessageID		mid_;
+
+		endpoint		upstream_;
+		bool			has_upstream_ = false;
+		forward_cb		forward_cb_ = nullptr;
+		void*			forward_data_ = nullptr;
+
+		std::uint32_t	token_;
+
+		exchange_list	list_;
+		cache_t			cache_;
+
+		CoAP::Transmission::configure	config_;
+
+		std::uint8_t	buffer_[packet_size];	///< Receive buffer (rewritten in place)
+		std::uint8_t	out_[packet_size];		///< Serialize buffer
+};
+
+}//Proxy
+}//CoAP
+
+#include "impl/proxy_impl.hpp"
+
+#endif /* COAP_TE_PROXY_PROXY_HPP__ */
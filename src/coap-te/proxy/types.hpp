@@ -0,0 +1,110 @@
+#ifndef COAP_TE_PROXY_TYPES_HPP__
+#define COAP_TE_PROXY_TYPES_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../port/port.hpp"
+#include "../message/types.hpp"
+#include "../uri/types.hpp"
+#include "../cache/cache.hpp"
+
+namespace CoAP{
+namespace Proxy{
+
+/**
+ * Size of the token the proxy uses at the upstream side
+ */
+static constexpr const std::size_t token_size = 4;
+
+//https://tools.ietf.org/html/rfc7252#section-5.10.2
+static constexpr const std::size_t max_proxy_uri_length = 1034;
+
+/**
+ * Max number of options (besides the ones created from the Proxy-Uri)
+ * forwarded at a forward-proxy request
+ */
+static constexpr const std::size_t max_forward_options = 16;
+
+/**
+ * Hop-Limit added to the requests forwarded without one
+ *
+ * https://tools.ietf.org/html/rfc8768#section-3
+ */
+static constexpr const unsigned default_hop_limit = 16;
+
+/**
+ * Forward proxy callback. Must set the upstream endpoint from the URI
+ * of the Proxy-Uri option. Returning false will reply 5.05 (Proxying Not Supported)
+ */
+template<typename Endpoint>
+using forward_cb = bool(*)(CoAP::URI::uri<CoAP::URI::ip_type> const&,
+							Endpoint&,
+							void*) noexcept;
+
+/**
+ * Exchange between a client (downstream) and a server (upstream)
+ *
+ * After the response is forwarded, the exchange is kept (done) to detect
+ * duplicated requests from the client. Responses up to ResponseSize are
+ * saved, and sent again to the duplicated requests (if 0, duplicated requests
+ * are just ignored).
+ *
+ * The cache-key options of the request (up to KeySize) are held to add the
+ * response to the cache.
+ */
+template<typename Endpoint,
+		std::size_t ResponseSize = 0,
+		std::size_t KeySize = CoAP::Cache::default_key_size>
+struct exchange{
+	using endpoint_t = Endpoint;
+	static constexpr const std::size_t response_size = ResponseSize;
+	static constexpr const std::size_t key_size = KeySize;
+
+	bool				used = false;
+	bool				acked = false;		///< Client request already acknowledged
+	bool				observe = false;	///< Forwarding notifications
+	bool				done = false;		///< Response forwarded
+	bool				upstream_ack = false;	///< Confirmable from server waiting client ACK
+
+	Endpoint			client;
+	CoAP::Message::type	client_type = CoAP::Message::type::confirmable;
+	std::uint16_t		client_mid = 0;
+	std::uint8_t		client_token[8];
+	std::size_t			client_token_len = 0;
+	std::uint16_t		notify_mid = 0;		///< Last message ID used to send a message to client
+
+	Endpoint			server;
+	std::uint16_t		server_mid = 0;
+	std::uint8_t		server_token[token_size];
+	std::uint16_t		upstream_mid = 0;	///< Message ID of the last response from server
+	bool				has_upstream_mid = false;
+
+	CoAP::Message::code	mcode = CoAP::Message::code::empty;	///< Request method
+	std::uint32_t		key = 0;			///< Cache key
+	std::uint32_t		resource = 0;		///< Cache resource key
+	std::uint8_t		key_data[KeySize];	///< Cache-key options
+	std::size_t			key_len = 0;
+	bool				cacheable = false;	///< Cache-key options fit 'key_data'
+
+	CoAP::time_t		expiration = 0;
+
+	std::uint8_t		response[ResponseSize ? ResponseSize : 1];
+	std::size_t			response_len = 0;
+
+	void clear() noexcept
+	{
+		used = false;
+		acked = false;
+		observe = false;
+		done = false;
+		upstream_ack = false;
+		has_upstream_mid = false;
+		response_len = 0;
+	}
+};
+
+}//Proxy
+}//CoAP
+
+#endif /* COAP_TE_PROXY_TYPES_HPP__ */
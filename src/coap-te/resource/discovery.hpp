@@ -40,6 +40,42 @@ std::size_t discovery(ResourceNode const& node,
 		unsigned max_depth, Criteria func,
 		CoAP::Error& ec) noexcept;
 
+/**
+ * Progressive discovery
+ *
+ * The link format is generated only at the window [offset, offset + size),
+ * i.e., the bytes of block N are generated with 'offset' = N * block size.
+ * Nothing before the window is written (only counted), and the tree
+ * walk stops at the end of the window, so large trees can be sent block by
+ * block (Block2) without a buffer to the full link format.
+ *
+ * The output is the same of the 'discovery' functions above (default criteria).
+ *
+ * There is no state between the calls: each one walks the tree from the start
+ * up to the end of its window, so serving B blocks walks O(B^2) blocks of
+ * output. For large trees, use bigger blocks (or cache the body).
+ */
+template<typename ResourceNode>
+std::size_t discovery_size(ResourceNode const&,
+		unsigned max_depth = 0) noexcept;
+
+template<typename ResourceNode>
+std::size_t discovery(ResourceNode const&,
+		std::size_t offset,
+		char* buffer, std::size_t size,
+		bool& more,
+		unsigned max_depth = 0) noexcept;
+
+/**
+ * Block2 read callback (see 'block2_read_cb'). 'node' must point to the
+ * ResourceNode to be described.
+ */
+template<typename ResourceNode>
+std::size_t discovery_read(void* buffer,
+		std::size_t offset,
+		std::size_t size,
+		void* node) noexcept;
+
 /**
  * Resource Discovery criteria
  */
@@ -0,0 +1,50 @@
+#ifndef COAP_TE_RESOURCE_DISCOVERY_CACHE_HPP__
+#define COAP_TE_RESOURCE_DISCOVERY_CACHE_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../error.hpp"
+#include "discovery.hpp"
+
+namespace CoAP{
+namespace Resource{
+
+/**
+ * Discovery (/.well-known/core) cache
+ *
+ * Holds the link format output of a resource tree. The output is generated
+ * only when the tree changes (checked by the resource root version, see
+ * 'resource_root::version'), so repeated discovery requests are served
+ * directly from the cache (as a whole, or block by block).
+ */
+template<unsigned Size>
+class discovery_cache{
+	public:
+		discovery_cache();
+
+		/**
+		 * Returns the link format of the tree, generating it if needed
+		 * (or nullptr on error).
+		 */
+		template<typename ResourceRoot>
+		char const* get(ResourceRoot const& root, std::size_t& size, CoAP::Error& ec) noexcept;
+
+		void invalidate() noexcept;
+		bool valid() const noexcept;
+
+		char const* data() const noexcept;
+		std::size_t size() const noexcept;
+	private:
+		char			buffer_[Size];
+		std::size_t		size_ = 0;
+		unsigned		version_ = 0;
+		bool			valid_ = false;
+};
+
+}//Resource
+}//CoAP
+
+#include "impl/discovery_cache_impl.hpp"
+
+#endif /* COAP_TE_RESOURCE_DISCOVERY_CACHE_HPP__ */
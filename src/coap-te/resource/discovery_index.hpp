@@ -0,0 +1,129 @@
+#ifndef COAP_TE_RESOURCE_DISCOVERY_INDEX_HPP__
+#define COAP_TE_RESOURCE_DISCOVERY_INDEX_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../error.hpp"
+#include "discovery.hpp"
+
+namespace CoAP{
+namespace Resource{
+
+/**
+ * Link format attributes indexed
+ */
+enum class link_attr : std::uint8_t{
+	resource_type = 0,		///< rt
+	interface,				///< if
+	content_type,			///< ct
+	href,
+	other
+};
+
+/**
+ * Resource discovery query filtering
+ *
+ * https://tools.ietf.org/html/rfc6690#section-4.1
+ *
+ * Index of a resource tree to filter discovery queries (as "rt=sensor",
+ * "if=core.s", "ct=40", "href=/sensors/temp"). The value may end with '*'
+ * to a prefix match ("rt=sensor.*", "href=/sens*").
+ *
+ * When built, all the nodes are recorded (in pre-order, with the parent) and
+ * the values of the 'rt', 'if' and 'ct' attributes of the descriptions are
+ * indexed (inverted index). So:
+ * * rt/if/ct: a query only visits the resources that have the value (prefix
+ * queries visit all the values indexed of the attribute);
+ * * href: the resource is found by the hash of the path (prefix queries only
+ * visit the subtree of the path);
+ * * other attributes: all the resources are visited.
+ *
+ * The index points to the resources descriptions, and is rebuilt (by 'update')
+ * when the tree changes (see 'resource_root::version'). Size is the max number
+ * of nodes, and AttrSize the max number of attribute values indexed.
+ */
+template<typename Node,
+		unsigned Size,
+		unsigned AttrSize = Size * 2>
+class discovery_index{
+	public:
+		discovery_index();
+
+		/**
+		 * Rebuild the index if the tree has changed. Returns false if the
+		 * index is full.
+		 */
+		template<typename ResourceRoot>
+		bool update(ResourceRoot const& root) noexcept;
+		bool build(Node const& root) noexcept;
+		void clear() noexcept;
+
+		unsigned size() const noexcept;
+		unsigned attributes() const noexcept;
+		bool built() const noexcept{ return built_; }
+
+		/**
+		 * Link format of the resources that match the query (or all, if
+		 * the query is empty). The same resources of the 'discovery' function
+		 * are listed (default criteria).
+		 *
+		 * Fails with 'not_built' if the index wasn't built (or the last
+		 * 'build'/'update' failed).
+		 */
+		std::size_t discovery(char const* query, std::size_t query_len,
+				char* buffer, std::size_t buffer_size,
+				CoAP::Error& ec) const noexcept;
+		/**
+		 * Uses the first Uri-Query option of the request as query
+		 */
+		template<typename Message>
+		std::size_t discovery(Message const& request,
+				char* buffer, std::size_t buffer_size,
+				CoAP::Error& ec) const noexcept;
+	private:
+		struct record{
+			Node const*		node = nullptr;
+			unsigned		parent = 0;
+			unsigned		end = 0;		///< End of the subtree (pre-order)
+			unsigned		next = 0;		///< href chain (index + 1)
+			std::uint32_t	hash = 0;		///< href hash
+		};
+
+		struct posting{
+			char const*		value = nullptr;
+			unsigned		length = 0;
+			unsigned		rec = 0;
+			unsigned		next = 0;		///< value chain (index + 1)
+			std::uint32_t	hash = 0;
+			link_attr		attr = link_attr::other;
+		};
+
+		bool add(Node const& node, unsigned parent, std::uint32_t hash) noexcept;
+		bool index_attributes(unsigned rec, char const* desc) noexcept;
+		bool add_posting(unsigned rec, link_attr attr, char const* value, unsigned length) noexcept;
+
+		bool listed(unsigned rec) const noexcept;
+		template<typename Writer>
+		void put_href(unsigned rec, Writer&) const noexcept;
+		bool match_href(unsigned rec, char const* value, std::size_t len, bool prefix) const noexcept;
+
+		record			records_[Size];
+		unsigned		count_ = 0;
+		unsigned		rhead_[Size];
+
+		posting			postings_[AttrSize];
+		unsigned		pcount_ = 0;
+		unsigned		head_[AttrSize];
+		unsigned		tail_[AttrSize];
+
+		unsigned		version_ = 0;
+		bool			built_ = false;
+};
+
+}//Resource
+}//CoAP
+
+#include "impl/discovery_index_impl.hpp"
+
+#endif /* COAP_TE_RESOURCE_DISCOVERY_INDEX_HPP__ */
@@ -0,0 +1,61 @@
+#ifndef COAP_TE_RESOURCE_DISCOVERY_CACHE_IMPL_HPP__
+#define COAP_TE_RESOURCE_DISCOVERY_CACHE_IMPL_HPP__
+
+#include "../discovery_cache.hpp"
+
+namespace CoAP{
+namespace Resource{
+
+template<unsigned Size>
+discovery_cache<Size>::discovery_cache()
+{
+	static_assert(Size > 0, "Discovery cache size must be > 0");
+}
+
+template<unsigned Size>
+template<typename ResourceRoot>
+char const* discovery_cache<Size>::get(ResourceRoot const& root,
+		std::size_t& size, CoAP::Error& ec) noexcept
+{
+	if(!valid_ || version_ != root.version())
+	{
+		valid_ = false;
+		size_ = discovery(root.node(), buffer_, Size, ec);
+		if(ec) return nullptr;
+
+		version_ = root.version();
+		valid_ = true;
+	}
+
+	size = size_;
+	return buffer_;
+}
+
+template<unsigned Size>
+void discovery_cache<Size>::invalidate() noexcept
+{
+	valid_ = false;
+}
+
+template<unsigned Size>
+bool discovery_cache<Size>::valid() const noexcept
+{
+	return valid_;
+}
+
+template<unsigned Size>
+char const* discovery_cache<Size>::data() const noexcept
+{
+	return buffer_;
+}
+
+template<unsigned Size>
+std::size_t discovery_cache<Size>::size() const noexcept
+{
+	return size_;
+}
+
+}//Resource
+}//CoAP
+
+#endif /* COAP_TE_RESOURCE_DISCOVERY_CACHE_IMPL_HPP__ */
@@ -176,7 +176,7 @@ bool default_criteria(ResourceNode const& node, path_list const& plist) noexcept
 }
 
 template<typename ResourceNode, typename Criteria>
-static std::size_t discovery_impl(ResourceNode const& node,
+static std::size_t discovery_impl(ResourceNode const& first,
 		char* buffer, std::size_t buffer_size,
 		unsigned max_depth, unsigned depth, unsigned& count,
 		path_list& list, Criteria func [[maybe_unused]],
@@ -185,13 +185,21 @@ static std::size_t discovery_impl(ResourceNode const& node,
 	if(max_depth && depth >= max_depth) return 0;
 	std::size_t offset = 0;
 
-	if constexpr(!std::is_same<decltype(func), no_criteria_type>::value)
+	/**
+	 * Siblings are iterated, only the children are recursive (the stack
+	 * depth is the tree depth, not the number of resources)
+	 */
+	for(ResourceNode const* node = &first; node; node = node->next())
 	{
-		if(func && func(node, list))
+		bool describe = true;
+		if constexpr(!std::is_same<decltype(func), no_criteria_type>::value)
+			describe = func && func(*node, list);
+
+		if(describe)
 		{
 			if(depth && count)
 			{
-				if(buffer_size > 0)
+				if(buffer_size - offset > 0)
 				{
 					buffer[offset++] = ',';
 				}
@@ -201,49 +209,22 @@ static std::size_t discovery_impl(ResourceNode const& node,
 					return offset;
 				}
 			}
-			offset += description(node.value(), &list, buffer + offset, buffer_size - offset, ec);
+			offset += description(node->value(), &list, buffer + offset, buffer_size - offset, ec);
 			count++;
 		}
-	}
-	else
-	{
-		if(depth && count)
-		{
-			if(buffer_size > 0)
-			{
-				buffer[offset++] = ',';
-			}
-			else
-			{
-				ec = CoAP::errc::insufficient_buffer;
-				return offset;
-			}
-		}
-		offset += description(node.value(), &list, buffer + offset, buffer_size - offset, ec);
-		count++;
-	}
-	if(ec) return offset;
-
-	ResourceNode const* n_node = node.next();
-	if(n_node)
-	{
-		offset += discovery_impl(*n_node, buffer + offset, buffer_size - offset, max_depth,
-				depth, count, list, func, ec);
 		if(ec) return offset;
-	}
 
-	path_node n{node.value().path()};
-	list.add<false>(n);
-	depth += 1;
-	ResourceNode const* children = node.children();
-	if(children)
-	{
-		offset += discovery_impl(*children, buffer + offset, buffer_size - offset, max_depth,
-				depth, count, list, func, ec);
-		if(ec) return offset;
-		children = children->next();
+		ResourceNode const* children = node->children();
+		if(children)
+		{
+			path_node n{node->value().path()};
+			list.add<false>(n);
+			offset += discovery_impl(*children, buffer + offset, buffer_size - offset, max_depth,
+					depth + 1, count, list, func, ec);
+			list.remove(n);
+			if(ec) return offset;
+		}
 	}
-	list.remove(n);
 
 	return offset;
 }
@@ -282,6 +263,149 @@ std::size_t discovery(ResourceNode const& node,
 			list, func, ec);
 }
 
+/**
+ * Writes only the bytes that fall into the window [offset, offset + size)
+ */
+struct link_format_window{
+	char*			buffer;
+	std::size_t		offset;
+	std::size_t		size;
+	std::size_t		pos = 0;
+
+	void put(char const* data, std::size_t len) noexcept
+	{
+		std::size_t end = offset + size;
+		if(pos < end && pos + len > offset)
+		{
+			std::size_t begin = pos < offset ? offset - pos : 0;
+			std::size_t last = pos + len > end ? end - pos : len;
+			std::memcpy(buffer + (pos + begin - offset), data + begin, last - begin);
+		}
+		pos += len;
+	}
+
+	void put(char c) noexcept
+	{
+		put(&c, 1);
+	}
+
+	/**
+	 * Past the window (there is more data after the window)
+	 */
+	bool done() const noexcept
+	{
+		return buffer && pos > offset + size;
+	}
+
+	std::size_t written() const noexcept
+	{
+		if(pos <= offset) return 0;
+		return pos - offset > size ? size : pos - offset;
+	}
+};
+
+template<typename Resource>
+static void description(Resource const& res,
+		path_list const& parents_path,
+		link_format_window& window) noexcept
+{
+	window.put('<');
+	for(path_node const* n = parents_path.head(); n; n = n->next)
+	{
+		if(n->value) window.put(n->value, std::strlen(n->value));
+		window.put('/');
+	}
+
+	std::size_t size_path = res.path() ? std::strlen(res.path()) : 0;
+	if(size_path)
+		window.put(res.path(), size_path);
+	else
+		window.put('/');
+	window.put('>');
+
+	if constexpr(Resource::has_description)
+	{
+		std::size_t size_desc = res.description() ?
+									std::strlen(res.description()) : 0;
+		if(size_desc)
+		{
+			window.put(';');
+			window.put(res.description(), size_desc);
+		}
+	}
+}
+
+template<typename ResourceNode>
+static void discovery_impl(ResourceNode const& first,
+		link_format_window& window,
+		unsigned max_depth, unsigned depth, unsigned& count,
+		path_list& list) noexcept
+{
+	if(max_depth && depth >= max_depth) return;
+
+	for(ResourceNode const* node = &first; node; node = node->next())
+	{
+		if(window.done()) return;
+
+		if(default_criteria(*node, list))
+		{
+			if(depth && count) window.put(',');
+			description(node->value(), list, window);
+			count++;
+		}
+
+		ResourceNode const* children = node->children();
+		if(children)
+		{
+			path_node n{node->value().path()};
+			list.add<false>(n);
+			discovery_impl(*children, window, max_depth, depth + 1, count, list);
+			list.remove(n);
+		}
+	}
+}
+
+template<typename ResourceNode>
+std::size_t discovery_size(ResourceNode const& node,
+		unsigned max_depth /* = 0 */) noexcept
+{
+	link_format_window window{nullptr, 0, 0};
+	path_list list;
+	unsigned count = 0;
+
+	discovery_impl(node, window, max_depth, 0, count, list);
+
+	return window.pos;
+}
+
+template<typename ResourceNode>
+std::size_t discovery(ResourceNode const& node,
+		std::size_t offset,
+		char* buffer, std::size_t size,
+		bool& more,
+		unsigned max_depth /* = 0 */) noexcept
+{
+	link_format_window window{buffer, offset, size};
+	path_list list;
+	unsigned count = 0;
+
+	discovery_impl(node, window, max_depth, 0, count, list);
+	more = window.done();
+
+	return window.written();
+}
+
+template<typename ResourceNode>
+std::size_t discovery_read(void* buffer,
+		std::size_t offset,
+		std::size_t size,
+		void* node) noexcept
+{
+	bool more;
+	return discovery(*static_cast<ResourceNode const*>(node), offset,
+			static_cast<char*>(buffer), size, more);
+}
+
 }//Resource
 }//CoAP
 
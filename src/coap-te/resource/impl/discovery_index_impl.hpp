@@ -0,0 +1,448 @@
+#ifndef COAP_TE_RESOURCE_DISCOVERY_INDEX_IMPL_HPP__
+#define COAP_TE_RESOURCE_DISCOVERY_INDEX_IMPL_HPP__
+
+#include <cstring>
+
+#include "../discovery_index.hpp"
+#include "../../cache/functions.hpp"
+#include "../../message/options/options.hpp"
+#include "../../message/options/parser.hpp"
+
+namespace CoAP{
+namespace Resource{
+
+inline link_attr link_attr_type(char const* name, std::size_t len) noexcept
+{
+	if(len == 2)
+	{
+		if(std::strncmp(name, "rt", 2) == 0) return link_attr::resource_type;
+		if(std::strncmp(name, "if", 2) == 0) return link_attr::interface;
+		if(std::strncmp(name, "ct", 2) == 0) return link_attr::content_type;
+	}
+	else if(len == 4 && std::strncmp(name, "href", 4) == 0) return link_attr::href;
+	return link_attr::other;
+}
+
+inline std::uint32_t link_attr_hash(link_attr attr, char const* value, std::size_t len) noexcept
+{
+	std::uint8_t a = static_cast<std::uint8_t>(attr);
+	return CoAP::Cache::hash(value, len, CoAP::Cache::hash(&a, 1));
+}
+
+inline bool link_value_match(char const* value, std::size_t len,
+		char const* query, std::size_t query_len, bool prefix) noexcept
+{
+	if(prefix)
+		return len >= query_len && std::strncmp(value, query, query_len) == 0;
+	return len == query_len && std::strncmp(value, query, len) == 0;
+}
+
+/**
+ * Calls 'func(name, name_len, value, value_len)' to each attribute of the
+ * description. Quotes are removed, and values of 'rt', 'if' and 'ct' are
+ * split at spaces (one call to each value).
+ */
+template<typename Func>
+static bool link_attr_for_each(char const* desc, Func&& func) noexcept
+{
+	if(!desc) return true;
+
+	char const* p = desc;
+	while(*p)
+	{
+		char const* name = p;
+		for(; *p && *p != '=' && *p != ';'; p++);
+		std::size_t name_len = p - name;
+
+		char const* value = nullptr;
+		std::size_t value_len = 0;
+		if(*p == '=')
+		{
+			value = ++p;
+			bool quote = false;
+			for(; *p && (quote || *p != ';'); p++)
+				if(*p == '"') quote = !quote;
+			value_len = p - value;
+			if(value_len >= 2
+				&& (value[0] == '"' || value[0] == '\'')
+				&& value[value_len - 1] == value[0])
+			{
+				value++;
+				value_len -= 2;
+			}
+		}
+		if(*p == ';') p++;
+
+		if(!value || link_attr_type(name, name_len) == link_attr::other)
+		{
+			if(!func(name, name_len, value, value_len)) return false;
+			continue;
+		}
+
+		char const* end = value + value_len;
+		while(value < end)
+		{
+			char const* v = value;
+			for(; value < end && *value != ' '; value++);
+			if(value > v && !func(name, name_len, v, static_cast<std::size_t>(value - v)))
+				return false;
+			for(; value < end && *value == ' '; value++);
+		}
+	}
+	return true;
+}
+
+/**
+ * Compares the written data to a value
+ */
+struct link_format_compare{
+	char const*		value;
+	std::size_t		len;
+	std::size_t		pos = 0;
+	bool			equal = true;
+
+	void put(char const* data, std::size_t size) noexcept
+	{
+		if(equal && pos < len)
+		{
+			std::size_t n = size < len - pos ? size : len - pos;
+			equal = std::strncmp(value + pos, data, n) == 0;
+		}
+		pos += size;
+	}
+
+	void put(char c) noexcept
+	{
+		put(&c, 1);
+	}
+};
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+discovery_index<Node, Size, AttrSize>::discovery_index()
+{
+	static_assert(Size > 0, "Discovery index size must be > 0");
+	static_assert(AttrSize > 0, "Discovery index attribute size must be > 0");
+	clear();
+}
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+void discovery_index<Node, Size, AttrSize>::clear() noexcept
+{
+	count_ = 0;
+	pcount_ = 0;
+	for(unsigned i = 0; i < Size; i++) rhead_[i] = 0;
+	for(unsigned i = 0; i < AttrSize; i++) head_[i] = tail_[i] = 0;
+	built_ = false;
+}
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+unsigned discovery_index<Node, Size, AttrSize>::size() const noexcept
+{
+	return count_;
+}
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+unsigned discovery_index<Node, Size, AttrSize>::attributes() const noexcept
+{
+	return pcount_;
+}
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+template<typename ResourceRoot>
+bool discovery_index<Node, Size, AttrSize>::update(ResourceRoot const& root) noexcept
+{
+	if(built_ && version_ == root.version()) return true;
+
+	version_ = root.version();
+	return build(root.node());
+}
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+bool discovery_index<Node, Size, AttrSize>::build(Node const& root) noexcept
+{
+	clear();
+	built_ = add(root, 0, CoAP::Cache::hash("/", 1));
+	return built_;
+}
+
+/**
+ * Pre-order: the subtree of a record are the records [index + 1, end)
+ */
+template<typename Node, unsigned Size, unsigned AttrSize>
+bool discovery_index<Node, Size, AttrSize>::add(Node const& node,
+		unsigned parent, std::uint32_t hash) noexcept
+{
+	if(count_ == Size) return false;
+
+	unsigned index = count_++;
+	record& rec = records_[index];
+	rec.node = &node;
+	rec.parent = parent;
+	rec.hash = hash;
+	rec.next = rhead_[hash % Size];
+	rhead_[hash % Size] = index + 1;
+
+	if constexpr(Node::type::has_description)
+	{
+		if(!index_attributes(index, node.value().description())) return false;
+	}
+
+	for(Node const* child = node.children(); child; child = child->next())
+	{
+		char const* path = child->value().path();
+		std::uint32_t h = index ? CoAP::Cache::hash("/", 1, hash) : hash;
+		if(path) h = CoAP::Cache::hash(path, std::strlen(path), h);
+		if(!add(*child, index, h)) return false;
+	}
+	records_[index].end = count_;
+
+	return true;
+}
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+bool discovery_index<Node, Size, AttrSize>::index_attributes(unsigned rec, char const* desc) noexcept
+{
+	return link_attr_for_each(desc,
+		[this, rec](char const* name, std::size_t name_len, char const* value, std::size_t value_len){
+			link_attr attr = link_attr_type(name, name_len);
+			if(!value || attr == link_attr::other || attr == link_attr::href) return true;
+			return add_posting(rec, attr, value, static_cast<unsigned>(value_len));
+		});
+}
+
+/**
+ * Postings are appended to the chain, so are kept at tree order
+ */
+template<typename Node, unsigned Size, unsigned AttrSize>
+bool discovery_index<Node, Size, AttrSize>::add_posting(unsigned rec, link_attr attr,
+		char const* value, unsigned length) noexcept
+{
+	if(pcount_ == AttrSize) return false;
+
+	unsigned index = pcount_++;
+	posting& p = postings_[index];
+	p.value = value;
+	p.length = length;
+	p.rec = rec;
+	p.attr = attr;
+	p.hash = link_attr_hash(attr, value, length);
+	p.next = 0;
+
+	unsigned bucket = p.hash % AttrSize;
+	if(tail_[bucket]) postings_[tail_[bucket] - 1].next = index + 1;
+	else head_[bucket] = index + 1;
+	tail_[bucket] = index + 1;
+
+	return true;
+}
+
+/**
+ * Same as 'default_criteria'
+ */
+template<typename Node, unsigned Size, unsigned AttrSize>
+bool discovery_index<Node, Size, AttrSize>::listed(unsigned rec) const noexcept
+{
+	record const& r = records_[rec];
+	if(rec && r.parent && !records_[r.parent].parent)
+	{
+		char const* parent_path = records_[r.parent].node->value().path();
+		char const* path = r.node->value().path();
+		if(parent_path && path
+			&& std::strcmp(parent_path, ".well-known") == 0
+			&& std::strcmp(path, "core") == 0) return false;
+	}
+	return r.node->value().has_callback();
+}
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+template<typename Writer>
+void discovery_index<Node, Size, AttrSize>::put_href(unsigned rec, Writer& writer) const noexcept
+{
+	if(rec == 0)
+	{
+		writer.put('/');
+		return;
+	}
+
+	record const& r = records_[rec];
+	if(r.parent) put_href(r.parent, writer);
+	writer.put('/');
+	char const* path = r.node->value().path();
+	if(path) writer.put(path, std::strlen(path));
+}
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+bool discovery_index<Node, Size, AttrSize>::match_href(unsigned rec,
+		char const* value, std::size_t len, bool prefix) const noexcept
+{
+	link_format_compare cmp{value, len};
+	put_href(rec, cmp);
+	return cmp.equal && (prefix ? cmp.pos >= len : cmp.pos == len);
+}
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+std::size_t discovery_index<Node, Size, AttrSize>::discovery(
+		char const* query, std::size_t query_len,
+		char* buffer, std::size_t buffer_size,
+		CoAP::Error& ec) const noexcept
+{
+	if(!built_)
+	{
+		ec = CoAP::errc::not_built;
+		return 0;
+	}
+
+	link_format_window window{buffer, 0, buffer_size};
+	unsigned count = 0;
+	unsigned last = Size;
+	auto emit = [&](unsigned rec){
+		if(rec == last || !listed(rec)) return;
+		last = rec;
+
+		if(count++) window.put(',');
+		window.put('<');
+		put_href(rec, window);
+		window.put('>');
+		if constexpr(Node::type::has_description)
+		{
+			char const* desc = records_[rec].node->value().description();
+			if(desc && *desc)
+			{
+				window.put(';');
+				window.put(desc, std::strlen(desc));
+			}
+		}
+	};
+
+	char const* name = query;
+	std::size_t name_len = 0;
+	for(; name_len < query_len && query[name_len] != '='; name_len++);
+	char const* value = name_len < query_len ? query + name_len + 1 : nullptr;
+	std::size_t value_len = value ? query_len - name_len - 1 : 0;
+	bool prefix = value_len && value[value_len - 1] == '*';
+	if(prefix) value_len--;
+
+	link_attr attr = link_attr_type(name, name_len);
+	if(!query_len)
+	{
+		for(unsigned i = 0; i < count_; i++) emit(i);
+	}
+	else if(attr == link_attr::href && value)
+	{
+		if(!prefix)
+		{
+			std::uint32_t hash = CoAP::Cache::hash(value, value_len);
+			for(unsigned i = rhead_[hash % Size]; i; i = records_[i - 1].next)
+			{
+				if(records_[i - 1].hash == hash
+					&& match_href(i - 1, value, value_len, false))
+					emit(i - 1);
+			}
+		}
+		else
+		{
+			/**
+			 * Searching the subtree of the last complete segment of the prefix
+			 */
+			std::size_t base_len = value_len;
+			for(; base_len && value[base_len - 1] != '/'; base_len--);
+			if(base_len > 1) base_len--;
+
+			unsigned base = count_;
+			std::uint32_t hash = CoAP::Cache::hash(value, base_len);
+			for(unsigned i = rhead_[hash % Size]; i; i = records_[i - 1].next)
+			{
+				if(records_[i - 1].hash == hash
+					&& match_href(i - 1, value, base_len, false))
+				{
+					base = i - 1;
+					break;
+				}
+			}
+			if(base < count_)
+			{
+				for(unsigned i = base; i < records_[base].end; i++)
+					if(match_href(i, value, value_len, true)) emit(i);
+			}
+		}
+	}
+	else if(attr != link_attr::other && value)
+	{
+		if(!prefix)
+		{
+			std::uint32_t hash = link_attr_hash(attr, value, value_len);
+			for(unsigned i = head_[hash % AttrSize]; i; i = postings_[i - 1].next)
+			{
+				posting const& p = postings_[i - 1];
+				if(p.hash == hash && p.attr == attr
+					&& link_value_match(p.value, p.length, value, value_len, false))
+					emit(p.rec);
+			}
+		}
+		else
+		{
+			for(unsigned i = 0; i < pcount_; i++)
+			{
+				posting const& p = postings_[i];
+				if(p.attr == attr
+					&& link_value_match(p.value, p.length, value, value_len, true))
+					emit(p.rec);
+			}
+		}
+	}
+	else
+	{
+		/**
+		 * Not indexed attribute
+		 */
+		for(unsigned i = 0; i < count_; i++)
+		{
+			if constexpr(Node::type::has_description)
+			{
+				bool found = false;
+				link_attr_for_each(records_[i].node->value().description(),
+					[&](char const* n, std::size_t n_len, char const* v, std::size_t v_len){
+						if(n_len == name_len && std::strncmp(n, name, n_len) == 0
+							&& (!value || (v && link_value_match(v, v_len, value, value_len, prefix))))
+						{
+							found = true;
+							return false;
+						}
+						return true;
+					});
+				if(found) emit(i);
+			}
+		}
+	}
+
+	if(window.pos >= buffer_size)
+	{
+		ec = CoAP::errc::insufficient_buffer;
+		return window.written();
+	}
+	buffer[window.pos] = '\0';
+
+	return window.pos;
+}
+
+template<typename Node, unsigned Size, unsigned AttrSize>
+template<typename Message>
+std::size_t discovery_index<Node, Size, AttrSize>::discovery(Message const& request,
+		char* buffer, std::size_t buffer_size,
+		CoAP::Error& ec) const noexcept
+{
+	using namespace CoAP::Message;
+
+	Option::option opt;
+	if(Option::get_option(request, opt, Option::code::uri_query))
+	{
+		return discovery(static_cast<char const*>(opt.value), opt.length,
+				buffer, buffer_size, ec);
+	}
+	return discovery(nullptr, 0, buffer, buffer_size, ec);
+}
+
+}//Resource
+}//CoAP
+
+#endif /* COAP_TE_RESOURCE_DISCOVERY_INDEX_IMPL_HPP__ */
@@ -0,0 +1,195 @@
+#ifndef COAP_TE_RESOURCE_INDEX_IMPL_HPP__
+#define COAP_TE_RESOURCE_INDEX_IMPL_HPP__
+
+#include <cstring>
+
+#include "../index.hpp"
+#include "../../cache/functions.hpp"
+
+namespace CoAP{
+namespace Resource{
+
+/**
+ * Hash of the path segment, seeded with the parent node address
+ */
+inline std::uint32_t index_hash(void const* parent, void const* segment, std::size_t len) noexcept
+{
+	return CoAP::Cache::hash(segment, len,
+				CoAP::Cache::hash(&parent, sizeof(parent)));
+}
+
+/**
+ * Literal nodes by the path, parameter/wildcard by the segment type
+ */
+template<typename Node>
+std::uint32_t node_index<Node>::key(Node const& parent, Node const& child) noexcept
+{
+	segment_type kind = child.value().kind();
+	if(kind != segment_type::literal)
+		return index_hash(&parent, &kind, sizeof(kind));
+
+	char const* path = child.value().path();
+	return index_hash(&parent, path, std::strlen(path));
+}
+
+template<typename Node>
+node_index<Node>::node_index(entry* table, unsigned capacity) noexcept
+	: table_(table), capacity_(capacity){}
+
+template<typename Node>
+unsigned node_index<Node>::capacity() const noexcept
+{
+	return capacity_;
+}
+
+template<typename Node>
+unsigned node_index<Node>::size() const noexcept
+{
+	return count_;
+}
+
+template<typename Node>
+void node_index<Node>::clear() noexcept
+{
+	for(unsigned i = 0; i < capacity_; i++)
+		table_[i] = entry{};
+	count_ = 0;
+}
+
+template<typename Node>
+bool node_index<Node>::build(Node& root) noexcept
+{
+	clear();
+	return build_children(root);
+}
+
+template<typename Node>
+bool node_index<Node>::build_children(Node& parent) noexcept
+{
+	for(Node* n = parent.children(); n; n = n->next())
+	{
+		if(!add(parent, *n)) return false;
+		if(!build_children(*n)) return false;
+	}
+	return true;
+}
+
+template<typename Node>
+bool node_index<Node>::add(Node const& parent, Node& child) noexcept
+{
+	if(count_ == capacity_) return false;
+
+	std::uint32_t hash = key(parent, child);
+	unsigned i = hash % capacity_;
+	while(table_[i].child)
+	{
+		if(table_[i].child == &child) return true;
+		i = (i + 1) % capacity_;
+	}
+
+	table_[i].parent = &parent;
+	table_[i].child = &child;
+	table_[i].hash = hash;
+	count_++;
+
+	return true;
+}
+
+template<typename Node>
+bool node_index<Node>::insert(Node const& parent, Node& child) noexcept
+{
+	return add(parent, child) && build_children(child);
+}
+
+template<typename Node>
+void node_index<Node>::erase(Node const& parent, Node& child) noexcept
+{
+	erase_children(child);
+	remove(parent, child);
+}
+
+template<typename Node>
+void node_index<Node>::erase_children(Node& parent) noexcept
+{
+	for(Node* n = parent.children(); n; n = n->next())
+	{
+		erase_children(*n);
+		remove(parent, *n);
+	}
+}
+
+/**
+ * Backward shift deletion: the following entries of the cluster are moved
+ * back, so the probe sequences stay unbroken (no tombstones)
+ */
+template<typename Node>
+void node_index<Node>::remove(Node const& parent, Node& child) noexcept
+{
+	unsigned i = key(parent, child) % capacity_;
+	for(unsigned probe = 0; table_[i].child != &child; probe++)
+	{
+		if(probe == capacity_ || !table_[i].child) return;
+		i = (i + 1) % capacity_;
+	}
+
+	table_[i] = entry{};
+	count_--;
+
+	for(unsigned j = (i + 1) % capacity_; table_[j].child; j = (j + 1) % capacity_)
+	{
+		unsigned home = table_[j].hash % capacity_;
+		bool stay = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+		if(stay) continue;
+
+		table_[i] = table_[j];
+		table_[j] = entry{};
+		i = j;
+	}
+}
+
+template<typename Node>
+Node* node_index<Node>::find(Node const& parent,
+		CoAP::Message::Option::option const& opt) const noexcept
+{
+	std::uint32_t hash = index_hash(&parent, opt.value, opt.length);
+	unsigned i = hash % capacity_;
+	for(unsigned probe = 0; probe < capacity_ && table_[i].child; probe++)
+	{
+		entry const& e = table_[i];
+		if(e.hash == hash
+			&& e.parent == &parent
+			&& e.child->value() == opt)
+			return e.child;
+		i = (i + 1) % capacity_;
+	}
+	return nullptr;
+}
+
+template<typename Node>
+Node* node_index<Node>::find_pattern(Node const& parent) const noexcept
+{
+	Node* n = find_kind(parent, segment_type::parameter);
+	return n ? n : find_kind(parent, segment_type::wildcard);
+}
+
+template<typename Node>
+Node* node_index<Node>::find_kind(Node const& parent, segment_type kind) const noexcept
+{
+	std::uint32_t hash = index_hash(&parent, &kind, sizeof(kind));
+	unsigned i = hash % capacity_;
+	for(unsigned probe = 0; probe < capacity_ && table_[i].child; probe++)
+	{
+		entry const& e = table_[i];
+		if(e.hash == hash
+			&& e.parent == &parent
+			&& e.child->value().kind() == kind)
+			return e.child;
+		i = (i + 1) % capacity_;
+	}
+	return nullptr;
+}
+
+}//Resource
+}//CoAP
+
+#endif /* COAP_TE_RESOURCE_INDEX_IMPL_HPP__ */
@@ -0,0 +1,83 @@
+#ifndef COAP_TE_RESOURCE_PATTERN_IMPL_HPP__
+#define COAP_TE_RESOURCE_PATTERN_IMPL_HPP__
+
+#include <cstring>
+
+#include "../pattern.hpp"
+
+namespace CoAP{
+namespace Resource{
+
+template<unsigned Size>
+segment_captures<Size>::segment_captures()
+{
+	static_assert(Size > 0, "Captures size must be > 0");
+}
+
+template<unsigned Size>
+bool segment_captures<Size>::add(char const* name,
+		CoAP::Message::Option::option const& opt) noexcept
+{
+	if(count_ == Size)
+	{
+		truncated_ = true;
+		return false;
+	}
+
+	segment& seg = seg_[count_++];
+	seg.name = name;
+	seg.value = static_cast<char const*>(opt.value);
+	seg.length = opt.length;
+
+	return true;
+}
+
+template<unsigned Size>
+void segment_captures<Size>::clear() noexcept
+{
+	count_ = 0;
+	truncated_ = false;
+}
+
+template<unsigned Size>
+unsigned segment_captures<Size>::size() const noexcept
+{
+	return count_;
+}
+
+template<unsigned Size>
+bool segment_captures<Size>::truncated() const noexcept
+{
+	return truncated_;
+}
+
+template<unsigned Size>
+typename segment_captures<Size>::segment const*
+segment_captures<Size>::operator[](unsigned index) const noexcept
+{
+	return index >= count_ ? nullptr : &seg_[index];
+}
+
+template<unsigned Size>
+typename segment_captures<Size>::segment const*
+segment_captures<Size>::get(char const* name) const noexcept
+{
+	if(*name == '{') name++;
+	std::size_t len = std::strlen(name);
+	if(len && name[len - 1] == '}') len--;
+
+	for(unsigned i = 0; i < count_; i++)
+	{
+		char const* n = seg_[i].name;
+		if(*n == '{') n++;
+		if(std::strncmp(n, name, len) == 0
+			&& (n[len] == '}' || n[len] == '\0'))
+			return &seg_[i];
+	}
+	return nullptr;
+}
+
+}//Resource
+}//CoAP
+
+#endif /* COAP_TE_RESOURCE_PATTERN_IMPL_HPP__ */
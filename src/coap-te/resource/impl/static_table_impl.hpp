@@ -0,0 +1,250 @@
+#ifndef COAP_TE_RESOURCE_STATIC_TABLE_IMPL_HPP__
+#define COAP_TE_RESOURCE_STATIC_TABLE_IMPL_HPP__
+
+#include <cstring>
+
+#include "../static_table.hpp"
+
+namespace CoAP{
+namespace Resource{
+
+template<typename Resource, unsigned N>
+constexpr static_table<Resource, N>::static_table(Resource const (&list)[N]) noexcept
+	: static_table(list, std::make_index_sequence<N>{}){}
+
+template<typename Resource, unsigned N>
+template<std::size_t ...I>
+constexpr static_table<Resource, N>::static_table(Resource const (&list)[N],
+		std::index_sequence<I...>) noexcept
+	: res_{list[I]...}
+{
+	static_assert(N > 0, "Static table size must be > 0");
+	static_assert(N <= 0xFFFF, "Static table size must be <= 65535 (slots are 16 bits)");
+	make_hash();
+}
+
+template<typename Resource, unsigned N>
+constexpr void static_table<Resource, N>::make_hash() noexcept
+{
+	unsigned count[N]{};
+	for(unsigned i = 0; i < N; i++)
+	{
+		hash_[i] = path_hash(res_[i].path());
+		for(unsigned j = 0; j < i; j++)
+		{
+			//Duplicated path (or hash collision): linear search
+			if(hash_[i] == hash_[j]) return;
+		}
+		count[hash_[i] % N]++;
+	}
+
+	/**
+	 * Placing the buckets from the biggest to the smallest
+	 */
+	bool done[N]{};
+	for(unsigned n = 0; n < N; n++)
+	{
+		unsigned bucket = 0, max = 0;
+		for(unsigned b = 0; b < N; b++)
+		{
+			if(!done[b] && count[b] >= max)
+			{
+				max = count[b];
+				bucket = b;
+			}
+		}
+		done[bucket] = true;
+		if(max == 0) break;
+
+		std::uint32_t seed = 0;
+		while(!place(bucket, seed))
+			if(++seed > max_seed) return;
+		disp_[bucket] = static_cast<std::uint16_t>(seed);
+	}
+
+	perfect_ = true;
+}
+
+/**
+ * Try to place all the paths of a bucket with the seed. If any slot
+ * is occupied, the placed ones are removed.
+ */
+template<typename Resource, unsigned N>
+constexpr bool static_table<Resource, N>::place(unsigned bucket, std::uint32_t seed) noexcept
+{
+	for(unsigned i = 0; i < N; i++)
+	{
+		if(hash_[i] % N != bucket) continue;
+
+		unsigned slot = path_hash_seed(hash_[i], seed) & (table_size() - 1);
+		if(slot_[slot])
+		{
+			for(unsigned j = 0; j < i; j++)
+			{
+				if(hash_[j] % N != bucket) continue;
+				unsigned s = path_hash_seed(hash_[j], seed) & (table_size() - 1);
+				slot_[s] = 0;
+			}
+			return false;
+		}
+		slot_[slot] = static_cast<std::uint16_t>(i + 1);
+	}
+	return true;
+}
+
+/**
+ * Return the index (+ 1) of the only possible resource with the hash
+ */
+template<typename Resource, unsigned N>
+constexpr unsigned static_table<Resource, N>::candidate(std::uint32_t hash) const noexcept
+{
+	unsigned index = slot_[path_hash_seed(hash, disp_[hash % N]) & (table_size() - 1)];
+	return index && hash_[index - 1] == hash ? index : 0;
+}
+
+template<typename Resource, unsigned N>
+constexpr typename static_table<Resource, N>::resource_t const*
+static_table<Resource, N>::search(char const* path) const noexcept
+{
+	if(*path == '/') path++;
+	std::uint32_t hash = path_hash(path);
+
+	auto equal = [](char const* a, char const* b){
+		for(; *a && *a == *b; a++, b++);
+		return *a == *b;
+	};
+
+	if(perfect_)
+	{
+		unsigned index = candidate(hash);
+		return index && equal(res_[index - 1].path(), path) ? &res_[index - 1] : nullptr;
+	}
+
+	for(unsigned i = 0; i < N; i++)
+		if(hash_[i] == hash && equal(res_[i].path(), path))
+			return &res_[i];
+	return nullptr;
+}
+
+template<typename Resource, unsigned N>
+template<typename Message>
+typename static_table<Resource, N>::resource_t const*
+static_table<Resource, N>::search(Message const& msg) const noexcept
+{
+	CoAP::Message::Option::Parser<CoAP::Message::Option::code> parser(msg);
+	return search(parser);
+}
+
+template<typename Resource, unsigned N>
+typename static_table<Resource, N>::resource_t const*
+static_table<Resource, N>::search(CoAP::Message::Option::Parser<CoAP::Message::Option::code>& parser) const noexcept
+{
+	using namespace CoAP::Message::Option;
+
+	std::uint32_t hash = path_hash_init;
+	bool first = true;
+	option const* opt;
+	while((opt = parser.next()))
+	{
+		if(opt->ocode != code::uri_path) continue;
+		if(!first) hash = path_hash(hash, '/');
+		first = false;
+
+		unsigned char const* v = static_cast<unsigned char const*>(opt->value);
+		for(unsigned i = 0; i < opt->length; i++)
+			hash = path_hash(hash, v[i]);
+	}
+
+	if(perfect_)
+	{
+		unsigned index = candidate(hash);
+		return index && compare(res_[index - 1].path(), parser) ? &res_[index - 1] : nullptr;
+	}
+
+	for(unsigned i = 0; i < N; i++)
+		if(hash_[i] == hash && compare(res_[i].path(), parser))
+			return &res_[i];
+	return nullptr;
+}
+
+template<typename Resource, unsigned N>
+bool static_table<Resource, N>::compare(char const* path,
+		CoAP::Message::Option::Parser<CoAP::Message::Option::code>& parser) const noexcept
+{
+	using namespace CoAP::Message::Option;
+
+	parser.reset();
+	bool first = true;
+	option const* opt;
+	while((opt = parser.next()))
+	{
+		if(opt->ocode != code::uri_path) continue;
+		if(!first && *path++ != '/') return false;
+		first = false;
+
+		/**
+		 * The segment must have the same length of the option (an option
+		 * with '\0' or '/' inside never matches)
+		 */
+		std::size_t len = 0;
+		while(path[len] != '\0' && path[len] != '/') len++;
+		if(len != opt->length || std::memcmp(path, opt->value, len) != 0)
+			return false;
+		path += len;
+	}
+	return *path == '\0';
+}
+
+template<typename Resource, unsigned N>
+constexpr std::size_t static_table<Resource, N>::link_format_size() const noexcept
+{
+	std::size_t size = 0;
+	for(unsigned i = 0; i < N; i++)
+	{
+		size += i ? 1 : 0;	// ','
+		size += 3;			// '<', '/', '>'
+		for(char const* p = res_[i].path(); *p; p++) size++;
+		char const* desc = res_[i].description();
+		if(desc && *desc)
+		{
+			size += 1;		// ';'
+			for(; *desc; desc++) size++;
+		}
+	}
+	return size + 1;
+}
+
+template<typename Resource, unsigned N>
+template<std::size_t Size>
+constexpr link_format_body<Size> static_table<Resource, N>::link_format() const noexcept
+{
+	static_assert(Size > 0, "Link format size must be > 0");
+
+	link_format_body<Size> body;
+	auto append = [&body](char c){
+		if(body.size < Size - 1) body.data[body.size++] = c;
+	};
+
+	for(unsigned i = 0; i < N; i++)
+	{
+		if(i) append(',');
+		append('<');
+		append('/');
+		for(char const* p = res_[i].path(); *p; p++) append(*p);
+		append('>');
+		char const* desc = res_[i].description();
+		if(desc && *desc)
+		{
+			append(';');
+			for(; *desc; desc++) append(*desc);
+		}
+	}
+	body.data[body.size] = '\0';
+
+	return body;
+}
+
+}//Resource
+}//CoAP
+
+#endif /* COAP_TE_RESOURCE_STATIC_TABLE_IMPL_HPP__ */
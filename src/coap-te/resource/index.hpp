@@ -0,0 +1,99 @@
+#ifndef COAP_TE_RESOURCE_INDEX_HPP__
+#define COAP_TE_RESOURCE_INDEX_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../message/options/options.hpp"
+#include "pattern.hpp"
+
+namespace CoAP{
+namespace Resource{
+
+/**
+ * Resource tree index
+ *
+ * Hash table (open addressing) of all the nodes of a resource tree, indexed
+ * by (parent node, path segment). Searching a child is O(1), no matter the
+ * number of siblings (the tree search is O(path segments)). Parameter and
+ * wildcard nodes (see 'pattern.hpp') are indexed by (parent node, segment type),
+ * so the pattern fallback of a literal miss is also O(1).
+ *
+ * The table storage is provided by the derived class (see 'resource_index').
+ * The index is built from the tree ('build'), and kept up to date as nodes are
+ * added/removed ('insert'/'erase', O(nodes inserted/erased)). For better
+ * performance, the capacity should be bigger than the number of nodes
+ * (e.g., 1.5x).
+ */
+template<typename Node>
+class node_index{
+	public:
+		struct entry{
+			Node const*		parent = nullptr;
+			Node*			child = nullptr;
+			std::uint32_t	hash = 0;
+		};
+
+		node_index(entry* table, unsigned capacity) noexcept;
+
+		unsigned capacity() const noexcept;
+		unsigned size() const noexcept;
+
+		void clear() noexcept;
+
+		/**
+		 * Index all the descendants of root. Returns false if the
+		 * table is full.
+		 */
+		bool build(Node& root) noexcept;
+		bool add(Node const& parent, Node& child) noexcept;
+
+		/**
+		 * Index/unindex 'child' and all its descendants. Insert returns false
+		 * if the table is full.
+		 */
+		bool insert(Node const& parent, Node& child) noexcept;
+		void erase(Node const& parent, Node& child) noexcept;
+
+		Node* find(Node const& parent, CoAP::Message::Option::option const&) const noexcept;
+		/**
+		 * Parameter child of parent or, if none, the wildcard child (the first
+		 * added, if more than one)
+		 */
+		Node* find_pattern(Node const& parent) const noexcept;
+	private:
+		static std::uint32_t key(Node const& parent, Node const& child) noexcept;
+		Node* find_kind(Node const& parent, segment_type) const noexcept;
+
+		bool build_children(Node& parent) noexcept;
+		void erase_children(Node& parent) noexcept;
+		void remove(Node const& parent, Node& child) noexcept;
+
+		entry*		table_;
+		unsigned	capacity_;
+		unsigned	count_ = 0;
+};
+
+/**
+ * Index with internal (array) storage
+ */
+template<typename Node,
+		unsigned Size>
+class resource_index : public node_index<Node>{
+	public:
+		using entry = typename node_index<Node>::entry;
+
+		resource_index() : node_index<Node>(table_, Size)
+		{
+			static_assert(Size > 0, "Resource index size must be > 0");
+		}
+	private:
+		entry	table_[Size];
+};
+
+}//Resource
+}//CoAP
+
+#include "impl/index_impl.hpp"
+
+#endif /* COAP_TE_RESOURCE_INDEX_HPP__ */
@@ -1,4 +1,5 @@
 #include "link_format.hpp"
+#include "../internal/scan.hpp"
 #include <cstdio>
 
 namespace CoAP{
@@ -8,26 +9,23 @@ namespace Link_Format{
 Parser::Parser(const char* buffer, std::size_t length)
 	: buffer_(buffer), buffer_len_(length){}
 
+/**
+ * The delimiters are found a word at a time (see 'CoAP::Helper::find_chars')
+ */
 link_format const*
 Parser::next() noexcept
 {
 	if(offset_ >= buffer_len_) return nullptr;
 	link_.reset();
 
-	std::size_t i = offset_;
-	for(; i < buffer_len_; i++)
+	std::size_t i = offset_ + CoAP::Helper::find_chars(buffer_ + offset_,
+							buffer_len_ - offset_, ",;", 2);
+	link_.link_len = i - offset_;
+	if(i < buffer_len_ && buffer_[i] == ';')
 	{
-		if(buffer_[i] == ',') break;
-		if(buffer_[i] == ';')
-		{
-			if(!link_.description)
-			{
-				link_.description = &buffer_[i + 1];
-				continue;
-			}
-		}
-		if(link_.description) link_.desc_len++;
-		else link_.link_len++;
+		link_.description = &buffer_[i + 1];
+		i += 1 + CoAP::Helper::find_char(buffer_ + i + 1, buffer_len_ - i - 1, ',');
+		link_.desc_len = i - (link_.link_len + offset_ + 1);
 	}
 
 	auto off = offset_;
@@ -60,19 +58,18 @@ attribute const* Parser_Attr::next() noexcept
 
 	attr_.attr = &buffer_[offset_];
 
-	std::size_t i = offset_;
-	for(; i < buffer_len_; i++)
+	std::size_t i = offset_ + CoAP::Helper::find_chars(buffer_ + offset_,
+							buffer_len_ - offset_, ";=", 2);
+	attr_.attr_len = i - offset_;
+	if(i < buffer_len_ && buffer_[i] == '=')
 	{
-		if(buffer_[i] == ';') break;
-		if(buffer_[i] == '=')
-		{
-			if(!attr_.value)
-			{
-				attr_.value = &buffer_[i + 1];
-			}
-		}
-		if(attr_.value) attr_.value_len++;
-		else attr_.attr_len++;
+		attr_.value = &buffer_[i + 1];
+		std::size_t eq = i;
+		i += 1 + CoAP::Helper::find_char(buffer_ + i + 1, buffer_len_ - i - 1, ';');
+		/**
+		 * Counts the '=' (removed below)
+		 */
+		attr_.value_len = i - eq;
 	}
 
 	if(attr_.value_len && (buffer_[i] == ',' || buffer_[i] == ';'))
@@ -103,15 +100,17 @@ link_value const* Parser_Value::next() noexcept
 
 	std::size_t i = offset_;
 	bool flag_quote = false;
-	for(; i < buffer_len_; i++)
+	while(true)
 	{
+		i += CoAP::Helper::find_chars(buffer_ + i, buffer_len_ - i, "; \"", 3);
+		if(i >= buffer_len_) break;
 		if(buffer_[i] == ';') break;
-		if(buffer_[i] == ' ')
-			if(!flag_quote) break;
+		if(buffer_[i] == ' ' && !flag_quote) break;
 		if(buffer_[i] == '"')
 			flag_quote = !flag_quote;
-		value_.value_len++;
+		i++;
 	}
+	value_.value_len = i - offset_;
 
 	offset_ = i + 1;
 
@@ -1,57 +1,153 @@
 #ifndef COAP_TE_RESOURCE_NODE_HPP__
 #define COAP_TE_RESOURCE_NODE_HPP__
 
+#include <type_traits>
+
 #include "../internal/tree.hpp"
 #include "resource.hpp"
+#include "index.hpp"
+#include "static_table.hpp"
+#include "pattern.hpp"
 #include "../message/parser.hpp"
 #include "../message/options/options.hpp"
 
 namespace CoAP{
 namespace Resource{
 
-template<typename Resource>
+/**
+ * Resource tree
+ *
+ * Resources paths can be literal, parameters ("{id}") or wildcard ("**").
+ * The segments matched by parameter/wildcard resources of the last search
+ * are available at 'captures' (see 'pattern.hpp'). MaxCaptures is the max
+ * number of captured segments.
+ */
+template<typename Resource,
+		unsigned MaxCaptures = 4>
 class resource_root{
 	public:
 		using resource_t = Resource;
 		using node_t = typename CoAP::branch<resource_t>;
+		using index_t = node_index<node_t>;
+		using captures_t = segment_captures<MaxCaptures>;
 
 		resource_root() : root_(nullptr){}
 
 		resource_t& root() noexcept { return root_.value(); }
 		node_t& node() noexcept { return root_; }
+		node_t const& node() const noexcept { return root_; }
 
-		template<typename ...Args>
-		void add_branch(Args&&... args) noexcept
+		template<typename Path, typename ...Paths>
+		void add_branch(Path& path, Paths&&... paths) noexcept
 		{
-			root_.template add_branch<false>(std::forward<Args>(args)...);
+			version_++;
+			attach_branch(root_, path, std::forward<Paths>(paths)...);
 		}
 
 		template<typename ...Args>
 		bool add_child(Args&&... args) noexcept
 		{
-			return root_.template add_child<true, false>(std::forward<Args>(args)...);
+			version_++;
+			return (attach_node(root_, args) && ...);
+		}
+
+		/**
+		 * Add 'child' (and its descendants) to a node of the tree, keeping
+		 * the index
+		 */
+		bool attach(node_t& parent, node_t& child) noexcept
+		{
+			version_++;
+			return attach_node(parent, child);
+		}
+
+		/**
+		 * Set a index to search the tree (nullptr to unset), and build it.
+		 *
+		 * Adding/removing resources by the root ('add_child', 'add_branch',
+		 * 'attach' and 'remove_node') updates the index incrementally. If the
+		 * index gets full, it's disabled (the tree is searched node by node)
+		 * until 'freeze' is called. If resources are added/removed directly at
+		 * the nodes, 'freeze' must be called.
+		 */
+		bool index(index_t* idx) noexcept
+		{
+			index_ = idx;
+			return freeze();
+		}
+
+		/**
+		 * (Re)build the index with the current tree
+		 */
+		bool freeze() noexcept
+		{
+			version_++;
+			indexed_ = index_ && index_->build(root_);
+			return indexed_;
+		}
+
+		bool indexed() const noexcept { return indexed_; }
+
+		/**
+		 * Tree version
+		 *
+		 * Changes every time the tree is changed (by the root), 'freeze' or
+		 * 'changed' is called. Used to invalidate data generated from the tree
+		 * (as the discovery cache). If resources are added/removed directly at
+		 * the nodes, 'freeze' must be called; if only attributes are changed,
+		 * 'changed'.
+		 */
+		unsigned version() const noexcept { return version_; }
+		void changed() noexcept { version_++; }
+
+		/**
+		 * Set a static resource table (nullptr to unset). The table is
+		 * searched before the tree (see 'static_table').
+		 */
+		template<typename Table>
+		void table(Table const* tb) noexcept
+		{
+			static_assert(std::is_same<typename Table::resource_t, resource_t>::value,
+					"Static table must be of the same resource type");
+
+			table_ = tb;
+			table_search_ = [](void const* t,
+					CoAP::Message::Option::Parser<CoAP::Message::Option::code>& op) noexcept
+				{
+					return static_cast<Table const*>(t)->search(op);
+				};
 		}
 
+		/**
+		 * Segments captured at the last search
+		 */
+		captures_t const& captures() const noexcept { return captures_; }
+
 		template<typename Message>
 		node_t* search_node(Message const& msg) noexcept
 		{
 			using namespace CoAP::Message;
 			using namespace CoAP::Message::Option;
-			node_t* res = &root_;
 
-			Option::Parser op(msg);
-			option const* opt;
+			captures_.clear();
 			node_t* n = &root_;
-			while((opt = op.next()) != nullptr)
-			{
-				if(opt->ocode == Option::code::uri_path)
-				{
-					n = n->find_child(*opt);
-					if(!n) return nullptr;
-					res = n;
-				}
-			}
-			return res;
+			bool found = Option::for_each_option(msg, Option::code::uri_path,
+				[this, &n](option const& opt){
+					/**
+					 * Wildcard consumes all the remaining segments
+					 */
+					if(n->value().kind() == segment_type::wildcard)
+					{
+						captures_.add(n->value().path(), opt);
+						return true;
+					}
+					n = find_child(*n, opt);
+					if(!n) return false;
+					if(n->value().kind() != segment_type::literal)
+						captures_.add(n->value().path(), opt);
+					return true;
+				});
+			return found ? n : nullptr;
 		}
 
 		template<typename Message>
@@ -59,19 +155,16 @@ class resource_root{
 		{
 			using namespace CoAP::Message;
 			using namespace CoAP::Message::Option;
-			node_t const* res = &root_;
-
 			Option::Parser op(msg);
 			option const* opt;
-			node_t const* n = &root_, *parent = nullptr;
+			node_t* n = &root_, *parent = nullptr;
 			while((opt = op.next()))
 			{
 				if(opt->ocode == Option::code::uri_path)
 				{
 					parent = n;
-					n = n->find_child(*opt);
+					n = find_child<false>(*n, *opt);
 					if(!n) return nullptr;
-					res = n;
 				}
 			}
 			return parent;
@@ -80,6 +173,18 @@ class resource_root{
 		template<typename Message>
 		resource_t const* search(Message const& msg) noexcept
 		{
+			if(table_)
+			{
+				CoAP::Message::Option::Parser<CoAP::Message::Option::code> op(msg);
+				resource_t const* res = table_search_(table_, op);
+				if(res)
+				{
+					//Static resources have no patterns: nothing captured
+					captures_.clear();
+					return res;
+				}
+			}
+
 			node_t const* node = search_node(msg);
 			return node ? &node->value() : nullptr;
 		}
@@ -98,18 +203,71 @@ class resource_root{
 				if(opt->ocode == Option::code::uri_path)
 				{
 					parent = n;
-					n = n->find_child(*opt);
+					n = find_child<false>(*n, *opt);
 					if(!n) return nullptr;
 				}
 			}
 			if(parent)
+			{
+				version_++;
+				if(indexed_) index_->erase(*parent, *n);
 				parent->remove_child(*n);
+			}
 			return n;
 		}
 
 		node_t* operator[](unsigned index) noexcept { return root_[index]; }
 	private:
+		bool attach_node(node_t& parent, node_t& child) noexcept
+		{
+			if(!parent.template add_child<true, false>(child))
+				return false;
+			if(indexed_ && !index_->insert(parent, child))
+				indexed_ = false;
+			return true;
+		}
+
+		template<typename Path, typename ...Paths>
+		void attach_branch(node_t& parent, Path& path, Paths&&... paths) noexcept
+		{
+			attach_node(parent, path);
+			if constexpr(sizeof...(paths) > 0)
+				attach_branch(path, std::forward<Paths>(paths)...);
+		}
+
+		/**
+		 * Literal children first, then parameter and wildcard (if
+		 * MatchPatterns is set). With the index, patterns are also searched
+		 * at the index (O(1)); without, the children are walked.
+		 */
+		template<bool MatchPatterns = true>
+		node_t* find_child(node_t& parent, CoAP::Message::Option::option const& opt) noexcept
+		{
+			node_t* n = indexed_ ? index_->find(parent, opt) : parent.find_child(opt);
+			if constexpr(!MatchPatterns) return n;
+			if(n) return n;
+			if(indexed_) return index_->find_pattern(parent);
+
+			node_t* wildcard = nullptr;
+			for(n = parent.children(); n; n = n->next())
+			{
+				segment_type kind = n->value().kind();
+				if(kind == segment_type::parameter) return n;
+				if(kind == segment_type::wildcard && !wildcard) wildcard = n;
+			}
+			return wildcard;
+		}
+
 		node_t root_;
+		captures_t	captures_;
+
+		index_t*	index_ = nullptr;
+		bool		indexed_ = false;
+		unsigned	version_ = 0;
+
+		void const*	table_ = nullptr;
+		resource_t const* (*table_search_)(void const*,
+				CoAP::Message::Option::Parser<CoAP::Message::Option::code>&) noexcept = nullptr;
 };
 
 }//Resource
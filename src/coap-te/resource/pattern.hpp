@@ -0,0 +1,83 @@
+#ifndef COAP_TE_RESOURCE_PATTERN_HPP__
+#define COAP_TE_RESOURCE_PATTERN_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../message/options/options.hpp"
+
+namespace CoAP{
+namespace Resource{
+
+/**
+ * Resource path segment type
+ *
+ * The type is defined by the resource path (when the resource is constructed):
+ * * literal: matches only the same segment;
+ * * parameter ("{name}"): matches any segment;
+ * * wildcard ("**"): matches all the remaining segments.
+ *
+ * When searching a child, the precedence is: literal, parameter and
+ * wildcard (there is no backtracking).
+ */
+enum class segment_type{
+	literal = 0,
+	parameter,
+	wildcard
+};
+
+constexpr segment_type segment_kind(char const* path) noexcept
+{
+	if(!path || !*path) return segment_type::literal;
+	if(path[0] == '*' && path[1] == '*' && path[2] == '\0') return segment_type::wildcard;
+	if(path[0] != '{') return segment_type::literal;
+
+	char const* p = path + 1;
+	for(; *p; p++);
+	return p[-1] == '}' && p - path > 2 ? segment_type::parameter : segment_type::literal;
+}
+
+/**
+ * Segments captured by parameter/wildcard resources
+ *
+ * The values point to the request buffer (nothing is copied), so are only
+ * valid while the request is. The name is the path of the resource that
+ * captured the segment ("{id}" or "**").
+ */
+template<unsigned Size>
+class segment_captures{
+	public:
+		struct segment{
+			char const*		name = nullptr;
+			char const*		value = nullptr;
+			unsigned		length = 0;
+		};
+
+		segment_captures();
+
+		bool add(char const* name, CoAP::Message::Option::option const&) noexcept;
+		void clear() noexcept;
+
+		unsigned size() const noexcept;
+		/**
+		 * Returns true if some segment couldn't be stored
+		 */
+		bool truncated() const noexcept;
+
+		segment const* operator[](unsigned index) const noexcept;
+		/**
+		 * Search by the parameter name (with or without the braces)
+		 */
+		segment const* get(char const* name) const noexcept;
+	private:
+		segment		seg_[Size];
+		unsigned	count_ = 0;
+		bool		truncated_ = false;
+};
+
+}//Resource
+}//CoAP
+
+#include "impl/pattern_impl.hpp"
+
+#endif /* COAP_TE_RESOURCE_PATTERN_HPP__ */
@@ -6,6 +6,7 @@
 #include <cstring>
 #include "../message/codes.hpp"
 #include "../internal/list.hpp"
+#include "pattern.hpp"
 
 namespace CoAP{
 namespace Resource{
@@ -27,26 +28,23 @@ class resource
 		using callback_ex_t = typename std::conditional<UseExtraMethods, callback_t, empty>::type;
 		using callback_ex_ptr_t = typename std::conditional<UseExtraMethods, callback_ptr_t, empty>::type;
 
-		resource(const char* path,
+		constexpr resource(const char* path,
 				callback_t get = nullptr, callback_t post = nullptr,
 				callback_t put = nullptr, callback_t del = nullptr)
-		: path_(path), get_(get), post_(post), put_(put), del_(del)
-		{
-			if constexpr(has_description)
-				desc_ = nullptr;
-		}
+		: path_(path), kind_(segment_kind(path)),
+		  get_(get), post_(post), put_(put), del_(del),
+		  desc_(make_description(nullptr)){}
 
-		resource(const char* path, const char* description [[maybe_unused]],
+		constexpr resource(const char* path, const char* description,
 						callback_t get = nullptr, callback_t post = nullptr,
 						callback_t put = nullptr, callback_t del = nullptr)
-				: path_(path), get_(get), post_(post), put_(put), del_(del)
-		{
-			if constexpr(has_description)
-				desc_ = description;
-		}
+				: path_(path), kind_(segment_kind(path)),
+				  get_(get), post_(post), put_(put), del_(del),
+				  desc_(make_description(description)){}
 
-		const char* path() const noexcept{ return path_; }
-		const char* description() const noexcept
+		constexpr const char* path() const noexcept{ return path_; }
+		constexpr segment_type kind() const noexcept{ return kind_; }
+		constexpr const char* description() const noexcept
 		{
 			if constexpr(has_description)
 				return desc_;
@@ -186,7 +184,16 @@ class resource
 
 
 	private:
+		static constexpr description_type make_description(const char* desc [[maybe_unused]]) noexcept
+		{
+			if constexpr(has_description)
+				return desc;
+			else
+				return description_type{};
+		}
+
 		const char*			path_;
+		segment_type		kind_;
 
 		callback_ptr_t		get_;
 		callback_ptr_t		post_;
@@ -194,9 +201,9 @@ class resource
 		callback_ptr_t		del_;
 
 #if COAP_TE_FETCH_PATCH == 1
-		callback_ex_ptr_t	fetch_;
-		callback_ex_ptr_t	patch_;
-		callback_ex_ptr_t	ipatch_;
+		callback_ex_ptr_t	fetch_{};
+		callback_ex_ptr_t	patch_{};
+		callback_ex_ptr_t	ipatch_{};
 #endif /* COAP_TE_FETCH_PATCH == 1 */
 
 		description_type	desc_;
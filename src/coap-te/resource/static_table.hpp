@@ -0,0 +1,145 @@
+#ifndef COAP_TE_RESOURCE_STATIC_TABLE_HPP__
+#define COAP_TE_RESOURCE_STATIC_TABLE_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+
+#include "../message/options/options.hpp"
+#include "../message/options/parser.hpp"
+
+namespace CoAP{
+namespace Resource{
+
+/**
+ * Path hash (FNV-1a). The path segments are hashed with a '/' between them,
+ * so the hash of the Uri-Path options of a request is the same as the hash
+ * of the path string ("sensors/temp").
+ */
+static constexpr const std::uint32_t path_hash_init = 2166136261u;
+
+constexpr std::uint32_t path_hash(std::uint32_t hash, unsigned char c) noexcept
+{
+	return (hash ^ c) * 16777619u;
+}
+
+constexpr std::uint32_t path_hash(char const* path) noexcept
+{
+	std::uint32_t hash = path_hash_init;
+	for(; *path; path++)
+		hash = path_hash(hash, static_cast<unsigned char>(*path));
+	return hash;
+}
+
+/**
+ * Rehash of the path hash with a seed (displacement)
+ */
+constexpr std::uint32_t path_hash_seed(std::uint32_t hash, std::uint32_t seed) noexcept
+{
+	hash ^= seed * 0x9E3779B9u;
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6Bu;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35u;
+	hash ^= hash >> 16;
+	return hash;
+}
+
+/**
+ * Precomputed link format body (/.well-known/core)
+ */
+template<std::size_t Size>
+struct link_format_body{
+	char			data[Size]{};
+	std::size_t		size = 0;
+};
+
+/**
+ * Static resource table
+ *
+ * Table of resources defined at compile time. The resources paths are the
+ * full path, without the leading slash ("sensors/temp", or "" to the root).
+ *
+ * The table is built at the constructor (that can be evaluated at compile
+ * time, declaring the table 'constexpr'), searching a minimal perfect hash
+ * of the paths (hash and displace): the request Uri-Path is hashed once,
+ * and selects only one candidate, that is then compared. If no perfect hash
+ * is found (or a path is duplicated), the table is searched linearly
+ * ('perfect' returns false).
+ *
+ * As the table is constant, the /.well-known/core body can also be
+ * precomputed ('link_format').
+ *
+ * \code
+ * static constexpr resource list[] = {{"time", get_time}, {"sensors/temp", get_temp}};
+ * static constexpr CoAP::Resource::static_table table{list};
+ * static constexpr auto core = table.link_format<table.link_format_size()>();
+ * \endcode
+ */
+template<typename Resource,
+		unsigned N>
+class static_table{
+	public:
+		using resource_t = Resource;
+
+		static constexpr unsigned table_size() noexcept
+		{
+			unsigned size = 1;
+			while(size < 2 * N) size <<= 1;
+			return size;
+		}
+
+		constexpr static_table(Resource const (&list)[N]) noexcept;
+
+		constexpr unsigned size() const noexcept{ return N; }
+		constexpr bool perfect() const noexcept{ return perfect_; }
+		constexpr resource_t const& operator[](unsigned index) const noexcept{ return res_[index]; }
+
+		/**
+		 * Search by path string
+		 */
+		constexpr resource_t const* search(char const* path) const noexcept;
+
+		/**
+		 * Search by the Uri-Path options of a request
+		 */
+		template<typename Message>
+		resource_t const* search(Message const& msg) const noexcept;
+		resource_t const* search(CoAP::Message::Option::Parser<CoAP::Message::Option::code>&) const noexcept;
+
+		/**
+		 * Link format (/.well-known/core) size and body
+		 *
+		 * The size includes the null terminator.
+		 */
+		constexpr std::size_t link_format_size() const noexcept;
+		template<std::size_t Size>
+		constexpr link_format_body<Size> link_format() const noexcept;
+	private:
+		static constexpr const unsigned max_seed = 0xFFFF;
+
+		template<std::size_t ...I>
+		constexpr static_table(Resource const (&list)[N], std::index_sequence<I...>) noexcept;
+
+		constexpr void make_hash() noexcept;
+		constexpr bool place(unsigned bucket, std::uint32_t seed) noexcept;
+		constexpr unsigned candidate(std::uint32_t hash) const noexcept;
+		bool compare(char const* path,
+				CoAP::Message::Option::Parser<CoAP::Message::Option::code>&) const noexcept;
+
+		Resource		res_[N];
+		std::uint32_t	hash_[N]{};
+		std::uint16_t	disp_[N]{};
+		std::uint16_t	slot_[table_size()]{};		//index + 1 (0: empty)
+		bool			perfect_ = false;
+};
+
+template<typename Resource, unsigned N>
+static_table(Resource const (&)[N]) -> static_table<Resource, N>;
+
+}//Resource
+}//CoAP
+
+#include "impl/static_table_impl.hpp"
+
+#endif /* COAP_TE_RESOURCE_STATIC_TABLE_HPP__ */
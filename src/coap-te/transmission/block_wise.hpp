@@ -0,0 +1,381 @@
+#ifndef COAP_TE_TRANSMISSION_BLOCK_WISE_HPP__
+#define COAP_TE_TRANSMISSION_BLOCK_WISE_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+#include <type_traits>
+
+#include "../defines/defaults.hpp"
+#include "../port/port.hpp"
+#include "../message/types.hpp"
+#include "../message/codes.hpp"
+#include "../message/options/options.hpp"
+#include "../cache/cache.hpp"
+#include "../error.hpp"
+
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+
+namespace CoAP{
+namespace Transmission{
+
+/**
+ * Block-wise transfer server side helpers
+ *
+ * https://tools.ietf.org/html/rfc7959
+ */
+static constexpr const unsigned default_block_size = 1024;		//SZX = 6
+static constexpr const unsigned block2_transfer_lifetime = 60000;	//miliseconds
+static constexpr const unsigned block1_transfer_lifetime = 60000;	//miliseconds
+static constexpr const unsigned block1_completed_lifetime = 247000;	//miliseconds (EXCHANGE_LIFETIME)
+
+/**
+ * Block to be sent at a Block2 response
+ */
+struct block_param{
+	unsigned		number = 0;
+	unsigned		size = default_block_size;
+	std::size_t		offset = 0;
+	std::size_t		length = 0;		///< Payload size of this block
+	bool			more = false;
+	bool			bert = false;	///< SZX = 7, 'size' multiple of 1024 (RFC8323)
+};
+
+/**
+ * Makes the block option value of the block (BERT blocks uses SZX = 7)
+ */
+bool make_block(unsigned& value, block_param const&) noexcept;
+
+/**
+ * Negotiate the block to respond to a request, from the Block2 option of the
+ * request (if any) and the server maximum block size. The smaller size is
+ * used, and the block number is recalculated to the same offset.
+ *
+ * https://tools.ietf.org/html/rfc7959#section-2.4
+ *
+ * Returns false if the block requested is beyond the representation size,
+ * or has SZX = 7 and not 'reliable' (see 'block2_reserved').
+ */
+template<typename Message>
+bool get_block2(Message const& request,
+		std::size_t total_size,
+		unsigned max_block_size,
+		block_param&,
+		bool reliable = false) noexcept;
+
+/**
+ * Same as above, from the value of the Block2 option of the request
+ * ('has_block2' false if not present)
+ */
+bool get_block2(bool has_block2, unsigned block2,
+		std::size_t total_size,
+		unsigned max_block_size,
+		block_param&,
+		bool reliable = false) noexcept;
+
+/**
+ * If the Block2 option of the request has SZX = 7, reserved at UDP (BERT is
+ * only defined at reliable transports). Must be responded with 4.00.
+ *
+ * https://tools.ietf.org/html/rfc7959#section-2.2
+ */
+template<typename Message>
+bool block2_reserved(Message const& request) noexcept;
+
+/**
+ * Biggest block size (16 to 1024) that fits at half of a packet of
+ * 'packet_size' bytes (the other half is left to the header and options)
+ */
+constexpr unsigned block_size_fit(std::size_t packet_size) noexcept
+{
+	unsigned size = default_block_size;
+	while(size > 16 && size > packet_size / 2) size /= 2;
+	return size;
+}
+
+/**
+ * If the response is sent over a reliable transport (SZX = 7 is BERT)
+ */
+template<typename Response>
+struct is_reliable_response : std::false_type{};
+
+#if COAP_TE_RELIABLE_CONNECTION == 1
+namespace Reliable{
+template<typename Handler>
+class Response;
+}//Reliable
+
+template<typename Handler>
+struct is_reliable_response<Reliable::Response<Handler>> : std::true_type{};
+
+/**
+ * BERT (Block-wise Extension for Reliable Transport)
+ *
+ * https://tools.ietf.org/html/rfc8323#section-6
+ *
+ * Over reliable transports, blocks with SZX = 7 carry payloads multiple of
+ * 1024 bytes, and the block number is counted at 1024 bytes units.
+ */
+static constexpr const unsigned bert_szx = 7;
+static constexpr const unsigned bert_unit = 1024;
+
+/**
+ * Same as 'get_block2', but the block may be a BERT block of up to
+ * 'max_payload' bytes (rounded down to a multiple of 1024). BERT is used if the
+ * request doesn't have a Block2 option or the Block2 option has SZX = 7. If the
+ * client asks a smaller block size, the request size is used.
+ *
+ * Must only be used if both peers indicated the Block-Wise-Transfer option
+ * at the CSM message.
+ */
+template<typename Message>
+bool get_block2_bert(Message const& request,
+		std::size_t total_size,
+		unsigned max_payload,
+		block_param&) noexcept;
+#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
+
+/**
+ * Reads 'size' bytes of the representation, starting at 'offset', to 'buffer'.
+ * Must return the number of bytes read.
+ */
+using block2_read_cb = std::size_t(*)(void* buffer,
+										std::size_t offset,
+										std::size_t size,
+										void* data) noexcept;
+
+/**
+ * Hash of the request options that identify a block-wise transfer (all options
+ * but the block and size options) and the method
+ */
+template<typename Message>
+std::uint32_t block2_key(Message const&) noexcept;
+
+/**
+ * The method and options hashed by 'block2_key' serialized (code, length
+ * and value of each option), to be compared byte by byte when the hashes match.
+ *
+ * Returns the size used ('ec' set as insufficient_buffer if it doesn't fit)
+ */
+template<typename Message>
+std::size_t block2_key_data(Message const&, void* buffer, std::size_t buffer_len,
+		CoAP::Error&) noexcept;
+
+/**
+ * Block2 transfer state.
+ *
+ * Keeps the representation (or the provider) of a transfer, so it is not
+ * regenerated at every block requested. The same ETag is sent at all blocks.
+ */
+template<typename Endpoint>
+struct block2_transfer{
+	bool				used = false;
+	Endpoint			ep;
+	std::uint32_t		key = 0;
+	std::uint8_t		etag[4];
+	std::size_t			size = 0;
+	void const*			representation = nullptr;
+	block2_read_cb		read = nullptr;
+	void*				data = nullptr;
+	CoAP::time_t		expiration = 0;
+
+	void clear() noexcept
+	{
+		used = false;
+		representation = nullptr;
+		read = nullptr;
+		data = nullptr;
+	}
+};
+
+/**
+ * List of the ongoing Block2 transfers
+ *
+ * Transfers are released when the last block is sent or when expired (not
+ * requested by 'LifetimeMs' miliseconds).
+ *
+ * Transfers are matched by the endpoint and the request options (see
+ * 'block2_key_data', up to KeySize bytes), compared byte by byte. Requests
+ * with bigger options can't start a transfer.
+ */
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs = block2_transfer_lifetime,
+		std::size_t KeySize = CoAP::Cache::default_key_size>
+class block2_list{
+	public:
+		using transfer_t = block2_transfer<Endpoint>;
+
+		block2_list();
+
+		template<typename Message>
+		transfer_t* find(Endpoint const&, Message const& request) noexcept;
+
+		template<typename Message>
+		transfer_t* add(Endpoint const&, Message const& request,
+				void const* representation, std::size_t size) noexcept;
+		template<typename Message>
+		transfer_t* add(Endpoint const&, Message const& request,
+				block2_read_cb, void* data, std::size_t size) noexcept;
+
+		/**
+		 * Free slot prepared to the request (ETag, key), but not used. The
+		 * transfer starts when the representation is set and 'used' (see the
+		 * Response automatic Block2). Returns nullptr if there is no free slot.
+		 */
+		template<typename Message>
+		transfer_t* reserve(Endpoint const&, Message const& request) noexcept;
+
+		void check() noexcept;
+
+		constexpr unsigned size() const noexcept{ return Size; }
+		transfer_t* operator[](unsigned index) noexcept;
+	private:
+		template<typename Message>
+		transfer_t* alloc(Endpoint const&, Message const& request, std::size_t size) noexcept;
+
+		transfer_t		list_[Size];
+		std::uint8_t	key_data_[Size][KeySize];
+		std::size_t		key_len_[Size];
+		std::uint32_t	etag_;
+};
+
+/**
+ * Block1 reassembly
+ *
+ * https://tools.ietf.org/html/rfc7959#section-2.5
+ *
+ * The body of a block-wise request is delivered to a sink callback as each block
+ * arrives, so it doesn't need to be buffered entirely.
+ */
+enum class block1_event{
+	data = 0,		///< Block received (data, offset, size)
+	commit,			///< All blocks received
+	abort			///< Transfer canceled (error or expired)
+};
+
+/**
+ * Sink of the block1 transfers. At 'data' event, returning false aborts the
+ * transfer (responding 4.13). The return value of the other events is ignored.
+ */
+using block1_sink_cb = bool(*)(block1_event,
+								void const* data,
+								std::size_t offset,
+								std::size_t size,
+								void* user) noexcept;
+
+enum class block1_status{
+	complete = 0,	///< Body fully received and commited. Handler must serialize the final response
+	partial,		///< 2.31 Continue serialized
+	error,			///< Error response serialized
+	duplicated		///< Final block retransmitted: final response serialized again (not commited again)
+};
+
+/**
+ * Hash that identify a block1 transfer: resource options and Request-Tag (if
+ * present) or the token.
+ *
+ * https://tools.ietf.org/html/rfc9175#section-3
+ */
+template<typename Message>
+std::uint32_t block1_key(Message const&) noexcept;
+
+template<typename Endpoint>
+struct block1_transfer{
+	bool				used = false;
+	Endpoint			ep;
+	std::uint32_t		key = 0;
+	bool				tagged = false;	///< Identified by Request-Tag (else by the token)
+	std::uint8_t		token[8];
+	std::size_t			token_len = 0;
+	std::size_t			offset = 0;		///< Next offset expected
+	block1_sink_cb		sink = nullptr;
+	void*				data = nullptr;
+	CoAP::time_t		expiration = 0;
+	bool				completed = false;	///< Commited, kept to answer retransmissions
+	unsigned			block1 = 0;			///< Block1 option of the final response
+	CoAP::Message::code	final_code = CoAP::Message::code::changed;
+
+	void clear() noexcept
+	{
+		used = false;
+		completed = false;
+		tagged = false;
+		token_len = 0;
+		offset = 0;
+		sink = nullptr;
+		data = nullptr;
+	}
+};
+
+/**
+ * List of the ongoing block1 transfers
+ *
+ * Must be called at the request handler. Responds automatically with
+ * 2.31 Continue while there is more blocks to receive, and with the proper error
+ * codes (4.08/4.13/5.03). When all the body is received, the sink is called with
+ * 'commit', and the Block1 option is added to the response: the handler just
+ * need to set the code/payload and serialize it.
+ *
+ * Transfers not continued by 'LifetimeMs' miliseconds are aborted.
+ *
+ * Commited transfers are kept by 'CompletedLifetimeMs' miliseconds (EXCHANGE_LIFETIME),
+ * so a retransmission of the final block (response lost) is answered again with
+ * the final code (and Block1 option), without commiting twice. The final code
+ * is set at 'process' (the handler should respond with the same code). Their
+ * slots are reused if there is no free slot.
+ *
+ * Transfers are identified by the endpoint, the resource and the Request-Tag.
+ * Without Request-Tag, the token is compared byte a byte (not only its hash),
+ * so concurrent uploads with different tokens don't overwrite each other. As
+ * clients may change the token between blocks, a continuation without Request-Tag
+ * that doesn't match any token is accepted by a untagged transfer of the same
+ * endpoint/resource waiting exactly that offset.
+ */
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs = block1_transfer_lifetime,
+		unsigned CompletedLifetimeMs = block1_completed_lifetime>
+class block1_list{
+	public:
+		using transfer_t = block1_transfer<Endpoint>;
+
+		block1_list();
+
+		template<typename Message,
+				typename Response>
+		block1_status process(Message const& request,
+				Response& response,
+				block1_sink_cb sink, void* data = nullptr,
+				unsigned max_block_size = default_block_size,
+				CoAP::Message::code final_code = CoAP::Message::code::changed) noexcept;
+
+		void check() noexcept;
+
+		constexpr unsigned size() const noexcept{ return Size; }
+		transfer_t* operator[](unsigned index) noexcept;
+	private:
+		template<typename Message>
+		transfer_t* find(Endpoint const&, std::uint32_t key,
+				bool tagged, Message const& request) noexcept;
+		template<typename Message>
+		transfer_t* find_continuation(Endpoint const&, Message const& request,
+				std::size_t offset) noexcept;
+		transfer_t* find_free_slot() noexcept;
+		void abort(transfer_t&) noexcept;
+
+		template<typename Response>
+		block1_status reply(Response&, CoAP::Message::code) noexcept;
+
+		transfer_t						list_[Size];
+		unsigned						block1_;
+		CoAP::Message::Option::node		block1_op_;
+};
+
+}//Transmission
+}//CoAP
+
+#include "impl/block_wise_impl.hpp"
+
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+
+#endif /* COAP_TE_TRANSMISSION_BLOCK_WISE_HPP__ */
@@ -0,0 +1,85 @@
+#ifndef COAP_TE_TRANSMISSION_COLLECTOR_HPP__
+#define COAP_TE_TRANSMISSION_COLLECTOR_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../port/port.hpp"
+#include "../message/types.hpp"
+#include "../message/codes.hpp"
+
+namespace CoAP{
+namespace Transmission{
+
+/**
+ * Collect the responses of a multicast request
+ *
+ * https://tools.ietf.org/html/rfc7390#section-2.7
+ *
+ * Multicast requests are answered by many servers, at random times inside
+ * the leisure period. The responses don't match any transaction, and must be
+ * feed at the 'process' method (engine default callback). The responses with
+ * the token of the request are aggregated, one by responder (a new response
+ * of the same responder replaces the old one), until the collecting period ends.
+ *
+ * The payload is copied (truncated to MaxPayloadSize).
+ */
+template<typename Endpoint,
+		unsigned MaxResponses,
+		unsigned MaxPayloadSize = 64>
+class collector{
+	public:
+		struct response_t{
+			Endpoint				ep;
+			CoAP::Message::code		mcode = CoAP::Message::code::empty;
+			std::size_t				payload_len = 0;	///< payload length received
+			std::uint8_t			payload[MaxPayloadSize];
+
+			std::size_t	size() const noexcept
+			{
+				return payload_len > MaxPayloadSize ? MaxPayloadSize : payload_len;
+			}
+			bool truncated() const noexcept{ return payload_len > MaxPayloadSize; }
+		};
+
+		collector();
+
+		/**
+		 * Start collecting responses with 'token', for 'duration' miliseconds.
+		 * Previous responses are discarded.
+		 */
+		bool start(void const* token, std::size_t token_len,
+				CoAP::time_t duration) noexcept;
+		void stop() noexcept;
+
+		/**
+		 * Returns true if the message is a response of the request being collected
+		 */
+		template<typename Message>
+		bool process(Endpoint const&, Message const&) noexcept;
+
+		bool collecting() const noexcept;
+		bool done() const noexcept;
+
+		unsigned size() const noexcept;
+		response_t const* operator[](unsigned) const noexcept;
+
+		unsigned discarded() const noexcept;	///< responses that didn't fit
+	private:
+		std::uint8_t	token_[8];
+		std::size_t		token_len_ = 0;
+
+		bool			active_ = false;
+		CoAP::time_t	end_time_ = 0;
+
+		response_t		responses_[MaxResponses];
+		unsigned		count_ = 0;
+		unsigned		discarded_ = 0;
+};
+
+}//Transmission
+}//CoAP
+
+#include "impl/collector_impl.hpp"
+
+#endif /* COAP_TE_TRANSMISSION_COLLECTOR_HPP__ */
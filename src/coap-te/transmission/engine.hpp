@@ -5,6 +5,7 @@
 #include <type_traits>
 
 #include "../error.hpp"
+#include "../defines/defaults.hpp"
 
 #include "types.hpp"
 #include "request.hpp"
@@ -15,11 +16,16 @@
 namespace CoAP{
 namespace Transmission{
 
+/**
+ * LeisureList: list of responses to multicast requests waiting to be sent
+ * (see leisure_list), or CoAP::disable to send them at once.
+ */
 template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList = CoAP::disable>
 class engine
 {
 		using empty = struct{};
@@ -51,6 +57,11 @@ class engine
 
 		static constexpr const unsigned packet_size = transaction_t::max_packet_size();
 
+#if COAP_TE_MULTICAST == 1
+		static constexpr const bool has_leisure_list = !std::is_same<LeisureList, CoAP::disable>::value;
+		using leisure_list_t = typename std::conditional<has_leisure_list, LeisureList, empty>::type;
+#endif /* COAP_TE_MULTICAST == 1 */
+
 		engine(Connection&& conn, MessageID&& message_id);
 		engine(Connection&& conn, MessageID&& message_id, configure const& config);
 
@@ -149,6 +160,28 @@ class engine
 				configure const&,
 				CoAP::Error&) noexcept;
 
+		/**
+		 * Pre-serialized requests: the request is copied (to the transaction
+		 * or internal buffer) and the message id patched
+		 */
+		template<bool UseInternalBufferNon = false,
+				std::size_t TemplateSize,
+				unsigned TemplateRegions>
+		std::size_t send(endpoint&,
+				configure const&,
+				CoAP::Message::request_template<TemplateSize, TemplateRegions> const&,
+				std::uint16_t mid,
+				transaction_cb func, void* data,
+				CoAP::Error&) noexcept;
+
+		template<bool UseInternalBufferNon = false,
+				std::size_t TemplateSize,
+				unsigned TemplateRegions>
+		std::size_t send(endpoint&,
+				CoAP::Message::request_template<TemplateSize, TemplateRegions> const&,
+				transaction_cb func, void* data,
+				CoAP::Error&) noexcept;
+
 		std::size_t send(endpoint&,
 				const void* buffer, std::size_t buffer_len,
 				CoAP::Error&) noexcept;
@@ -191,10 +224,11 @@ class engine
 		template<bool CheckEndpoint = true,
 				bool CheckToken = false>
 		void process_response(endpoint& ep,
-				CoAP::Message::message const&,
+				CoAP::Message::indexed_message<>&,
+				std::uint8_t const* body, std::size_t body_len,
 				CoAP::Error& ec) noexcept;
 		void process_request(endpoint& ep,
-				CoAP::Message::message const&,
+				CoAP::Message::indexed_message<> const&,
 				CoAP::Error& ec) noexcept;
 
 		transaction_list list_;
@@ -207,6 +241,20 @@ class engine
 
 		default_response_cb default_cb_;
 
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+		/**
+		 * Automatic Block2 transfers (see Response::representation)
+		 */
+		block2_list<endpoint, COAP_TE_BLOCK2_TRANSFERS>	block2_;
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+
+#if COAP_TE_MULTICAST == 1
+		void send_response(endpoint& ep, void const* buffer, std::size_t size, CoAP::Error&) noexcept;
+
+		bool			multicast_ = false;	///< last message received was multicast
+		leisure_list_t	leisure_;
+#endif /* COAP_TE_MULTICAST == 1 */
+
 		configure		config_;
 };
 
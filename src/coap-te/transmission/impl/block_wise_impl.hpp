@@ -0,0 +1,710 @@
+#ifndef COAP_TE_TRANSMISSION_BLOCK_WISE_IMPL_HPP__
+#define COAP_TE_TRANSMISSION_BLOCK_WISE_IMPL_HPP__
+
+#include <cstring>
+
+#include "../block_wise.hpp"
+#include "../../message/options/options.hpp"
+#include "../../message/options/parser.hpp"
+#include "../../message/options/functions.hpp"
+#include "../../message/options/functions2.hpp"
+#include "../../cache/functions.hpp"
+
+namespace CoAP{
+namespace Transmission{
+
+template<typename Message>
+bool get_block2(Message const& request,
+		std::size_t total_size,
+		unsigned max_block_size,
+		block_param& param,
+		bool reliable /* = false */) noexcept
+{
+	using namespace CoAP::Message;
+
+	Option::option opt;
+	bool has_block2 = Option::get_option(request, opt, Option::code::block2);
+
+	return get_block2(has_block2, has_block2 ? Option::parse_unsigned(opt) : 0,
+			total_size, max_block_size, param, reliable);
+}
+
+inline bool get_block2(bool has_block2, unsigned block2,
+		std::size_t total_size,
+		unsigned max_block_size,
+		block_param& param,
+		bool reliable /* = false */) noexcept
+{
+	using namespace CoAP::Message;
+
+	param.size = max_block_size;
+	param.offset = 0;
+
+	if(has_block2)
+	{
+		if(!reliable && Option::block_szx(block2) == 7)
+			return false;
+
+		unsigned req_size = Option::block_size(block2, reliable);
+
+		param.offset = Option::byte_offset(block2, reliable);
+		if(req_size < param.size) param.size = req_size;
+	}
+
+	if(param.offset != 0 && param.offset >= total_size)
+		return false;
+
+	/**
+	 * Block sizes are power of 2, so the offset of the requested block
+	 * is always a multiple of a smaller block size
+	 */
+	param.number = static_cast<unsigned>(param.offset / param.size);
+	param.length = total_size - param.offset;
+	if(param.length > param.size) param.length = param.size;
+	param.more = (param.offset + param.length) < total_size;
+
+	return true;
+}
+
+template<typename Message>
+bool block2_reserved(Message const& request) noexcept
+{
+	using namespace CoAP::Message;
+
+	Option::option opt;
+	return Option::get_option(request, opt, Option::code::block2)
+			&& Option::block_szx(Option::parse_unsigned(opt)) == 7;
+}
+
+inline bool make_block(unsigned& value, block_param const& param) noexcept
+{
+#if COAP_TE_RELIABLE_CONNECTION == 1
+	if(param.bert)
+		return CoAP::Message::Option::make_block_raw(value, param.number, param.more, bert_szx);
+#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
+	return CoAP::Message::Option::make_block(value, param.number, param.more, param.size);
+}
+
+#if COAP_TE_RELIABLE_CONNECTION == 1
+template<typename Message>
+bool get_block2_bert(Message const& request,
+		std::size_t total_size,
+		unsigned max_payload,
+		block_param& param) noexcept
+{
+	using namespace CoAP::Message;
+
+	Option::option opt;
+	if(Option::get_option(request, opt, Option::code::block2)
+		&& !Option::is_bert(Option::parse_unsigned(opt)))
+		return get_block2(request, total_size, bert_unit, param, true);
+
+	max_payload -= max_payload % bert_unit;
+	if(max_payload <= bert_unit)
+		return get_block2(request, total_size, bert_unit, param, true);
+
+	param.offset = 0;
+	if(Option::get_option(request, opt, Option::code::block2))
+		param.offset = Option::byte_offset(Option::parse_unsigned(opt), true);
+
+	if(param.offset != 0 && param.offset >= total_size)
+		return false;
+
+	param.bert = true;
+	param.size = max_payload;
+	param.number = static_cast<unsigned>(param.offset / bert_unit);
+	param.length = total_size - param.offset;
+	if(param.length > param.size) param.length = param.size;
+	param.more = (param.offset + param.length) < total_size;
+
+	return true;
+}
+#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
+
+/**
+ * Block and size options are not part of the block2 key
+ */
+static inline bool is_block2_key(CoAP::Message::Option::code ocode) noexcept
+{
+	using namespace CoAP::Message;
+
+	return ocode != Option::code::block1
+			&& ocode != Option::code::block2
+			&& ocode != Option::code::size1
+			&& ocode != Option::code::size2
+#if COAP_TE_Q_BLOCK == 1
+			&& ocode != Option::code::q_block1
+			&& ocode != Option::code::q_block2
+#endif /* COAP_TE_Q_BLOCK == 1 */
+			;
+}
+
+template<typename Message>
+std::uint32_t block2_key(Message const& request) noexcept
+{
+	using namespace CoAP::Message;
+
+	std::uint8_t mcode = static_cast<std::uint8_t>(request.mcode);
+	std::uint32_t h = CoAP::Cache::hash(&mcode, sizeof(mcode));
+
+	Option::Parser<Option::code> parser(request);
+	Option::option const* opt;
+	while((opt = parser.next()) != nullptr)
+	{
+		if(!is_block2_key(opt->ocode)) continue;
+
+		std::uint16_t ocode = static_cast<std::uint16_t>(opt->ocode);
+		h = CoAP::Cache::hash(&ocode, sizeof(ocode), h);
+		h = CoAP::Cache::hash(&opt->length, sizeof(opt->length), h);
+		h = CoAP::Cache::hash(opt->value, opt->length, h);
+	}
+	return h;
+}
+
+template<typename Message>
+std::size_t block2_key_data(Message const& request, void* buffer, std::size_t buffer_len,
+		CoAP::Error& ec) noexcept
+{
+	using namespace CoAP::Message;
+
+	std::uint8_t* b = static_cast<std::uint8_t*>(buffer);
+	if(!buffer_len)
+	{
+		ec = CoAP::errc::insufficient_buffer;
+		return 0;
+	}
+	b[0] = static_cast<std::uint8_t>(request.mcode);
+	std::size_t size = 1;
+
+	Option::Parser<Option::code> parser(request);
+	Option::option const* opt;
+	while((opt = parser.next()) != nullptr)
+	{
+		if(!is_block2_key(opt->ocode)) continue;
+		if(4 + opt->length > buffer_len - size)
+		{
+			ec = CoAP::errc::insufficient_buffer;
+			return size;
+		}
+		std::uint16_t ocode = static_cast<std::uint16_t>(opt->ocode),
+					length = static_cast<std::uint16_t>(opt->length);
+		std::memcpy(b + size, &ocode, 2);
+		std::memcpy(b + size + 2, &length, 2);
+		std::memcpy(b + size + 4, opt->value, opt->length);
+		size += 4 + opt->length;
+	}
+	return size;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		std::size_t KeySize>
+block2_list<Endpoint, Size, LifetimeMs, KeySize>::block2_list()
+	: etag_(CoAP::random_generator())
+{
+	static_assert(Size > 0, "Block2 list size (capacity) must be > 0");
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		std::size_t KeySize>
+template<typename Message>
+typename block2_list<Endpoint, Size, LifetimeMs, KeySize>::transfer_t*
+block2_list<Endpoint, Size, LifetimeMs, KeySize>::
+find(Endpoint const& ep, Message const& request) noexcept
+{
+	std::uint8_t data[KeySize];
+	CoAP::Error ec;
+	std::size_t len = block2_key_data(request, data, KeySize, ec);
+	if(ec) return nullptr;
+
+	std::uint32_t key = CoAP::Cache::hash(data, len);
+	CoAP::time_t now = CoAP::time();
+
+	for(unsigned i = 0; i < Size; i++)
+	{
+		transfer_t& t = list_[i];
+		if(!t.used) continue;
+		if(t.expiration <= now)
+		{
+			t.clear();
+			continue;
+		}
+		if(t.key == key && t.ep == ep
+			&& key_len_[i] == len
+			&& std::memcmp(key_data_[i], data, len) == 0)
+		{
+			t.expiration = now + LifetimeMs;
+			return &t;
+		}
+	}
+	return nullptr;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		std::size_t KeySize>
+template<typename Message>
+typename block2_list<Endpoint, Size, LifetimeMs, KeySize>::transfer_t*
+block2_list<Endpoint, Size, LifetimeMs, KeySize>::
+add(Endpoint const& ep, Message const& request,
+		void const* representation, std::size_t size) noexcept
+{
+	transfer_t* t = alloc(ep, request, size);
+	if(t)
+	{
+		t->used = true;
+		t->representation = representation;
+	}
+
+	return t;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		std::size_t KeySize>
+template<typename Message>
+typename block2_list<Endpoint, Size, LifetimeMs, KeySize>::transfer_t*
+block2_list<Endpoint, Size, LifetimeMs, KeySize>::
+add(Endpoint const& ep, Message const& request,
+		block2_read_cb read, void* data, std::size_t size) noexcept
+{
+	transfer_t* t = alloc(ep, request, size);
+	if(t)
+	{
+		t->used = true;
+		t->read = read;
+		t->data = data;
+	}
+
+	return t;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		std::size_t KeySize>
+void
+block2_list<Endpoint, Size, LifetimeMs, KeySize>::
+check() noexcept
+{
+	CoAP::time_t now = CoAP::time();
+	for(unsigned i = 0; i < Size; i++)
+		if(list_[i].used && list_[i].expiration <= now)
+			list_[i].clear();
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		std::size_t KeySize>
+typename block2_list<Endpoint, Size, LifetimeMs, KeySize>::transfer_t*
+block2_list<Endpoint, Size, LifetimeMs, KeySize>::
+operator[](unsigned index) noexcept
+{
+	if(index < Size)
+		return &list_[index];
+	return nullptr;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		std::size_t KeySize>
+template<typename Message>
+typename block2_list<Endpoint, Size, LifetimeMs, KeySize>::transfer_t*
+block2_list<Endpoint, Size, LifetimeMs, KeySize>::
+alloc(Endpoint const& ep, Message const& request, std::size_t size) noexcept
+{
+	check();
+
+	unsigned i = 0;
+	for(; i < Size; i++)
+		if(!list_[i].used) break;
+	if(i == Size) return nullptr;
+
+	CoAP::Error ec;
+	key_len_[i] = block2_key_data(request, key_data_[i], KeySize, ec);
+	if(ec) return nullptr;
+
+	transfer_t* t = &list_[i];
+	t->clear();
+	t->ep = ep;
+	t->key = CoAP::Cache::hash(key_data_[i], key_len_[i]);
+	t->size = size;
+	t->expiration = CoAP::time() + LifetimeMs;
+	/**
+	 * A new ETag to each transfer, so the client can detect if the
+	 * representation changed between blocks
+	 */
+	etag_++;
+	std::memcpy(t->etag, &etag_, sizeof(t->etag));
+
+	return t;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		std::size_t KeySize>
+template<typename Message>
+typename block2_list<Endpoint, Size, LifetimeMs, KeySize>::transfer_t*
+block2_list<Endpoint, Size, LifetimeMs, KeySize>::
+reserve(Endpoint const& ep, Message const& request) noexcept
+{
+	return alloc(ep, request, 0);
+}
+
+
+template<typename Message>
+std::uint32_t block1_key(Message const& request) noexcept
+{
+	using namespace CoAP::Message;
+
+	std::uint32_t h = CoAP::Cache::resource_key(request);
+
+	Option::option opt;
+	if(Option::get_option(request, opt, Option::code::request_tag))
+		return CoAP::Cache::hash(opt.value, opt.length, h);
+
+	return CoAP::Cache::hash(request.token, request.token_len, h);
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		unsigned CompletedLifetimeMs>
+block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::block1_list()
+{
+	static_assert(Size > 0, "Block1 list size (capacity) must be > 0");
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		unsigned CompletedLifetimeMs>
+template<typename Message,
+		typename Response>
+block1_status
+block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::
+process(Message const& request,
+		Response& response,
+		block1_sink_cb sink, void* data,
+		unsigned max_block_size,
+		CoAP::Message::code final_code) noexcept
+{
+	using namespace CoAP::Message;
+
+	check();
+
+	Option::option opt;
+	if(!Option::get_option(request, opt, Option::code::block1))
+	{
+		/**
+		 * Not a block-wise transfer: all body at this request
+		 */
+		if(request.payload_len
+			&& !sink(block1_event::data, request.payload, 0, request.payload_len, data))
+		{
+			sink(block1_event::abort, nullptr, 0, 0, data);
+			return reply(response, code::request_entity_too_large);
+		}
+		sink(block1_event::commit, nullptr, 0, request.payload_len, data);
+		return block1_status::complete;
+	}
+
+	/**
+	 * SZX = 7 is BERT at reliable transports, and reserved at UDP
+	 *
+	 * https://tools.ietf.org/html/rfc7959#section-2.2
+	 */
+	constexpr const bool reliable = is_reliable_response<Response>::value;
+	unsigned value = Option::parse_unsigned(opt);
+	if(!reliable && Option::block_szx(value) == 7)
+		return reply(response, code::bad_request);
+
+	unsigned num = Option::block_number(value),
+			bsize = Option::block_size(value, reliable);
+	std::size_t offset = Option::byte_offset(value, reliable);
+	bool more = Option::more(value);
+	block_param param;
+	param.number = num;
+	param.size = bsize;
+#if COAP_TE_RELIABLE_CONNECTION == 1
+	param.bert = reliable && Option::is_bert(value);
+#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
+
+	/**
+	 * A block with the more flag set must have the size of the block (or
+	 * a multiple of 1024 bytes, if BERT)
+	 */
+	if(more && (param.bert ?
+				(request.payload_len == 0 || request.payload_len % bsize) :
+				request.payload_len != bsize))
+		return reply(response, code::bad_request);
+
+	Option::option tag;
+	bool tagged = Option::get_option(request, tag, Option::code::request_tag);
+	std::uint32_t key = block1_key(request);
+	transfer_t* t = find(response.endpoint(), key, tagged, request);
+	if(!t && !tagged && offset != 0)
+		t = find_continuation(response.endpoint(), request, offset);
+	bool duplicated = false;
+
+	if(t && t->completed)
+	{
+		/**
+		 * Retransmission of the final block (response lost): answered again
+		 *
+		 * https://tools.ietf.org/html/rfc7252#section-4.5
+		 */
+		if(!more && (offset + request.payload_len) == t->offset)
+		{
+			block1_op_ = Option::node{Option::code::block1, t->block1};
+			response
+				.code(t->final_code)
+				.add_option(block1_op_)
+				.serialize();
+			response.factory().remove_option(block1_op_);
+
+			return block1_status::duplicated;
+		}
+		t->clear();
+		t = nullptr;
+	}
+
+	if(offset == 0)
+	{
+		//Restarting transfer
+		if(t) abort(*t);
+		t = find_free_slot();
+		if(!t) return reply(response, code::service_unavaiable);
+
+		t->used = true;
+		t->ep = response.endpoint();
+		t->key = key;
+		t->tagged = tagged;
+		t->offset = 0;
+		t->sink = sink;
+		t->data = data;
+	}
+	else
+	{
+		if(!t) return reply(response, code::request_entity_incomplete);
+		if(offset != t->offset)
+		{
+			/**
+			 * Just accepting the retransmission of the last block
+			 * received (response lost)
+			 */
+			if(!more || (offset + request.payload_len) != t->offset)
+			{
+				abort(*t);
+				return reply(response, code::request_entity_incomplete);
+			}
+			duplicated = true;
+		}
+	}
+	t->expiration = CoAP::time() + LifetimeMs;
+	if(!tagged)
+	{
+		//Following the token of the last block (the client may change it)
+		t->key = key;
+		t->token_len = request.token_len;
+		std::memcpy(t->token, request.token, request.token_len);
+	}
+
+	if(!duplicated)
+	{
+		if(request.payload_len
+			&& !t->sink(block1_event::data, request.payload, offset, request.payload_len, t->data))
+		{
+			abort(*t);
+			return reply(response, code::request_entity_too_large);
+		}
+		t->offset += request.payload_len;
+
+		if(!more)
+		{
+			t->sink(block1_event::commit, nullptr, 0, t->offset, t->data);
+
+			make_block(block1_, param);
+			t->completed = true;
+			t->block1 = block1_;
+			t->final_code = final_code;
+			t->sink = nullptr;
+			t->data = nullptr;
+			t->expiration = CoAP::time() + CompletedLifetimeMs;
+
+			block1_op_ = Option::node{Option::code::block1, block1_};
+			response.add_option(block1_op_);
+
+			return block1_status::complete;
+		}
+	}
+
+	/**
+	 * Asking the next block, with the preferred block size
+	 *
+	 * https://tools.ietf.org/html/rfc7959#section-2.3
+	 */
+	param.more = true;
+	if(!param.bert && max_block_size < bsize) param.size = max_block_size;
+	make_block(block1_, param);
+	block1_op_ = Option::node{Option::code::block1, block1_};
+	response
+		.code(code::ccontinue)
+		.add_option(block1_op_)
+		.serialize();
+	response.factory().remove_option(block1_op_);
+
+	return block1_status::partial;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		unsigned CompletedLifetimeMs>
+void
+block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::
+check() noexcept
+{
+	CoAP::time_t now = CoAP::time();
+	for(unsigned i = 0; i < Size; i++)
+		if(list_[i].used && list_[i].expiration <= now)
+			abort(list_[i]);
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		unsigned CompletedLifetimeMs>
+typename block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::transfer_t*
+block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::
+operator[](unsigned index) noexcept
+{
+	if(index < Size)
+		return &list_[index];
+	return nullptr;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		unsigned CompletedLifetimeMs>
+template<typename Message>
+typename block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::transfer_t*
+block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::
+find(Endpoint const& ep, std::uint32_t key,
+		bool tagged, Message const& request) noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+	{
+		transfer_t& t = list_[i];
+		if(!t.used
+			|| t.key != key
+			|| t.tagged != tagged
+			|| !(t.ep == ep))
+			continue;
+		if(!tagged
+			&& (t.token_len != request.token_len
+				|| std::memcmp(t.token, request.token, t.token_len) != 0))
+			continue;
+		return &t;
+	}
+
+	return nullptr;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		unsigned CompletedLifetimeMs>
+template<typename Message>
+typename block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::transfer_t*
+block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::
+find_continuation(Endpoint const& ep, Message const& request,
+		std::size_t offset) noexcept
+{
+	/**
+	 * Only if unique: two untagged uploads to the same resource waiting
+	 * the same offset can't be told apart
+	 */
+	std::uint32_t resource = CoAP::Cache::resource_key(request);
+	transfer_t* found = nullptr;
+	for(unsigned i = 0; i < Size; i++)
+	{
+		transfer_t& t = list_[i];
+		if(!t.used || t.completed || t.tagged || t.offset != offset
+			|| !(t.ep == ep)
+			|| CoAP::Cache::hash(t.token, t.token_len, resource) != t.key)
+			continue;
+		if(found) return nullptr;
+		found = &t;
+	}
+
+	return found;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		unsigned CompletedLifetimeMs>
+typename block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::transfer_t*
+block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::
+find_free_slot() noexcept
+{
+	/**
+	 * Completed transfers are only kept to answer retransmissions: the
+	 * oldest is reused if there is no free slot
+	 */
+	transfer_t* completed = nullptr;
+	for(unsigned i = 0; i < Size; i++)
+	{
+		if(!list_[i].used)
+			return &list_[i];
+		if(list_[i].completed
+			&& (!completed || list_[i].expiration < completed->expiration))
+			completed = &list_[i];
+	}
+	if(completed) completed->clear();
+
+	return completed;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		unsigned CompletedLifetimeMs>
+void
+block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::
+abort(transfer_t& t) noexcept
+{
+	if(t.sink) t.sink(block1_event::abort, nullptr, t.offset, 0, t.data);
+	t.clear();
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned LifetimeMs,
+		unsigned CompletedLifetimeMs>
+template<typename Response>
+block1_status
+block1_list<Endpoint, Size, LifetimeMs, CompletedLifetimeMs>::
+reply(Response& response, CoAP::Message::code mcode) noexcept
+{
+	response
+		.code(mcode)
+		.serialize();
+
+	return block1_status::error;
+}
+
+}//Transmission
+}//CoAP
+
+#endif /* COAP_TE_TRANSMISSION_BLOCK_WISE_IMPL_HPP__ */
@@ -0,0 +1,143 @@
+#ifndef COAP_TE_TRANSMISSION_COLLECTOR_IMPL_HPP__
+#define COAP_TE_TRANSMISSION_COLLECTOR_IMPL_HPP__
+
+#include <cstring>
+
+#include "../collector.hpp"
+
+namespace CoAP{
+namespace Transmission{
+
+template<typename Endpoint,
+		unsigned MaxResponses,
+		unsigned MaxPayloadSize>
+collector<Endpoint, MaxResponses, MaxPayloadSize>::
+collector()
+{
+	static_assert(MaxResponses > 0, "Collector size must be > 0");
+}
+
+template<typename Endpoint,
+		unsigned MaxResponses,
+		unsigned MaxPayloadSize>
+bool
+collector<Endpoint, MaxResponses, MaxPayloadSize>::
+start(void const* token, std::size_t token_len, CoAP::time_t duration) noexcept
+{
+	if(token_len > 8) return false;
+
+	std::memcpy(token_, token, token_len);
+	token_len_ = token_len;
+	count_ = 0;
+	discarded_ = 0;
+	end_time_ = CoAP::time() + duration;
+	active_ = true;
+
+	return true;
+}
+
+template<typename Endpoint,
+		unsigned MaxResponses,
+		unsigned MaxPayloadSize>
+void
+collector<Endpoint, MaxResponses, MaxPayloadSize>::
+stop() noexcept
+{
+	active_ = false;
+}
+
+template<typename Endpoint,
+		unsigned MaxResponses,
+		unsigned MaxPayloadSize>
+template<typename Message>
+bool
+collector<Endpoint, MaxResponses, MaxPayloadSize>::
+process(Endpoint const& ep, Message const& msg) noexcept
+{
+	if(!collecting()
+		|| !CoAP::Message::is_response(msg.mcode)
+		|| msg.token_len != token_len_
+		|| std::memcmp(msg.token, token_, token_len_) != 0)
+		return false;
+
+	response_t* res = nullptr;
+	for(unsigned i = 0; i < count_; i++)
+	{
+		if(responses_[i].ep == ep)
+		{
+			res = &responses_[i];
+			break;
+		}
+	}
+	if(!res)
+	{
+		if(count_ == MaxResponses)
+		{
+			discarded_++;
+			return true;
+		}
+		res = &responses_[count_++];
+		res->ep = ep;
+	}
+
+	res->mcode = msg.mcode;
+	res->payload_len = msg.payload_len;
+	std::memcpy(res->payload, msg.payload, res->size());
+
+	return true;
+}
+
+template<typename Endpoint,
+		unsigned MaxResponses,
+		unsigned MaxPayloadSize>
+bool
+collector<Endpoint, MaxResponses, MaxPayloadSize>::
+collecting() const noexcept
+{
+	return active_ && CoAP::time() < end_time_;
+}
+
+template<typename Endpoint,
+		unsigned MaxResponses,
+		unsigned MaxPayloadSize>
+bool
+collector<Endpoint, MaxResponses, MaxPayloadSize>::
+done() const noexcept
+{
+	return !collecting();
+}
+
+template<typename Endpoint,
+		unsigned MaxResponses,
+		unsigned MaxPayloadSize>
+unsigned
+collector<Endpoint, MaxResponses, MaxPayloadSize>::
+size() const noexcept
+{
+	return count_;
+}
+
+template<typename Endpoint,
+		unsigned MaxResponses,
+		unsigned MaxPayloadSize>
+typename collector<Endpoint, MaxResponses, MaxPayloadSize>::response_t const*
+collector<Endpoint, MaxResponses, MaxPayloadSize>::
+operator[](unsigned index) const noexcept
+{
+	return index >= count_ ? nullptr : &responses_[index];
+}
+
+template<typename Endpoint,
+		unsigned MaxResponses,
+		unsigned MaxPayloadSize>
+unsigned
+collector<Endpoint, MaxResponses, MaxPayloadSize>::
+discarded() const noexcept
+{
+	return discarded_;
+}
+
+}//Transmission
+}//CoAP
+
+#endif /* COAP_TE_TRANSMISSION_COLLECTOR_IMPL_HPP__ */
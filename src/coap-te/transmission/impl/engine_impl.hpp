@@ -15,12 +15,25 @@ static constexpr CoAP::Log::module engine_mod = {
 		/*.enable = */true
 };
 
+#if COAP_TE_MULTICAST == 1
+/**
+ * Connections that tell if the last message received was multicast
+ */
+template<typename Connection, typename = void>
+struct connection_has_multicast : std::false_type{};
+
+template<typename Connection>
+struct connection_has_multicast<Connection,
+	std::void_t<decltype(std::declval<Connection const&>().multicast())>> : std::true_type{};
+#endif /* COAP_TE_MULTICAST == 1 */
+
 template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+	typename Resource,
+	typename LeisureList>
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 engine(Connection&& conn, MessageID&& message_id)
 : conn_(std::move(conn)), mid_(std::move(message_id))
 {
@@ -32,8 +45,9 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+	typename Resource,
+	typename LeisureList>
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 engine(Connection&& conn, MessageID&& message_id, configure const& tconfig)
 	: conn_(std::move(conn)), mid_(std::move(message_id)), config_(tconfig)
 {
@@ -45,9 +59,10 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 void
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 default_cb(default_response_cb cb) noexcept
 {
 	static_assert(has_default_callback, "Default callback NOT set");
@@ -58,9 +73,10 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
-typename engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::resource&
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+	typename Resource,
+	typename LeisureList>
+typename engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::resource&
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 root() noexcept
 {
 	static_assert(get_profile() == profile::server, "Resource just available at 'server' profile");
@@ -71,9 +87,10 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
-typename engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::resource_root&
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+	typename Resource,
+	typename LeisureList>
+typename engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::resource_root&
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 root_node() noexcept
 {
 	static_assert(get_profile() == profile::server, "Resource just available at 'server' profile");
@@ -84,9 +101,10 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 std::uint16_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 mid() noexcept
 {
 	return mid_();
@@ -96,20 +114,42 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<bool UseEndpointTransMatch /* = false */,
 		bool UseTokenTransMatch /* = false */>
 void
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 process(endpoint& ep, std::uint8_t const* buffer, std::size_t buffer_len, CoAP::Error& ec) noexcept
 {
-	CoAP::Message::message msg;
-	CoAP::Message::parse(msg, buffer, buffer_len, ec);
+	/**
+	 * The message is parsed in stages: first the header (and token), that is
+	 * enough to dispatch empty messages and to match responses to the
+	 * transactions. The options (indexed, so searching the resource and any
+	 * other lookup doesn't parse them again) and payload are only parsed
+	 * when needed.
+	 */
+	CoAP::Message::indexed_message<> msg;
+	unsigned offset = CoAP::Message::parse_header(msg, buffer, buffer_len, ec);
+	if(!ec)
+	{
+		if(CoAP::Message::is_response(msg.mcode)
+			|| msg.mcode == CoAP::Message::code::empty)
+		{
+			process_response<UseEndpointTransMatch, UseTokenTransMatch>(ep, msg,
+					buffer + offset, buffer_len - offset, ec);
+			return;
+		}
+		CoAP::Message::parse_body(msg, buffer + offset, buffer_len - offset, ec);
+	}
 
 	if(ec)
 	{
 		if(ec == CoAP::errc::insufficient_buffer)
 		{
+#if COAP_TE_MULTICAST == 1
+			if(multicast_) return;
+#endif /* COAP_TE_MULTICAST == 1 */
 			std::size_t bu = make_response_code_error(msg,
 					buffer_,
 					packet_size,
@@ -119,31 +159,66 @@ process(endpoint& ep, std::uint8_t const* buffer, std::size_t buffer_len, CoAP::
 		return;
 	}
 
-	if(CoAP::Message::is_response(msg.mcode)
-		|| msg.mcode == CoAP::Message::code::empty)
-	{
-		process_response<UseEndpointTransMatch, UseTokenTransMatch>(ep, msg, ec);
-	}
-	else //is_request;
-	{
-		if constexpr(get_profile() == profile::server)
-			process_request(ep, msg, ec);
-		else
-			ec = CoAP::errc::request_not_supported;
-	}
+	//is_request;
+	if constexpr(get_profile() == profile::server)
+		process_request(ep, msg, ec);
+	else
+		ec = CoAP::errc::request_not_supported;
 }
 
 template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<bool CheckEndpoint, bool CheckToken>
 void
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
-process_response(endpoint& ep, CoAP::Message::message const& msg, CoAP::Error& ec) noexcept
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
+process_response(endpoint& ep,
+		CoAP::Message::indexed_message<>& msg,
+		std::uint8_t const* body, std::size_t body_len,
+		CoAP::Error& ec) noexcept
 {
-	if(list_.template check_all_response<CheckEndpoint, CheckToken>(ep, msg)) return;
+	/**
+	 * Non-confirmable empty messages (ACK, RST) and responses that nobody is
+	 * waiting (as duplicates) are dispatched by the header only. A confirmable
+	 * message is always fully parsed before it is acknowledged (a malformed
+	 * one is rejected with a RST).
+	 * https://tools.ietf.org/html/rfc7252#section-4.2
+	 */
+	auto* trans = list_.template find_response<CheckEndpoint, CheckToken>(ep, msg);
+	bool need_body = trans != nullptr
+					|| msg.mtype == CoAP::Message::type::confirmable;
+	if constexpr(has_default_callback)
+		need_body = need_body || default_cb_;
+
+	if(need_body)
+	{
+		CoAP::Message::parse_body(msg, body, body_len, ec);
+		if(ec)
+		{
+			debug(engine_mod, ec, "parsing response");
+			if(msg.mtype == CoAP::Message::type::confirmable)
+			{
+				request req{ep};
+				req.header(
+						CoAP::Message::type::reset,
+						CoAP::Message::code::empty);
+
+				CoAP::Error ecr;
+				send(req, msg.mid, ecr);
+			}
+			return;
+		}
+	}
+
+	if(trans)
+	{
+		trans->template check_response<CheckEndpoint, CheckToken>(ep, msg);
+		return;
+	}
+
 	if constexpr(has_default_callback)
 		if(default_cb_) default_cb_(ep, &msg, this);
 
@@ -162,52 +237,130 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 void
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 process_request(endpoint& ep,
-		CoAP::Message::message const& request,
+		CoAP::Message::indexed_message<> const& request,
 		CoAP::Error& ec) noexcept
 {
 	resource const* res = resource_root_.search(request);
 	if(!res)
 	{
 		status(engine_mod, "Not resource");
+#if COAP_TE_MULTICAST == 1
+		/**
+		 * Errors are not answered to multicast requests
+		 * https://tools.ietf.org/html/rfc7390#section-2.7
+		 */
+		if(multicast_) return;
+#endif /* COAP_TE_MULTICAST == 1 */
 		std::size_t bu = make_response_code_error(request, buffer_, packet_size, CoAP::Message::code::not_found);
 		conn_.send(buffer_, bu, ep, ec);
 	}
 	else
 	{
 		debug(engine_mod, "Found resource %s", res->path() ? res->path() : "/");
+		CoAP::Message::type mtype = request.mtype;
+#if COAP_TE_MULTICAST == 1
+		/**
+		 * Multicast requests are never acknowledged
+		 * https://tools.ietf.org/html/rfc7252#section-8.1
+		 */
+		if(multicast_) mtype = CoAP::Message::type::nonconfirmable;
+#endif /* COAP_TE_MULTICAST == 1 */
 		response response(ep,
-				request.mtype,
-				request.mtype == CoAP::Message::type::confirmable ?
+				mtype,
+				mtype == CoAP::Message::type::confirmable ?
 						request.mid : mid_(),
 				request.token, request.token_len,
 				buffer_, packet_size);
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+		/**
+		 * Payloads bigger than a block are sliced by the response. A request
+		 * of a block after the first continues the ongoing transfer (the
+		 * representation kept); otherwise a free slot is given to start one.
+		 */
+		auto* transfer = block2_.find(ep, request);
+		if(transfer)
+		{
+			CoAP::Message::Option::option opt;
+			if(!CoAP::Message::Option::get_option(request, opt, CoAP::Message::Option::code::block2)
+				|| CoAP::Message::Option::byte_offset(CoAP::Message::Option::parse_unsigned(opt)) == 0)
+			{
+				transfer->clear();
+				transfer = nullptr;
+			}
+		}
+		if(!transfer) transfer = block2_.reserve(ep, request);
+		response.auto_block2(request, block_size_fit(packet_size), transfer);
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
 		if(res->call(request.mcode, request, response, this))
 		{
 			debug(engine_mod, "Method found");
 			if(!response.error() && response.buffer_used() > 0)
 			{
+#if COAP_TE_MULTICAST == 1
+				send_response(ep, response.buffer(), response.buffer_used(), ec);
+#else /* COAP_TE_MULTICAST == 1 */
 				conn_.send(response.buffer(), response.buffer_used(), ep, ec);
+#endif /* COAP_TE_MULTICAST == 1 */
 			}
 		}
 		else
 		{
+#if COAP_TE_MULTICAST == 1
+			if(multicast_) return;
+#endif /* COAP_TE_MULTICAST == 1 */
 			std::size_t bu = make_response_code_error(request, buffer_, packet_size, CoAP::Message::code::method_not_allowed);
 			conn_.send(buffer_, bu, ep, ec);
 		}
 	}
 }
 
+#if COAP_TE_MULTICAST == 1
+template<typename Connection,
+	typename MessageID,
+	typename TransactionList,
+	typename Callback_Default_Functor,
+	typename Resource,
+	typename LeisureList>
+void
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
+send_response(endpoint& ep, void const* buffer, std::size_t size, CoAP::Error& ec) noexcept
+{
+	if(multicast_)
+	{
+		/**
+		 * Error responses are suppressed, and the others are spread
+		 * at the leisure period
+		 * https://tools.ietf.org/html/rfc7252#section-8.2
+		 */
+		auto mcode = static_cast<CoAP::Message::code>(static_cast<std::uint8_t const*>(buffer)[1]);
+		if(CoAP::Message::is_error(mcode))
+		{
+			debug(engine_mod, "Suppressing multicast error response");
+			return;
+		}
+		if constexpr(has_leisure_list)
+		{
+			if(leisure_.add(ep, buffer, size, config_)) return;
+			status(engine_mod, "Leisure list full, sending multicast response");
+		}
+	}
+	conn_.send(buffer, size, ep, ec);
+}
+#endif /* COAP_TE_MULTICAST == 1 */
+
 template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 void
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 check_transactions() noexcept
 {
 	int i = 0;
@@ -234,12 +387,13 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<int BlockTimeMs,
 		bool UseEndpointTransMatch /* = false */,
 		bool UseTokenTransMatch /* = false */>
 bool
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 run(CoAP::Error& ec) noexcept
 {
 	endpoint ep;
@@ -256,10 +410,21 @@ run(CoAP::Error& ec) noexcept
 		char buf_print[20];
 		debug(engine_mod, "From: %s:%u", ep.address(buf_print), ep.port());
 		CoAP::Log::debug(engine_mod, "Received %d bytes", size);
+#if COAP_TE_MULTICAST == 1
+		if constexpr(connection_has_multicast<Connection>::value)
+			multicast_ = conn_.multicast();
+#endif /* COAP_TE_MULTICAST == 1 */
 		process<UseEndpointTransMatch, UseTokenTransMatch>(ep, buffer_, size, ec);
+#if COAP_TE_MULTICAST == 1
+		multicast_ = false;
+#endif /* COAP_TE_MULTICAST == 1 */
 	}
 
 	check_transactions();
+#if COAP_TE_MULTICAST == 1
+	if constexpr(has_leisure_list)
+		leisure_.check(conn_);
+#endif /* COAP_TE_MULTICAST == 1 */
 
 	return true;
 }
@@ -268,9 +433,10 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 bool
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 operator()(CoAP::Error& ec) noexcept
 {
 	return run(ec);
@@ -280,9 +446,10 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 make_response(message const& received_message,
 				void* buffer, size_t buffer_len,
 				CoAP::Message::code mcode,
@@ -290,7 +457,7 @@ make_response(message const& received_message,
 				void const* const payload, std::size_t payload_len,
 				CoAP::Error& ec) noexcept
 {
-	return engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+	return engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 			make_response(received_message,
 					buffer, buffer_len,
 					mcode,
@@ -305,9 +472,10 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 make_response(message const& received_message,
 				void* buffer, size_t buffer_len,
 				CoAP::Message::code mcode, std::uint16_t message_id,
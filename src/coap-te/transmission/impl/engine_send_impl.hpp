@@ -10,7 +10,8 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<bool UseInternalBufferNon,
 	bool SortOptions,
 	bool CheckOpOrder,
@@ -18,7 +19,7 @@ template<bool UseInternalBufferNon,
 	std::size_t BufferSize,
 	typename Message_ID>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 send(endpoint& ep,
 		configure const& config,
 		CoAP::Message::Factory<BufferSize, Message_ID> const& fac,
@@ -68,7 +69,8 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<bool UseInternalBufferNon,
 		bool SortOptions,
 		bool CheckOpOrder,
@@ -76,7 +78,7 @@ template<bool UseInternalBufferNon,
 		std::size_t BufferSize,
 		typename Message_ID>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 send(endpoint& ep,
 		CoAP::Message::Factory<BufferSize, Message_ID> const& fac,
 		transaction_cb func, void* data,
@@ -89,7 +91,8 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<bool UseInternalBufferNon,
 		bool SortOptions,
 		bool CheckOpOrder,
@@ -97,7 +100,7 @@ template<bool UseInternalBufferNon,
 		std::size_t BufferSize,
 		typename Message_ID>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 send(endpoint& ep,
 		CoAP::Message::Factory<BufferSize, Message_ID> const& fac,
 		std::uint16_t mid,
@@ -111,13 +114,14 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<bool UseInternalBufferNon,
 		bool SortOptions,
 		bool CheckOpOrder,
 		bool CheckOpRepeat>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 send(request& req,
 	std::uint16_t mid,
 	CoAP::Error& ec) noexcept
@@ -130,13 +134,14 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<bool UseInternalBufferNon,
 		bool SortOptions,
 		bool CheckOpOrder,
 		bool CheckOpRepeat>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 send(request& req,
 	CoAP::Error& ec) noexcept
 {
@@ -148,7 +153,8 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<bool UseInternalBufferNon,
 	bool SortOptions,
 	bool CheckOpOrder,
@@ -156,7 +162,7 @@ template<bool UseInternalBufferNon,
 	std::size_t BufferSize,
 	typename Message_ID>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 send(endpoint& ep,
 		configure const& config,
 		CoAP::Message::Factory<BufferSize, Message_ID> const& fac,
@@ -170,13 +176,14 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<bool UseInternalBufferNon,
 		bool SortOptions,
 		bool CheckOpOrder,
 		bool CheckOpRepeat>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 send(request& req,
 			configure const& config,
 			std::uint16_t mid,
@@ -190,13 +197,14 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
 template<bool UseInternalBufferNon,
 		bool SortOptions,
 		bool CheckOpOrder,
 		bool CheckOpRepeat>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 send(request& req,
 		configure const& config,
 		CoAP::Error& ec) noexcept
@@ -209,9 +217,85 @@ template<typename Connection,
 	typename MessageID,
 	typename TransactionList,
 	typename Callback_Default_Functor,
-	typename Resource>
+	typename Resource,
+	typename LeisureList>
+template<bool UseInternalBufferNon,
+		std::size_t TemplateSize,
+		unsigned TemplateRegions>
+std::size_t
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
+send(endpoint& ep,
+		configure const& config,
+		CoAP::Message::request_template<TemplateSize, TemplateRegions> const& req,
+		std::uint16_t mid,
+		transaction_cb func, void* data,
+		CoAP::Error& ec) noexcept
+{
+	std::size_t size = 0;
+	if constexpr(UseInternalBufferNon)
+	{
+		if(req.type() == CoAP::Message::type::nonconfirmable)
+		{
+			size = req.serialize(buffer_, packet_size, mid, ec);
+			if(ec) return size;
+			conn_.send(buffer_, size, ep, ec);
+			return size;
+		}
+	}
+
+	transaction_t* ts = list_.find_free_slot();
+	if(!ts)
+	{
+		ec = CoAP::errc::no_free_slots;
+		return size;
+	}
+	ts->lock();
+
+	size = ts->serialize(req, mid, ec);
+	if(ec)
+	{
+		ts->release();
+		return size;
+	}
+
+	conn_.send(ts->buffer(), ts->buffer_used(), ep, ec);
+	if(ec)
+	{
+		ts->release();
+		return size;
+	}
+	ts->init(config, ep, func, data, ec);
+
+	return size;
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename TransactionList,
+	typename Callback_Default_Functor,
+	typename Resource,
+	typename LeisureList>
+template<bool UseInternalBufferNon,
+		std::size_t TemplateSize,
+		unsigned TemplateRegions>
+std::size_t
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
+send(endpoint& ep,
+		CoAP::Message::request_template<TemplateSize, TemplateRegions> const& req,
+		transaction_cb func, void* data,
+		CoAP::Error& ec) noexcept
+{
+	return send<UseInternalBufferNon>(ep, config_, req, mid_(), func, data, ec);
+}
+
+template<typename Connection,
+	typename MessageID,
+	typename TransactionList,
+	typename Callback_Default_Functor,
+	typename Resource,
+	typename LeisureList>
 std::size_t
-engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource>::
+engine<Connection, MessageID, TransactionList, Callback_Default_Functor, Resource, LeisureList>::
 send(endpoint& ep, const void* buffer, std::size_t buffer_len, CoAP::Error& ec) noexcept
 {
 	return conn_.send(buffer, buffer_len, ep, ec);
@@ -0,0 +1,96 @@
+#ifndef COAP_TE_TRANSMISSION_LEISURE_LIST_IMPL_HPP__
+#define COAP_TE_TRANSMISSION_LEISURE_LIST_IMPL_HPP__
+
+#include <cstring>
+
+#include "../leisure_list.hpp"
+#include "../../log.hpp"
+
+namespace CoAP{
+namespace Transmission{
+
+static constexpr CoAP::Log::module leisure_mod = {
+		/*.name = */"LEISURE",
+		/*.max_level = */CoAP::Log::type::debug,
+		/*.enable = */true
+};
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxPacketSize>
+leisure_list<Endpoint, Size, MaxPacketSize>::
+leisure_list()
+{
+	static_assert(Size > 0, "Leisure list size must be > 0");
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxPacketSize>
+bool
+leisure_list<Endpoint, Size, MaxPacketSize>::
+add(Endpoint const& ep,
+		void const* buffer, std::size_t buffer_len,
+		configure const& config) noexcept
+{
+	if(buffer_len > MaxPacketSize) return false;
+
+	for(unsigned i = 0; i < Size; i++)
+	{
+		node& n = nodes_[i];
+		if(n.used) continue;
+
+		CoAP::time_t leisure = static_cast<CoAP::time_t>(config.default_leisure_seconds) * 1000;
+		n.used = true;
+		n.ep = ep;
+		n.send_time = CoAP::time()
+				+ (leisure ? CoAP::random_generator() % leisure : 0);
+		n.size = buffer_len;
+		std::memcpy(n.buffer, buffer, buffer_len);
+
+		debug(leisure_mod, "Response scheduled to %lu ms",
+				static_cast<unsigned long>(n.send_time - CoAP::time()));
+		return true;
+	}
+
+	return false;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxPacketSize>
+template<typename Connection>
+void
+leisure_list<Endpoint, Size, MaxPacketSize>::
+check(Connection& conn) noexcept
+{
+	CoAP::time_t now = CoAP::time();
+	for(unsigned i = 0; i < Size; i++)
+	{
+		node& n = nodes_[i];
+		if(!n.used || now < n.send_time) continue;
+
+		CoAP::Error ec;
+		conn.send(n.buffer, n.size, n.ep, ec);
+		if(ec) error(leisure_mod, ec, "Error sending response");
+		n.used = false;
+	}
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxPacketSize>
+unsigned
+leisure_list<Endpoint, Size, MaxPacketSize>::
+size() const noexcept
+{
+	unsigned count = 0;
+	for(unsigned i = 0; i < Size; i++)
+		if(nodes_[i].used) count++;
+	return count;
+}
+
+}//Transmission
+}//CoAP
+
+#endif /* COAP_TE_TRANSMISSION_LEISURE_LIST_IMPL_HPP__ */
@@ -0,0 +1,1142 @@
+#ifndef COAP_TE_TRANSMISSION_Q_BLOCK_IMPL_HPP__
+#define COAP_TE_TRANSMISSION_Q_BLOCK_IMPL_HPP__
+
+#include <cstring>
+
+#include "../q_block.hpp"
+#include "../../message/factory.hpp"
+#include "../../message/options/parser.hpp"
+#include "../../message/options/functions.hpp"
+#include "../../message/options/functions2.hpp"
+#include "../../cache/functions.hpp"
+#include "../../log.hpp"
+
+namespace CoAP{
+namespace Transmission{
+
+static constexpr CoAP::Log::module q_block_mod = {
+		/*.name = */"Q-BLOCK",
+		/*.max_level = */CoAP::Log::type::debug,
+		/*.enable = */true
+};
+
+/**
+ * Bitmap
+ */
+template<unsigned MaxBlocks>
+q_block_bitmap<MaxBlocks>::q_block_bitmap()
+{
+	static_assert(MaxBlocks > 0, "Q-Block max blocks must be > 0");
+	clear();
+}
+
+template<unsigned MaxBlocks>
+bool
+q_block_bitmap<MaxBlocks>::
+set(unsigned num) noexcept
+{
+	if(num >= MaxBlocks) return false;
+	if(test(num)) return true;
+
+	bits_[num / 8] |= static_cast<std::uint8_t>(1 << (num % 8));
+	count_++;
+	if(num >= higher_) higher_ = num + 1;
+
+	return true;
+}
+
+template<unsigned MaxBlocks>
+bool
+q_block_bitmap<MaxBlocks>::
+test(unsigned num) const noexcept
+{
+	return num < MaxBlocks && (bits_[num / 8] & (1 << (num % 8)));
+}
+
+template<unsigned MaxBlocks>
+void
+q_block_bitmap<MaxBlocks>::
+last(unsigned num) noexcept
+{
+	total_ = num + 1;
+}
+
+template<unsigned MaxBlocks>
+unsigned
+q_block_bitmap<MaxBlocks>::
+missing(unsigned* blocks, unsigned max_count) const noexcept
+{
+	unsigned end = total_ ? total_ : higher_, count = 0;
+	for(unsigned i = 0; i < end && count < max_count; i++)
+		if(!test(i)) blocks[count++] = i;
+
+	return count;
+}
+
+template<unsigned MaxBlocks>
+void
+q_block_bitmap<MaxBlocks>::
+clear() noexcept
+{
+	std::memset(bits_, 0, sizeof(bits_));
+	count_ = 0;
+	total_ = 0;
+	higher_ = 0;
+}
+
+/**
+ * Sender
+ */
+template<typename Endpoint,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+bool
+q_block_transfer<Endpoint, MaxMissing, MaxOptions, MaxOptionsSize>::
+add_missing(unsigned num) noexcept
+{
+	for(unsigned i = 0; i < missing_count; i++)
+		if(missing[i] == num) return true;
+
+	if(missing_count >= MaxMissing) return false;
+	missing[missing_count++] = num;
+
+	return true;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::q_block_sender_list()
+	: etag_(CoAP::random_generator())
+{
+	static_assert(Size > 0, "Q-Block list size (capacity) must be > 0");
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+q_block_sender_list(q_block_configure const& config)
+	: etag_(CoAP::random_generator()), config_(config)
+{
+	static_assert(Size > 0, "Q-Block list size (capacity) must be > 0");
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+template<typename Message,
+		typename Response>
+typename q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::transfer_t*
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+process(Message const& request, Response& response,
+		void const* representation, std::size_t size,
+		unsigned max_block_size,
+		CoAP::Message::Option::option const* options,
+		unsigned options_count) noexcept
+{
+	return process_impl(request, response, representation, nullptr, nullptr, size,
+			max_block_size, options, options_count);
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+template<typename Message,
+		typename Response>
+typename q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::transfer_t*
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+process(Message const& request, Response& response,
+		block2_read_cb read, void* data, std::size_t size,
+		unsigned max_block_size,
+		CoAP::Message::Option::option const* options,
+		unsigned options_count) noexcept
+{
+	return process_impl(request, response, nullptr, read, data, size,
+			max_block_size, options, options_count);
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+typename q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::transfer_t*
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+add(Endpoint const& ep, CoAP::Message::code method,
+		void const* token, std::size_t token_len,
+		void const* representation, std::size_t size,
+		unsigned block_size,
+		CoAP::Message::Option::option const* options,
+		unsigned options_count) noexcept
+{
+	return init(ep, CoAP::Cache::hash(token, token_len),
+			CoAP::Message::Option::code::q_block1, method,
+			token, token_len,
+			representation, nullptr, nullptr,
+			size, block_size,
+			options, options_count);
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+typename q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::transfer_t*
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+add(Endpoint const& ep, CoAP::Message::code method,
+		void const* token, std::size_t token_len,
+		block2_read_cb read, void* data, std::size_t size,
+		unsigned block_size,
+		CoAP::Message::Option::option const* options,
+		unsigned options_count) noexcept
+{
+	return init(ep, CoAP::Cache::hash(token, token_len),
+			CoAP::Message::Option::code::q_block1, method,
+			token, token_len,
+			nullptr, read, data,
+			size, block_size,
+			options, options_count);
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+template<typename Message>
+bool
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+response(Endpoint const& ep, Message const& response) noexcept
+{
+	using namespace CoAP::Message;
+
+	for(unsigned i = 0; i < Size; i++)
+	{
+		transfer_t& t = list_[i];
+		if(!t.used
+			|| t.ocode != Option::code::q_block1
+			|| t.token_len != response.token_len
+			|| std::memcmp(t.token, response.token, t.token_len) != 0
+			|| !(t.ep == ep))
+			continue;
+
+		CoAP::time_t now = CoAP::time();
+		t.expiration = now + config_.non_partial_timeout_ms;
+		if(response.mcode == code::ccontinue)
+		{
+			//Next set can be sent now
+			t.burst = 0;
+			t.next_send = now;
+			return true;
+		}
+
+		Option::option opt;
+		if(response.mcode == code::request_entity_incomplete
+			&& Option::get_option(response, opt, Option::code::content_format)
+			&& Option::parse_unsigned(opt) == missing_blocks_content_format)
+		{
+			unsigned blocks[MaxMissing];
+			unsigned count = decode_missing_blocks(response.payload, response.payload_len,
+											blocks, MaxMissing);
+			debug(q_block_mod, "Missing blocks requested: %u", count);
+			for(unsigned j = 0; j < count; j++)
+				if(blocks[j] < t.blocks()) t.add_missing(blocks[j]);
+			t.burst = 0;
+			t.next_send = now;
+			return true;
+		}
+
+		//Final response
+		t.clear();
+		return true;
+	}
+	return false;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+template<typename Engine>
+void
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+check(Engine& engine) noexcept
+{
+	CoAP::time_t now = CoAP::time();
+	for(unsigned i = 0; i < Size; i++)
+	{
+		transfer_t& t = list_[i];
+		if(!t.used) continue;
+		if(t.expiration <= now)
+		{
+			t.clear();
+			continue;
+		}
+		if(now < t.next_send) continue;
+
+		while(t.burst < config_.max_payloads)
+		{
+			unsigned num;
+			if(t.missing_count)
+			{
+				num = t.missing[0];
+				t.missing_count--;
+				std::memmove(t.missing, t.missing + 1, t.missing_count * sizeof(unsigned));
+			}
+			else if(t.next < t.blocks())
+				num = t.next++;
+			else break;
+
+			send_block(engine, t, num);
+			t.burst++;
+		}
+
+		/**
+		 * Waiting NON_TIMEOUT to send the next set (or a 2.31 Continue)
+		 */
+		if(t.burst >= config_.max_payloads)
+		{
+			t.burst = 0;
+			t.next_send = now + config_.non_timeout_ms;
+		}
+
+		/**
+		 * Q-Block2 all sent: the slot is only kept while the client may ask
+		 * missing blocks (it does after NON_RECEIVE_TIMEOUT), not by the
+		 * NON_PARTIAL_TIMEOUT. A request after that restarts the transfer.
+		 */
+		if(t.ocode == CoAP::Message::Option::code::q_block2
+			&& t.next >= t.blocks() && !t.missing_count)
+		{
+			CoAP::time_t done = now + 2 * config_.non_receive_timeout_ms;
+			if(done < t.expiration) t.expiration = done;
+		}
+	}
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+typename q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::transfer_t*
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+operator[](unsigned index) noexcept
+{
+	if(index < Size)
+		return &list_[index];
+	return nullptr;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+template<typename Message,
+		typename Response>
+typename q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::transfer_t*
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+process_impl(Message const& request, Response& response,
+		void const* representation,
+		block2_read_cb read, void* data,
+		std::size_t size,
+		unsigned max_block_size,
+		CoAP::Message::Option::option const* options,
+		unsigned options_count) noexcept
+{
+	using namespace CoAP::Message;
+
+	/**
+	 * Q-Block2 is repeatable: a request may ask more than one missing block
+	 */
+	unsigned values[MaxMissing];
+	unsigned count = 0;
+	Option::Parser<Option::code> parser(request);
+	Option::option const* opt;
+	while((opt = parser.next()) != nullptr)
+		if(opt->ocode == Option::code::q_block2 && count < MaxMissing)
+			values[count++] = Option::parse_unsigned(*opt);
+
+	std::uint32_t key = block2_key(request);
+	transfer_t* t = find(response.endpoint(), key);
+	CoAP::time_t now = CoAP::time();
+
+	/**
+	 * A new transfer (new ETag) only if there is no transfer, it's a plain
+	 * request or the representation changed. A request for block 0 of a ongoing
+	 * transfer is a missing block request.
+	 */
+	if(!t || count == 0 || t->size != size)
+	{
+		unsigned block_size = max_block_size;
+		if(count && Option::block_size(values[0]) < block_size)
+			block_size = Option::block_size(values[0]);
+
+		t = init(response.endpoint(), key,
+				Option::code::q_block2, code::content,
+				request.token, request.token_len,
+				representation, read, data,
+				size, block_size,
+				options, options_count, t);
+		if(!t)
+		{
+			response
+				.code(code::service_unavaiable)
+				.serialize();
+			return nullptr;
+		}
+
+		respond_block(response, *t, 0);
+		t->next = 1;
+		t->burst = 1;
+		return t;
+	}
+
+	/**
+	 * Request for missing blocks (with the token of this request)
+	 */
+	std::memcpy(t->token, request.token, request.token_len);
+	t->token_len = request.token_len;
+	t->representation = representation;
+	t->read = read;
+	t->data = data;
+
+	bool has_first = false;
+	unsigned first = 0;
+	for(unsigned i = 0; i < count; i++)
+	{
+		unsigned num = Option::block_number(values[i]);
+		if(num >= t->blocks()) continue;
+
+		if(Option::more(values[i]))
+			t->next = num + (has_first ? 0 : 1);
+		if(!has_first)
+		{
+			first = num;
+			has_first = true;
+		}
+		else if(!Option::more(values[i]))
+			t->add_missing(num);
+	}
+
+	if(!has_first)
+	{
+		response
+			.code(code::bad_request)
+			.serialize();
+		return t;
+	}
+
+	t->expiration = now + config_.non_partial_timeout_ms;
+	t->burst = 1;
+	t->next_send = now;
+	respond_block(response, *t, first);
+
+	return t;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+typename q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::transfer_t*
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+init(Endpoint const& ep, std::uint32_t key,
+		CoAP::Message::Option::code ocode, CoAP::Message::code mcode,
+		void const* token, std::size_t token_len,
+		void const* representation,
+		block2_read_cb read, void* data,
+		std::size_t size, unsigned block_size,
+		CoAP::Message::Option::option const* options,
+		unsigned options_count,
+		transfer_t* t /* = nullptr */) noexcept
+{
+	if(!t) t = find_free_slot();
+	if(!t || token_len > sizeof(t->token)) return nullptr;
+
+	CoAP::time_t now = CoAP::time();
+
+	t->clear();
+	t->used = true;
+	t->ep = ep;
+	t->key = key;
+	t->ocode = ocode;
+	t->mcode = mcode;
+	std::memcpy(t->token, token, token_len);
+	t->token_len = token_len;
+	t->options_count = 0;
+	std::size_t used = 0;
+	for(unsigned i = 0; i < options_count; i++)
+	{
+		if(i >= MaxOptions || (used + options[i].length) > MaxOptionsSize)
+		{
+			error(q_block_mod, "Options don't fit at transfer");
+			t->clear();
+			return nullptr;
+		}
+		std::memcpy(t->option_values + used, options[i].value, options[i].length);
+		t->options[i] = options[i];
+		t->options[i].value = t->option_values + used;
+		used += options[i].length;
+		t->options_count++;
+	}
+	t->representation = representation;
+	t->read = read;
+	t->data = data;
+	t->size = size;
+	t->block_size = block_size;
+	t->next = 0;
+	t->burst = 0;
+	t->next_send = now;
+	t->expiration = now + config_.non_partial_timeout_ms;
+
+	etag_++;
+	std::memcpy(t->etag, &etag_, sizeof(t->etag));
+
+	return t;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+typename q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::transfer_t*
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+find(Endpoint const& ep, std::uint32_t key) noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+		if(list_[i].used
+			&& list_[i].key == key
+			&& list_[i].ep == ep)
+			return &list_[i];
+
+	return nullptr;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+typename q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::transfer_t*
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+find_free_slot() noexcept
+{
+	CoAP::time_t now = CoAP::time();
+	for(unsigned i = 0; i < Size; i++)
+		if(!list_[i].used || list_[i].expiration <= now)
+			return &list_[i];
+
+	return nullptr;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+block_param
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+make_param(transfer_t const& t, unsigned num) noexcept
+{
+	block_param param;
+
+	param.number = num;
+	param.size = t.block_size;
+	param.offset = static_cast<std::size_t>(num) * t.block_size;
+	param.length = param.offset < t.size ? t.size - param.offset : 0;
+	if(param.length > param.size) param.length = param.size;
+	param.more = (param.offset + param.length) < t.size;
+
+	return param;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+template<typename Engine>
+void
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+send_block(Engine& engine, transfer_t& t, unsigned num) noexcept
+{
+	using namespace CoAP::Message;
+
+	std::uint8_t buffer[Engine::packet_size];
+	block_param param = make_param(t, num);
+
+	Factory<> fac;
+	fac.header(type::nonconfirmable, t.mcode, t.token, t.token_len);
+
+	Option::node nodes[MaxOptions];
+	for(unsigned i = 0; i < t.options_count; i++)
+	{
+		nodes[i] = Option::node{t.options[i]};
+		fac.add_option(nodes[i]);
+	}
+
+	unsigned block;
+	Option::make_block(block, param.number, param.more, param.size);
+	Option::node block_op{t.ocode, block};
+	fac.add_option(block_op);
+
+	unsigned size = static_cast<unsigned>(t.size);
+	Option::node size_op{t.ocode == Option::code::q_block2 ?
+							Option::code::size2 : Option::code::size1, size};
+	if(num == 0) fac.add_option(size_op);
+
+	/**
+	 * ETag identifies the representation (Q-Block2), and Request-Tag the
+	 * body (Q-Block1)
+	 *
+	 * https://tools.ietf.org/html/rfc9177#section-4.4
+	 */
+	Option::node tag_op{t.ocode == Option::code::q_block2 ?
+							Option::code::etag : Option::code::request_tag,
+						t.etag, static_cast<unsigned>(sizeof(t.etag))};
+	fac.add_option(tag_op);
+
+	if(t.representation)
+		fac.payload(static_cast<std::uint8_t const*>(t.representation) + param.offset,
+					param.length);
+
+	CoAP::Error ec;
+	std::size_t length = fac.serialize(buffer, sizeof(buffer), engine.mid(), ec);
+	if(ec)
+	{
+		error(q_block_mod, ec, "serialize block");
+		return;
+	}
+
+	if(!t.representation && t.read && param.length)
+	{
+		if((sizeof(buffer) - length) < (param.length + 1))
+		{
+			error(q_block_mod, "Block bigger than packet size");
+			return;
+		}
+		std::size_t readed = t.read(buffer + length + 1, param.offset, param.length, t.data);
+		if(readed)
+		{
+			buffer[length] = payload_marker;
+			length += readed + 1;
+		}
+	}
+
+	debug(q_block_mod, "Sending block %u/%u", num, t.blocks());
+	engine.send(t.ep, buffer, length, ec);
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+template<typename Response>
+void
+q_block_sender_list<Endpoint, Size, MaxMissing, MaxOptions, MaxOptionsSize>::
+respond_block(Response& response, transfer_t& t, unsigned num) noexcept
+{
+	using namespace CoAP::Message;
+
+	Option::node nodes[MaxOptions];
+	for(unsigned i = 0; i < t.options_count; i++)
+	{
+		nodes[i] = Option::node{t.options[i]};
+		response.add_option(nodes[i]);
+	}
+
+	response
+		.code(t.mcode)
+		.serialize_block(t.ocode, make_param(t, num),
+			t.representation, t.read, t.data, t.size,
+			num == 0, t.etag, sizeof(t.etag));
+
+	for(unsigned i = 0; i < t.options_count; i++)
+		response.factory().remove_option(nodes[i]);
+}
+
+/**
+ * Q-Block1 receiver
+ */
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+q_block1_list<Endpoint, Size, MaxBlocks>::q_block1_list()
+{
+	static_assert(Size > 0, "Q-Block1 list size (capacity) must be > 0");
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+q_block1_list<Endpoint, Size, MaxBlocks>::
+q_block1_list(q_block_configure const& config)
+	: config_(config)
+{
+	static_assert(Size > 0, "Q-Block1 list size (capacity) must be > 0");
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+template<typename Message,
+		typename Response>
+block1_status
+q_block1_list<Endpoint, Size, MaxBlocks>::
+process(Message const& request,
+		Response& response,
+		block1_sink_cb sink, void* data) noexcept
+{
+	using namespace CoAP::Message;
+
+	CoAP::time_t now = CoAP::time();
+	for(unsigned i = 0; i < Size; i++)
+		if(list_[i].used && list_[i].expiration <= now)
+			abort(list_[i]);
+
+	Option::option opt;
+	if(!Option::get_option(request, opt, Option::code::q_block1))
+	{
+		/**
+		 * Not a block-wise transfer: all body at this request
+		 */
+		if(request.payload_len
+			&& !sink(block1_event::data, request.payload, 0, request.payload_len, data))
+		{
+			sink(block1_event::abort, nullptr, 0, 0, data);
+			return reply(response, code::request_entity_too_large);
+		}
+		sink(block1_event::commit, nullptr, 0, request.payload_len, data);
+		return block1_status::complete;
+	}
+
+	unsigned value = Option::parse_unsigned(opt);
+	unsigned num = Option::block_number(value),
+			bsize = Option::block_size(value);
+	bool more = Option::more(value);
+
+	/**
+	 * SZX = 7 is reserved (no BERT at Q-Block)
+	 */
+	if(Option::block_szx(value) == 7
+		|| (more && request.payload_len != bsize))
+		return reply(response, code::bad_request);
+
+	std::uint32_t key = block1_key(request);
+	transfer_t* t = find(response.endpoint(), key);
+	if(!t)
+	{
+		t = find_free_slot();
+		if(!t) return reply(response, code::service_unavaiable);
+
+		t->clear();
+		t->used = true;
+		t->ep = response.endpoint();
+		t->key = key;
+		std::memcpy(t->token, request.token, request.token_len);
+		t->token_len = request.token_len;
+		t->block_size = bsize;
+		t->sink = sink;
+		t->data = data;
+	}
+
+	/**
+	 * Block size must not change, and the number of blocks is bounded
+	 */
+	if(bsize != t->block_size)
+	{
+		abort(*t);
+		return reply(response, code::request_entity_incomplete);
+	}
+	if(num >= MaxBlocks)
+	{
+		abort(*t);
+		return reply(response, code::request_entity_too_large);
+	}
+
+	t->last_received = now;
+	t->expiration = now + config_.non_partial_timeout_ms;
+	t->retransmit = 0;
+
+	if(!t->bitmap.test(num))
+	{
+		if(request.payload_len
+			&& !t->sink(block1_event::data, request.payload,
+					static_cast<std::size_t>(num) * bsize, request.payload_len, t->data))
+		{
+			abort(*t);
+			return reply(response, code::request_entity_too_large);
+		}
+		t->bitmap.set(num);
+		t->received++;
+	}
+
+	if(!more)
+	{
+		t->bitmap.last(num);
+		t->size = static_cast<std::size_t>(num) * bsize + request.payload_len;
+	}
+
+	if(t->bitmap.complete())
+	{
+		t->sink(block1_event::commit, nullptr, 0, t->size, t->data);
+		t->clear();
+
+		Option::make_block(qblock1_, num, false, bsize);
+		qblock1_op_ = Option::node{Option::code::q_block1, qblock1_};
+		response.add_option(qblock1_op_);
+
+		return block1_status::complete;
+	}
+
+	/**
+	 * Asking the next set
+	 */
+	if(more && t->received >= config_.max_payloads)
+	{
+		t->received = 0;
+		Option::make_block(qblock1_, num, true, bsize);
+		qblock1_op_ = Option::node{Option::code::q_block1, qblock1_};
+		response
+			.code(code::ccontinue)
+			.add_option(qblock1_op_)
+			.serialize();
+		response.factory().remove_option(qblock1_op_);
+
+		return block1_status::partial;
+	}
+
+	/**
+	 * Last block received with blocks missing: asking them now
+	 *
+	 * https://tools.ietf.org/html/rfc9177#section-4.4
+	 */
+	if(!more)
+	{
+		t->received = 0;
+		return reply_missing(response, *t);
+	}
+
+	/**
+	 * No response to the other blocks (missing blocks are requested at 'check')
+	 */
+	if(request.mtype == type::confirmable)
+		response.serialize_empty_ack();
+
+	return block1_status::partial;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+template<typename Engine>
+void
+q_block1_list<Endpoint, Size, MaxBlocks>::
+check(Engine& engine) noexcept
+{
+	CoAP::time_t now = CoAP::time();
+	for(unsigned i = 0; i < Size; i++)
+	{
+		transfer_t& t = list_[i];
+		if(!t.used) continue;
+		if(t.expiration <= now)
+		{
+			abort(t);
+			continue;
+		}
+		if(now < (t.last_received + config_.non_receive_timeout_ms)) continue;
+		if(t.retransmit >= config_.non_max_retransmit)
+		{
+			abort(t);
+			continue;
+		}
+
+		send_missing(engine, t);
+		t.retransmit++;
+		t.last_received = now;
+	}
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+typename q_block1_list<Endpoint, Size, MaxBlocks>::transfer_t*
+q_block1_list<Endpoint, Size, MaxBlocks>::
+operator[](unsigned index) noexcept
+{
+	if(index < Size)
+		return &list_[index];
+	return nullptr;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+typename q_block1_list<Endpoint, Size, MaxBlocks>::transfer_t*
+q_block1_list<Endpoint, Size, MaxBlocks>::
+find(Endpoint const& ep, std::uint32_t key) noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+		if(list_[i].used
+			&& list_[i].key == key
+			&& list_[i].ep == ep)
+			return &list_[i];
+
+	return nullptr;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+typename q_block1_list<Endpoint, Size, MaxBlocks>::transfer_t*
+q_block1_list<Endpoint, Size, MaxBlocks>::
+find_free_slot() noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+		if(!list_[i].used)
+			return &list_[i];
+
+	return nullptr;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+void
+q_block1_list<Endpoint, Size, MaxBlocks>::
+abort(transfer_t& t) noexcept
+{
+	if(t.sink) t.sink(block1_event::abort, nullptr, 0, 0, t.data);
+	t.clear();
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+template<typename Response>
+block1_status
+q_block1_list<Endpoint, Size, MaxBlocks>::
+reply(Response& response, CoAP::Message::code mcode) noexcept
+{
+	response
+		.code(mcode)
+		.serialize();
+
+	return block1_status::error;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+template<typename Response>
+block1_status
+q_block1_list<Endpoint, Size, MaxBlocks>::
+reply_missing(Response& response, transfer_t& t) noexcept
+{
+	using namespace CoAP::Message;
+
+	unsigned blocks[MaxBlocks < 64 ? MaxBlocks : 64];
+	unsigned count = t.bitmap.missing(blocks, sizeof(blocks) / sizeof(blocks[0]));
+
+	std::uint8_t payload[(sizeof(blocks) / sizeof(blocks[0])) * 5];
+	std::size_t payload_len = encode_missing_blocks(payload, sizeof(payload), blocks, count);
+
+	unsigned format = missing_blocks_content_format;
+	Option::node format_op{Option::code::content_format, format};
+
+	debug(q_block_mod, "Last block received, %u missing blocks", count);
+	response
+		.code(code::request_entity_incomplete)
+		.add_option(format_op)
+		.payload(payload, payload_len)
+		.serialize();
+	response.factory().remove_option(format_op);
+
+	return block1_status::partial;
+}
+
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks>
+template<typename Engine>
+void
+q_block1_list<Endpoint, Size, MaxBlocks>::
+send_missing(Engine& engine, transfer_t& t) noexcept
+{
+	using namespace CoAP::Message;
+
+	unsigned blocks[Engine::packet_size / 8];
+	unsigned count = t.bitmap.missing(blocks, sizeof(blocks) / sizeof(blocks[0]));
+	/**
+	 * Last block unknown and no hole: asking the next one
+	 */
+	if(!count && !t.bitmap.has_last())
+		blocks[count++] = t.bitmap.higher();
+
+	std::uint8_t payload[Engine::packet_size / 2];
+	std::size_t payload_len = encode_missing_blocks(payload, sizeof(payload), blocks, count);
+
+	unsigned format = missing_blocks_content_format;
+	Option::node format_op{Option::code::content_format, format};
+
+	Factory<> fac;
+	fac.header(type::nonconfirmable, code::request_entity_incomplete, t.token, t.token_len)
+		.add_option(format_op)
+		.payload(payload, payload_len);
+
+	std::uint8_t buffer[Engine::packet_size];
+	CoAP::Error ec;
+	std::size_t length = fac.serialize(buffer, sizeof(buffer), engine.mid(), ec);
+	if(ec)
+	{
+		error(q_block_mod, ec, "serialize missing blocks");
+		return;
+	}
+
+	debug(q_block_mod, "Requesting %u missing blocks", count);
+	engine.send(t.ep, buffer, length, ec);
+}
+
+/**
+ * Q-Block2 receiver
+ */
+template<unsigned MaxBlocks>
+q_block2_receiver<MaxBlocks>::q_block2_receiver(){}
+
+template<unsigned MaxBlocks>
+q_block2_receiver<MaxBlocks>::q_block2_receiver(q_block_configure const& config)
+	: config_(config){}
+
+template<unsigned MaxBlocks>
+template<typename Message>
+bool
+q_block2_receiver<MaxBlocks>::
+add(Message const& response, block1_sink_cb sink, void* data) noexcept
+{
+	using namespace CoAP::Message;
+
+	Option::option opt;
+	if(!Option::get_option(response, opt, Option::code::q_block2))
+		return false;
+
+	unsigned value = Option::parse_unsigned(opt);
+	unsigned num = Option::block_number(value),
+			bsize = Option::block_size(value);
+
+	/**
+	 * All blocks must be of the same representation (ETag) and block size
+	 */
+	Option::option etag;
+	bool has_etag = Option::get_option(response, etag, Option::code::etag);
+	if(has_etag && etag.length > sizeof(etag_)) has_etag = false;
+	if(!block_size_)
+	{
+		block_size_ = bsize;
+		etag_len_ = has_etag ? etag.length : 0;
+		if(etag_len_) std::memcpy(etag_, etag.value, etag_len_);
+		aborted_ = false;
+	}
+	else if(aborted_)
+		return true;
+	else if(bsize != block_size_
+		|| (has_etag ? etag.length : 0) != etag_len_
+		|| (etag_len_ && std::memcmp(etag_, etag.value, etag_len_) != 0))
+	{
+		debug(q_block_mod, "Q-Block2 of other representation: aborting");
+		sink(block1_event::abort, nullptr, 0, 0, data);
+		bitmap_.clear();
+		aborted_ = true;
+		return true;
+	}
+	last_received_ = CoAP::time();
+
+	if(bitmap_.test(num) || !bitmap_.set(num)) return true;
+
+	if(response.payload_len)
+		sink(block1_event::data, response.payload,
+				static_cast<std::size_t>(num) * bsize, response.payload_len, data);
+	if(!Option::more(value))
+	{
+		bitmap_.last(num);
+		size_ = static_cast<std::size_t>(num) * bsize + response.payload_len;
+	}
+
+	if(bitmap_.complete())
+		sink(block1_event::commit, nullptr, 0, size_, data);
+
+	return true;
+}
+
+template<unsigned MaxBlocks>
+bool
+q_block2_receiver<MaxBlocks>::
+expired() const noexcept
+{
+	return block_size_ != 0
+			&& !aborted_
+			&& !bitmap_.complete()
+			&& CoAP::time() >= (last_received_ + config_.non_receive_timeout_ms);
+}
+
+template<unsigned MaxBlocks>
+unsigned
+q_block2_receiver<MaxBlocks>::
+missing(unsigned* values,
+		CoAP::Message::Option::node* nodes,
+		unsigned max_count) noexcept
+{
+	using namespace CoAP::Message;
+
+	unsigned count = bitmap_.missing(values, max_count);
+	bool next = false;
+	if(!count && !bitmap_.has_last() && max_count)
+	{
+		//Last block unknown and no hole: asking the next ones
+		values[count++] = bitmap_.higher();
+		next = true;
+	}
+
+	for(unsigned i = 0; i < count; i++)
+	{
+		Option::make_block(values[i], values[i], next, block_size_);
+		nodes[i] = Option::node{Option::code::q_block2, values[i]};
+	}
+	last_received_ = CoAP::time();
+
+	return count;
+}
+
+template<unsigned MaxBlocks>
+void
+q_block2_receiver<MaxBlocks>::
+clear() noexcept
+{
+	bitmap_.clear();
+	block_size_ = 0;
+	size_ = 0;
+	last_received_ = 0;
+	etag_len_ = 0;
+	aborted_ = false;
+}
+
+}//Transmission
+}//CoAP
+
+#endif /* COAP_TE_TRANSMISSION_Q_BLOCK_IMPL_HPP__ */
@@ -173,8 +173,8 @@ template<unsigned MaxPacketSize,
 template<bool CheckEndpoint, bool CheckToken>
 bool
 transaction<MaxPacketSize, Callback_Functor, Endpoint>::
-check_response(endpoint_t const& ep [[maybe_unused]],
-		CoAP::Message::message const& response) noexcept
+match_response(endpoint_t const& ep [[maybe_unused]],
+		CoAP::Message::message const& response) const noexcept
 {
 	if(status_ != status_t::sending) return false;
 	if(request_.mid != response.mid) return false;
@@ -188,6 +188,20 @@ check_response(endpoint_t const& ep [[maybe_unused]],
 			return false;
 	}
 
+	return true;
+}
+
+template<unsigned MaxPacketSize,
+		typename Callback_Functor,
+		typename Endpoint>
+template<bool CheckEndpoint, bool CheckToken>
+bool
+transaction<MaxPacketSize, Callback_Functor, Endpoint>::
+check_response(endpoint_t const& ep,
+		CoAP::Message::message const& response) noexcept
+{
+	if(!match_response<CheckEndpoint, CheckToken>(ep, response)) return false;
+
 	status_ = response.mcode == CoAP::Message::code::empty ?
 			status_t::empty : status_t::success;
 
@@ -365,6 +379,24 @@ serialize(CoAP::Message::Factory<BufferSize, MessageID> const& factory,
 	return size;
 }
 
+template<unsigned MaxPacketSize,
+		typename Callback_Functor,
+		typename Endpoint>
+template<std::size_t TemplateSize,
+		unsigned TemplateRegions>
+std::size_t
+transaction<MaxPacketSize, Callback_Functor, Endpoint>::
+serialize(CoAP::Message::request_template<TemplateSize, TemplateRegions> const& req,
+		std::uint16_t mid,
+		CoAP::Error& ec) noexcept
+{
+	static_assert(!is_external_storage, "Must use internal storage");
+
+	std::size_t size = req.serialize(buffer_, MaxPacketSize, mid, ec);
+	if(!ec) buffer_used_ = size;
+	return size;
+}
+
 template<unsigned MaxPacketSize,
 		typename Callback_Functor,
 		typename Endpoint>
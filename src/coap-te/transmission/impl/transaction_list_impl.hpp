@@ -65,6 +65,22 @@ check_all() noexcept
 		nodes_[i].transaction.check();
 }
 
+template<typename Transaction,
+		unsigned Size>
+template<bool CheckEndpoint,
+	bool CheckToken>
+Transaction*
+transaction_list<Transaction, Size>::
+find_response(transaction_list<Transaction, Size>::endpoint const& ep,
+		CoAP::Message::message const& msg) noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+		if(nodes_[i].transaction.template match_response<CheckEndpoint, CheckToken>(ep, msg))
+			return &nodes_[i].transaction;
+
+	return nullptr;
+}
+
 template<typename Transaction,
 		unsigned Size>
 template<bool CheckEndpoint,
@@ -63,6 +63,21 @@ check_all() noexcept
 	}
 }
 
+template<typename Transaction>
+template<bool CheckEndpoint,
+	bool CheckToken>
+Transaction*
+transaction_list_vector<Transaction>::
+find_response(transaction_list_vector<Transaction>::endpoint const& ep,
+		CoAP::Message::message const& msg) noexcept
+{
+	for(auto& node : nodes_)
+		if(node.transaction.template match_response<CheckEndpoint, CheckToken>(ep, msg))
+			return &node.transaction;
+
+	return nullptr;
+}
+
 template<typename Transaction>
 template<bool CheckEndpoint,
 	bool CheckToken>
@@ -0,0 +1,66 @@
+#ifndef COAP_TE_TRANSMISSION_LEISURE_LIST_HPP__
+#define COAP_TE_TRANSMISSION_LEISURE_LIST_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../port/port.hpp"
+#include "types.hpp"
+
+namespace CoAP{
+namespace Transmission{
+
+/**
+ * Responses to multicast requests waiting to be sent
+ *
+ * https://tools.ietf.org/html/rfc7252#section-8.2
+ *
+ * Each response is sent at a random time inside the leisure period,
+ * spreading the responses of all the servers of the group.
+ */
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxPacketSize>
+class leisure_list{
+	public:
+		using endpoint_t = Endpoint;
+
+		leisure_list();
+
+		constexpr unsigned capacity() const noexcept{ return Size; }
+		static constexpr unsigned max_packet_size() noexcept{ return MaxPacketSize; }
+
+		/**
+		 * Copy the response, to be sent at a random time between now and
+		 * the leisure (configure::default_leisure_seconds). Returns false
+		 * if there is no free slot or the response doesn't fit.
+		 */
+		bool add(Endpoint const&,
+				void const* buffer, std::size_t buffer_len,
+				configure const&) noexcept;
+
+		/**
+		 * Send the responses which time has come
+		 */
+		template<typename Connection>
+		void check(Connection&) noexcept;
+
+		unsigned size() const noexcept;
+	private:
+		struct node{
+			bool			used = false;
+			Endpoint		ep;
+			CoAP::time_t	send_time = 0;
+			std::size_t		size = 0;
+			std::uint8_t	buffer[MaxPacketSize];
+		};
+
+		node	nodes_[Size];
+};
+
+}//Transmission
+}//CoAP
+
+#include "impl/leisure_list_impl.hpp"
+
+#endif /* COAP_TE_TRANSMISSION_LEISURE_LIST_HPP__ */
@@ -0,0 +1,81 @@
+#include "q_block.hpp"
+
+#if COAP_TE_BLOCKWISE_TRANSFER == 1 && COAP_TE_Q_BLOCK == 1
+
+namespace CoAP{
+namespace Transmission{
+
+/**
+ * CBOR unsigned integer (major type 0)
+ *
+ * https://tools.ietf.org/html/rfc8949#section-3.1
+ */
+std::size_t encode_missing_blocks(std::uint8_t* buffer, std::size_t buffer_len,
+		unsigned const* blocks, unsigned count) noexcept
+{
+	std::size_t offset = 0;
+	for(unsigned i = 0; i < count; i++)
+	{
+		unsigned value = blocks[i];
+		std::size_t len = value < 24 ? 1 : (value <= 0xFF ? 2 : (value <= 0xFFFF ? 3 : 5));
+		if((buffer_len - offset) < len) break;
+
+		switch(len)
+		{
+			case 1:
+				buffer[offset] = static_cast<std::uint8_t>(value);
+				break;
+			case 2:
+				buffer[offset] = 24;
+				buffer[offset + 1] = static_cast<std::uint8_t>(value);
+				break;
+			case 3:
+				buffer[offset] = 25;
+				buffer[offset + 1] = static_cast<std::uint8_t>(value >> 8);
+				buffer[offset + 2] = static_cast<std::uint8_t>(value);
+				break;
+			default:
+				buffer[offset] = 26;
+				buffer[offset + 1] = static_cast<std::uint8_t>(value >> 24);
+				buffer[offset + 2] = static_cast<std::uint8_t>(value >> 16);
+				buffer[offset + 3] = static_cast<std::uint8_t>(value >> 8);
+				buffer[offset + 4] = static_cast<std::uint8_t>(value);
+				break;
+		}
+		offset += len;
+	}
+	return offset;
+}
+
+unsigned decode_missing_blocks(void const* payload, std::size_t payload_len,
+		unsigned* blocks, unsigned max_count) noexcept
+{
+	std::uint8_t const* buffer = static_cast<std::uint8_t const*>(payload);
+	std::size_t offset = 0;
+	unsigned count = 0;
+
+	while(offset < payload_len && count < max_count)
+	{
+		std::uint8_t initial = buffer[offset++];
+		//Just unsigned integers are valid
+		if((initial >> 5) != 0) break;
+
+		unsigned info = initial & 0x1F, value = 0;
+		std::size_t len = info < 24 ? 0 : (info == 24 ? 1 : (info == 25 ? 2 : (info == 26 ? 4 : 8)));
+		if(len > 4 || (payload_len - offset) < len) break;
+
+		if(len == 0) value = info;
+		else
+			for(std::size_t i = 0; i < len; i++)
+				value = (value << 8) | buffer[offset + i];
+		offset += len;
+
+		blocks[count++] = value;
+	}
+	return count;
+}
+
+}//Transmission
+}//CoAP
+
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 && COAP_TE_Q_BLOCK == 1 */
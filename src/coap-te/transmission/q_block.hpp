@@ -0,0 +1,395 @@
+#ifndef COAP_TE_TRANSMISSION_Q_BLOCK_HPP__
+#define COAP_TE_TRANSMISSION_Q_BLOCK_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../defines/defaults.hpp"
+#include "../port/port.hpp"
+#include "../message/types.hpp"
+#include "../message/codes.hpp"
+#include "../message/options/options.hpp"
+#include "block_wise.hpp"
+
+#if COAP_TE_BLOCKWISE_TRANSFER == 1 && COAP_TE_Q_BLOCK == 1
+
+namespace CoAP{
+namespace Transmission{
+
+/**
+ * Q-Block1/Q-Block2 block-wise transfer
+ *
+ * https://tools.ietf.org/html/rfc9177
+ *
+ * The blocks are sent at bursts of NON messages (MAX_PAYLOADS), without
+ * waiting a response to each block. The receiver asks just the missing
+ * blocks.
+ */
+
+//https://tools.ietf.org/html/rfc9177#section-7.2
+struct q_block_configure{
+	unsigned	max_payloads				= 10;		//MAX_PAYLOADS
+	unsigned	non_timeout_ms				= 2000;		//NON_TIMEOUT
+	unsigned	non_receive_timeout_ms		= 4000;		//NON_RECEIVE_TIMEOUT
+	unsigned	non_max_retransmit			= 4;		//NON_MAX_RETRANSMIT
+	unsigned	non_partial_timeout_ms		= 247000;	//NON_PARTIAL_TIMEOUT (EXCHANGE_LIFETIME)
+};
+
+//https://tools.ietf.org/html/rfc9177#section-12.3
+static constexpr const unsigned missing_blocks_content_format = 272;	//application/missing-blocks+cbor-seq
+
+/**
+ * Missing blocks payload (CBOR sequence of unsigned integers)
+ *
+ * https://tools.ietf.org/html/rfc9177#section-5
+ */
+std::size_t encode_missing_blocks(std::uint8_t* buffer, std::size_t buffer_len,
+		unsigned const* blocks, unsigned count) noexcept;
+unsigned decode_missing_blocks(void const* payload, std::size_t payload_len,
+		unsigned* blocks, unsigned max_count) noexcept;
+
+/**
+ * Blocks received of a transfer
+ */
+template<unsigned MaxBlocks>
+class q_block_bitmap{
+	public:
+		q_block_bitmap();
+
+		bool set(unsigned num) noexcept;
+		bool test(unsigned num) const noexcept;
+		void last(unsigned num) noexcept;
+
+		unsigned count() const noexcept{ return count_; }
+		unsigned higher() const noexcept{ return higher_; }
+		bool has_last() const noexcept{ return total_ != 0; }
+		bool complete() const noexcept{ return total_ != 0 && count_ == total_; }
+
+		/**
+		 * List the blocks not received (until the last block, or the higher
+		 * block received if the last is unknown).
+		 */
+		unsigned missing(unsigned* blocks, unsigned max_count) const noexcept;
+
+		void clear() noexcept;
+	private:
+		std::uint8_t	bits_[(MaxBlocks + 7) / 8];
+		unsigned		count_ = 0;
+		unsigned		total_ = 0;
+		unsigned		higher_ = 0;
+};
+
+/**
+ * Sending side of a Q-Block transfer (Q-Block2 at servers, Q-Block1 at clients)
+ *
+ * The values of the options are copied to 'option_values' ('MaxOptionsSize'
+ * bytes), so the caller options don't need to outlive the transfer.
+ */
+template<typename Endpoint,
+		unsigned MaxMissing,
+		unsigned MaxOptions,
+		unsigned MaxOptionsSize>
+struct q_block_transfer{
+	bool							used = false;
+	Endpoint						ep;
+	std::uint32_t					key = 0;
+	CoAP::Message::Option::code		ocode;
+	CoAP::Message::code				mcode;
+	std::uint8_t					token[8];
+	std::size_t						token_len = 0;
+	CoAP::Message::Option::option	options[MaxOptions];
+	unsigned						options_count = 0;
+	std::uint8_t					option_values[MaxOptionsSize];
+	std::uint8_t					etag[4];		///< ETag (Q-Block2) or Request-Tag (Q-Block1)
+	std::size_t						size = 0;
+	void const*						representation = nullptr;
+	block2_read_cb					read = nullptr;
+	void*							data = nullptr;
+	unsigned						block_size = default_block_size;
+	unsigned						next = 0;		///< Next block of the sequence
+	unsigned						burst = 0;		///< Payloads sent at the current set
+	unsigned						missing[MaxMissing];
+	unsigned						missing_count = 0;
+	CoAP::time_t					next_send = 0;
+	CoAP::time_t					expiration = 0;
+
+	unsigned blocks() const noexcept
+	{
+		return size ? static_cast<unsigned>((size + block_size - 1) / block_size) : 1;
+	}
+
+	bool add_missing(unsigned num) noexcept;
+
+	void clear() noexcept
+	{
+		used = false;
+		representation = nullptr;
+		read = nullptr;
+		data = nullptr;
+		missing_count = 0;
+	}
+};
+
+/**
+ * List of the sending Q-Block transfers
+ *
+ * * Server (Q-Block2): 'process' must be called at the request handler;
+ * * Client (Q-Block1): the transfer is started with 'add', and the responses
+ * must be passed to 'response'.
+ *
+ * 'check' must be called periodically, to send the bursts of blocks.
+ */
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxMissing = 16,
+		unsigned MaxOptions = 4,
+		unsigned MaxOptionsSize = 64>
+class q_block_sender_list{
+	public:
+		using transfer_t = q_block_transfer<Endpoint, MaxMissing, MaxOptions, MaxOptionsSize>;
+
+		q_block_sender_list();
+		q_block_sender_list(q_block_configure const&);
+
+		/**
+		 * Server: respond a Q-Block2 request. The first block requested is sent at
+		 * the response, and the following at the next 'check' calls. Requests for
+		 * missing blocks of a ongoing transfer (including the block 0) are queued,
+		 * keeping the ETag; a request without Q-Block2, or of a representation
+		 * with other size, restarts the transfer.
+		 *
+		 * 'options' are added to all blocks (e.g. Content-Format). Their values
+		 * are copied.
+		 */
+		template<typename Message,
+				typename Response>
+		transfer_t* process(Message const& request, Response& response,
+				void const* representation, std::size_t size,
+				unsigned max_block_size = default_block_size,
+				CoAP::Message::Option::option const* options = nullptr,
+				unsigned options_count = 0) noexcept;
+		template<typename Message,
+				typename Response>
+		transfer_t* process(Message const& request, Response& response,
+				block2_read_cb read, void* data, std::size_t size,
+				unsigned max_block_size = default_block_size,
+				CoAP::Message::Option::option const* options = nullptr,
+				unsigned options_count = 0) noexcept;
+
+		/**
+		 * Client: start a Q-Block1 request. 'options' must include the
+		 * options of the request (e.g. Uri-Path); their values are copied.
+		 * A Request-Tag is added to all blocks.
+		 */
+		transfer_t* add(Endpoint const&, CoAP::Message::code method,
+				void const* token, std::size_t token_len,
+				void const* representation, std::size_t size,
+				unsigned block_size = default_block_size,
+				CoAP::Message::Option::option const* options = nullptr,
+				unsigned options_count = 0) noexcept;
+		transfer_t* add(Endpoint const&, CoAP::Message::code method,
+				void const* token, std::size_t token_len,
+				block2_read_cb read, void* data, std::size_t size,
+				unsigned block_size = default_block_size,
+				CoAP::Message::Option::option const* options = nullptr,
+				unsigned options_count = 0) noexcept;
+
+		/**
+		 * Client: process a response to a Q-Block1 transfer (2.31 Continue, 4.08
+		 * with missing blocks, or the final response).
+		 *
+		 * Returns false if the response doesn't belong to any transfer.
+		 */
+		template<typename Message>
+		bool response(Endpoint const&, Message const& response) noexcept;
+
+		/**
+		 * Send the next burst of blocks of each transfer
+		 */
+		template<typename Engine>
+		void check(Engine&) noexcept;
+
+		q_block_configure const& config() const noexcept{ return config_; }
+
+		constexpr unsigned size() const noexcept{ return Size; }
+		transfer_t* operator[](unsigned index) noexcept;
+	private:
+		template<typename Message,
+				typename Response>
+		transfer_t* process_impl(Message const& request, Response& response,
+				void const* representation,
+				block2_read_cb read, void* data,
+				std::size_t size,
+				unsigned max_block_size,
+				CoAP::Message::Option::option const* options,
+				unsigned options_count) noexcept;
+
+		transfer_t* init(Endpoint const&, std::uint32_t key,
+				CoAP::Message::Option::code, CoAP::Message::code,
+				void const* token, std::size_t token_len,
+				void const* representation,
+				block2_read_cb read, void* data,
+				std::size_t size, unsigned block_size,
+				CoAP::Message::Option::option const* options,
+				unsigned options_count,
+				transfer_t* t = nullptr) noexcept;
+
+		transfer_t* find(Endpoint const&, std::uint32_t key) noexcept;
+		transfer_t* find_free_slot() noexcept;
+
+		template<typename Engine>
+		void send_block(Engine&, transfer_t&, unsigned num) noexcept;
+		template<typename Response>
+		void respond_block(Response&, transfer_t&, unsigned num) noexcept;
+
+		static block_param make_param(transfer_t const&, unsigned num) noexcept;
+
+		transfer_t			list_[Size];
+		std::uint32_t		etag_;
+		q_block_configure	config_;
+};
+
+/**
+ * Receiving side of a Q-Block1 transfer (server)
+ */
+template<typename Endpoint,
+		unsigned MaxBlocks>
+struct q_block1_transfer{
+	bool						used = false;
+	Endpoint					ep;
+	std::uint32_t				key = 0;
+	std::uint8_t				token[8];
+	std::size_t					token_len = 0;
+	unsigned					block_size = 0;
+	std::size_t					size = 0;
+	unsigned					received = 0;		///< Payloads received at the current set
+	unsigned					retransmit = 0;
+	q_block_bitmap<MaxBlocks>	bitmap;
+	block1_sink_cb				sink = nullptr;
+	void*						data = nullptr;
+	CoAP::time_t				last_received = 0;
+	CoAP::time_t				expiration = 0;
+
+	void clear() noexcept
+	{
+		used = false;
+		size = 0;
+		received = 0;
+		retransmit = 0;
+		bitmap.clear();
+		sink = nullptr;
+		data = nullptr;
+	}
+};
+
+/**
+ * List of the receiving Q-Block1 transfers
+ *
+ * Must be called at the request handler. The blocks are delivered to the sink
+ * as they arrive (not ordered). It responds with 2.31 Continue after each
+ * MAX_PAYLOADS set received, and with 4.08 listing the missing blocks when
+ * the last block is received with blocks missing (and at 'check', if the
+ * blocks stop to arrive). When all blocks are received, the sink is called
+ * with 'commit', and the Q-Block1 option is added to the response: the handler
+ * just need to set the code/payload and serialize it.
+ *
+ * 'check' must be called periodically, to ask again the missing blocks.
+ */
+template<typename Endpoint,
+		unsigned Size,
+		unsigned MaxBlocks = 256>
+class q_block1_list{
+	public:
+		using transfer_t = q_block1_transfer<Endpoint, MaxBlocks>;
+
+		q_block1_list();
+		q_block1_list(q_block_configure const&);
+
+		template<typename Message,
+				typename Response>
+		block1_status process(Message const& request,
+				Response& response,
+				block1_sink_cb sink, void* data = nullptr) noexcept;
+
+		template<typename Engine>
+		void check(Engine&) noexcept;
+
+		q_block_configure const& config() const noexcept{ return config_; }
+
+		constexpr unsigned size() const noexcept{ return Size; }
+		transfer_t* operator[](unsigned index) noexcept;
+	private:
+		transfer_t* find(Endpoint const&, std::uint32_t key) noexcept;
+		transfer_t* find_free_slot() noexcept;
+		void abort(transfer_t&) noexcept;
+
+		template<typename Response>
+		block1_status reply(Response&, CoAP::Message::code) noexcept;
+		template<typename Response>
+		block1_status reply_missing(Response&, transfer_t&) noexcept;
+		template<typename Engine>
+		void send_missing(Engine&, transfer_t&) noexcept;
+
+		transfer_t						list_[Size];
+		q_block_configure				config_;
+		unsigned						qblock1_;
+		CoAP::Message::Option::node		qblock1_op_;
+};
+
+/**
+ * Receiving side of a Q-Block2 transfer (client)
+ *
+ * The responses must be passed to 'add'. When the blocks stop to arrive (see
+ * 'expired'), the missing blocks must be requested (see 'missing').
+ *
+ * The ETag and block size of the first block are recorded: a block of other
+ * representation (ETag or block size different) aborts the transfer (sink
+ * called with 'abort', see 'aborted'). It must be cleared and requested again.
+ */
+template<unsigned MaxBlocks = 256>
+class q_block2_receiver{
+	public:
+		q_block2_receiver();
+		q_block2_receiver(q_block_configure const&);
+
+		/**
+		 * Returns false if the response doesn't have a Q-Block2 option
+		 */
+		template<typename Message>
+		bool add(Message const& response, block1_sink_cb sink, void* data = nullptr) noexcept;
+
+		bool complete() const noexcept{ return bitmap_.complete(); }
+		bool aborted() const noexcept{ return aborted_; }
+		bool expired() const noexcept;
+
+		/**
+		 * Make the Q-Block2 options to request the missing blocks. 'values'
+		 * and 'nodes' must have 'max_count' elements, and must live until
+		 * the request is serialized.
+		 *
+		 * Returns the number of options made.
+		 */
+		unsigned missing(unsigned* values,
+				CoAP::Message::Option::node* nodes,
+				unsigned max_count) noexcept;
+
+		void clear() noexcept;
+	private:
+		q_block_bitmap<MaxBlocks>	bitmap_;
+		unsigned					block_size_ = 0;
+		std::size_t					size_ = 0;
+		CoAP::time_t				last_received_ = 0;
+		std::uint8_t				etag_[8];
+		std::size_t					etag_len_ = 0;
+		bool						aborted_ = false;
+		q_block_configure			config_;
+};
+
+}//Transmission
+}//CoAP
+
+#include "impl/q_block_impl.hpp"
+
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 && COAP_TE_Q_BLOCK == 1 */
+
+#endif /* COAP_TE_TRANSMISSION_Q_BLOCK_HPP__ */
@@ -1,16 +1,44 @@
 #ifndef COAP_TE_TRANSMISSION_RELIABLE_CONNECTION_HPP__
 #define COAP_TE_TRANSMISSION_RELIABLE_CONNECTION_HPP__
 
+#include "../../../defines/defaults.hpp"
 #include "../types.hpp"
+#include "receive_buffer.hpp"
+#include "send_queue.hpp"
+
+#include <type_traits>
 
 namespace CoAP{
 namespace Transmission{
 namespace Reliable{
 
-template<typename Handler>
+/**
+ * ReceiveBufferSize: if bigger than 0, each connection holds its own
+ * receive buffer. The engine reads the socket in large chunks to this
+ * buffer, and messages that arrived partially are kept until the rest
+ * arrives. Must be at least the engine max message size.
+ *
+ * SendQueue: a 'send_queue' type, or CoAP::disable. Data that the socket
+ * didn't accept is queued (instead of dropped/truncated) and sent when
+ * the socket is writable again. Must be at least the engine max message
+ * size.
+ */
+template<typename Handler,
+		std::size_t ReceiveBufferSize = 0,
+		typename SendQueue = CoAP::disable>
 class Connection{
+		using empty = struct{};
 	public:
 		using handler = Handler;
+		static constexpr const bool has_receive_buffer = ReceiveBufferSize > 0;
+		static constexpr const std::size_t receive_buffer_size = ReceiveBufferSize;
+		using receive_buffer_t = typename std::conditional<has_receive_buffer,
+				receive_buffer<ReceiveBufferSize>, empty>::type;
+		static constexpr const bool has_send_queue =
+				!std::is_same<SendQueue, CoAP::disable>::value;
+		using send_queue_t = typename std::conditional<has_send_queue,
+				SendQueue, empty>::type;
+
 		Connection();
 
 		void init(handler socket) noexcept;
@@ -24,10 +52,15 @@ class Connection{
 		csm_configure const& csm() const noexcept;
 		csm_configure& csm()noexcept;
 
+		receive_buffer_t& buffer() noexcept;
+		send_queue_t& queue() noexcept;
+
 		void clear() noexcept;
 	private:
-		handler 		socket_ = 0;
-		csm_configure	csm_;
+		handler 			socket_ = 0;
+		csm_configure		csm_;
+		receive_buffer_t	buffer_;
+		send_queue_t		queue_;
 };
 
 }//Reliable
@@ -11,6 +11,9 @@ template<typename Handler>
 class Connection_Empty{
 	public:
 		using handler = Handler;
+		static constexpr const bool has_receive_buffer = false;
+		static constexpr const bool has_send_queue = false;
+
 		Connection_Empty(){}
 
 		void init(handler) noexcept{}
@@ -20,6 +20,7 @@ class connection_list{
 
 		Conn* find(handler socket) noexcept;
 		Conn* find_free_slot() noexcept;
+		Conn* find_free_slot(handler socket) noexcept;
 
 		void close(handler socket) noexcept;
 		void close_all() noexcept;
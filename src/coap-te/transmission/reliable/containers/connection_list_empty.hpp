@@ -20,6 +20,7 @@ class connection_list_empty{
 
 		connection_t* find(handler) noexcept{ return nullptr; }
 		connection_t* find_free_slot() noexcept{ return nullptr; }
+		connection_t* find_free_slot(handler) noexcept{ return nullptr; }
 
 		void close(handler) noexcept{}
 		void close_all() noexcept{}
@@ -0,0 +1,64 @@
+#ifndef COAP_TE_TRANSMISSION_RELIABLE_CONNECTION_LIST_TABLE_HPP__
+#define COAP_TE_TRANSMISSION_RELIABLE_CONNECTION_LIST_TABLE_HPP__
+
+#include "../../../defines/defaults.hpp"
+#include <cstdlib>
+#include <memory>
+
+namespace CoAP{
+namespace Transmission{
+namespace Reliable{
+
+#if COAP_TE_RELIABLE_CONNECTION == 1
+
+/**
+ * Connection list indexed by the socket descriptor
+ *
+ * The system assigns the lowest free descriptor to each new socket, so
+ * the descriptors are dense small integers, and can be used as index:
+ * find, find_free_slot and close don't depend of the number of
+ * connections.
+ *
+ * A connection is allocated the first time a descriptor is used, and
+ * kept (cleared) after close, to be reused when the system reuses the
+ * descriptor. operator[] returns nullptr to descriptors never used.
+ *
+ * Uses dynamic allocation ('new (std::nothrow)', the connections and the
+ * index), so must be explicitly included. If the allocation fails, no slot
+ * is given.
+ */
+template<typename Connection>
+class connection_list_table{
+	public:
+		using connection_t = Connection;
+		using handler = typename Connection::handler;
+
+		connection_list_table();
+
+		Connection* find(handler socket) noexcept;
+		Connection* find_free_slot() noexcept;
+		Connection* find_free_slot(handler socket) noexcept;
+
+		void close(handler socket) noexcept;
+		void close_all() noexcept;
+
+		Connection* operator[](unsigned index) noexcept;
+
+		unsigned ocupied() const noexcept;
+		unsigned size() const noexcept;
+	private:
+		bool grow(std::size_t size) noexcept;
+
+		std::unique_ptr<std::unique_ptr<Connection>[]>	nodes_;
+		std::size_t										size_ = 0;
+};
+
+#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
+
+}//CoAP
+}//Transmission
+}//Reliable
+
+#include "impl/connection_list_table_impl.hpp"
+
+#endif /* COAP_TE_TRANSMISSION_RELIABLE_CONNECTION_LIST_TABLE_HPP__ */
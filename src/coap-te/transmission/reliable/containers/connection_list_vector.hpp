@@ -20,6 +20,7 @@ class connection_list_vector{
 
 		Connection* find(handler socket) noexcept;
 		Connection* find_free_slot() noexcept;
+		Connection* find_free_slot(handler socket) noexcept;
 
 		void close(handler socket) noexcept;
 		void close_all() noexcept;
@@ -9,59 +9,107 @@ namespace Reliable{
 
 #if COAP_TE_RELIABLE_CONNECTION == 1
 
-template<typename Handler>
-Connection<Handler>::Connection(){}
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+Connection<Handler, ReceiveBufferSize, SendQueue>::Connection(){}
 
-template<typename Handler>
-void Connection<Handler>::init(handler socket) noexcept
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+void Connection<Handler, ReceiveBufferSize, SendQueue>::init(handler socket) noexcept
 {
 	socket_ = socket;
 	csm_.reset();
+	if constexpr(has_receive_buffer)
+		buffer_.clear();
+	if constexpr(has_send_queue)
+		queue_.clear();
 }
 
-template<typename Handler>
-void Connection<Handler>::init(handler socket, csm_configure const& csm) noexcept
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+void Connection<Handler, ReceiveBufferSize, SendQueue>::init(handler socket, csm_configure const& csm) noexcept
 {
 	socket_ = socket;
 	csm_ = csm;
+	if constexpr(has_receive_buffer)
+		buffer_.clear();
+	if constexpr(has_send_queue)
+		queue_.clear();
 }
 
-template<typename Handler>
-bool Connection<Handler>::is_used() const noexcept
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+bool Connection<Handler, ReceiveBufferSize, SendQueue>::is_used() const noexcept
 {
 	return socket_ != 0;
 }
 
-template<typename Handler>
-void Connection<Handler>::update(csm_configure const& csm) noexcept
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+void Connection<Handler, ReceiveBufferSize, SendQueue>::update(csm_configure const& csm) noexcept
 {
 	csm_ = csm;
 }
 
-template<typename Handler>
-typename Connection<Handler>::handler 
-Connection<Handler>::socket() const noexcept
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+typename Connection<Handler, ReceiveBufferSize, SendQueue>::handler 
+Connection<Handler, ReceiveBufferSize, SendQueue>::socket() const noexcept
 {
 	return socket_;
 }
 
-template<typename Handler>
-csm_configure const& Connection<Handler>::csm() const noexcept
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+csm_configure const& Connection<Handler, ReceiveBufferSize, SendQueue>::csm() const noexcept
 {
 	return csm_;
 }
 
-template<typename Handler>
-csm_configure& Connection<Handler>::csm() noexcept
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+csm_configure& Connection<Handler, ReceiveBufferSize, SendQueue>::csm() noexcept
 {
 	return csm_;
 }
 
-template<typename Handler>
-void Connection<Handler>::clear() noexcept
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+typename Connection<Handler, ReceiveBufferSize, SendQueue>::receive_buffer_t&
+Connection<Handler, ReceiveBufferSize, SendQueue>::buffer() noexcept
+{
+	return buffer_;
+}
+
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+typename Connection<Handler, ReceiveBufferSize, SendQueue>::send_queue_t&
+Connection<Handler, ReceiveBufferSize, SendQueue>::queue() noexcept
+{
+	return queue_;
+}
+
+template<typename Handler,
+		std::size_t ReceiveBufferSize,
+		typename SendQueue>
+void Connection<Handler, ReceiveBufferSize, SendQueue>::clear() noexcept
 {
 	socket_ = 0;
 	csm_.reset();
+	if constexpr(has_receive_buffer)
+		buffer_.clear();
+	if constexpr(has_send_queue)
+		queue_.clear();
 }
 
 #endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
@@ -35,6 +35,14 @@ find_free_slot() noexcept
 	return nullptr;
 }
 
+template<typename Connection,
+		unsigned Size>
+Connection* connection_list<Connection, Size>::
+find_free_slot(handler) noexcept
+{
+	return find_free_slot();
+}
+
 template<typename Connection,
 		unsigned Size>
 void
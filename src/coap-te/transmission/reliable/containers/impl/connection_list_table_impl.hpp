@@ -0,0 +1,130 @@
+#ifndef COAP_TE_TRANSMISSION_RELIABLE_CONNECTION_LIST_TABLE_IMPL_HPP__
+#define COAP_TE_TRANSMISSION_RELIABLE_CONNECTION_LIST_TABLE_IMPL_HPP__
+
+#include "../connection_list_table.hpp"
+#include <type_traits>
+#include <new>
+
+namespace CoAP{
+namespace Transmission{
+namespace Reliable{
+
+template<typename Connection>
+connection_list_table<Connection>::connection_list_table(){}
+
+template<typename Connection>
+Connection* connection_list_table<Connection>::
+find(handler socket) noexcept
+{
+	std::size_t index = static_cast<std::size_t>(socket);
+	if(index >= size_ || !nodes_[index]) return nullptr;
+
+	Connection* conn = nodes_[index].get();
+	return conn->is_used() && conn->socket() == socket ? conn : nullptr;
+}
+
+/**
+ * Without the socket there is no index to use
+ */
+template<typename Connection>
+Connection* connection_list_table<Connection>::
+find_free_slot() noexcept
+{
+	return nullptr;
+}
+
+template<typename Connection>
+Connection* connection_list_table<Connection>::
+find_free_slot(handler socket) noexcept
+{
+	if constexpr(std::is_signed<handler>::value)
+		if(socket < 0) return nullptr;
+
+	std::size_t index = static_cast<std::size_t>(socket);
+	if(index >= size_ && !grow(index + 1)) return nullptr;
+	if(!nodes_[index])
+	{
+		nodes_[index].reset(new (std::nothrow) Connection);
+		if(!nodes_[index]) return nullptr;
+	}
+
+	Connection* conn = nodes_[index].get();
+	return conn->is_used() ? nullptr : conn;
+}
+
+template<typename Connection>
+void
+connection_list_table<Connection>::
+close(handler socket) noexcept
+{
+	Connection* conn = find(socket);
+	if(conn) conn->clear();
+}
+
+template<typename Connection>
+void
+connection_list_table<Connection>::
+close_all() noexcept
+{
+	for(std::size_t i = 0; i < size_; i++)
+		if(nodes_[i]) nodes_[i]->clear();
+}
+
+template<typename Connection>
+Connection*
+connection_list_table<Connection>::
+operator[](unsigned index) noexcept
+{
+	return index >= size_ ? nullptr : nodes_[index].get();
+}
+
+template<typename Connection>
+unsigned
+connection_list_table<Connection>::
+ocupied() const noexcept
+{
+	unsigned count = 0;
+	for(std::size_t i = 0; i < size_; i++)
+		if(nodes_[i] && nodes_[i]->is_used())
+			count++;
+
+	return count;
+}
+
+template<typename Connection>
+unsigned
+connection_list_table<Connection>::
+size() const noexcept
+{
+	return static_cast<unsigned>(size_);
+}
+
+/**
+ * The index is grown (at least doubled) without exceptions: if the
+ * allocation fails, the slot is not given
+ */
+template<typename Connection>
+bool
+connection_list_table<Connection>::
+grow(std::size_t size) noexcept
+{
+	if(size < 2 * size_) size = 2 * size_;
+
+	std::unique_ptr<std::unique_ptr<Connection>[]> nodes(
+			new (std::nothrow) std::unique_ptr<Connection>[size]);
+	if(!nodes) return false;
+
+	for(std::size_t i = 0; i < size_; i++)
+		nodes[i] = std::move(nodes_[i]);
+
+	nodes_ = std::move(nodes);
+	size_ = size;
+
+	return true;
+}
+
+}//CoAP
+}//Transmission
+}//Reliable
+
+#endif /* COAP_TE_TRANSMISSION_RELIABLE_CONNECTION_LIST_TABLE_IMPL_HPP__ */
@@ -31,6 +31,13 @@ find_free_slot() noexcept
 	return &conn;
 }
 
+template<typename Connection>
+Connection* connection_list_vector<Connection>::
+find_free_slot(handler) noexcept
+{
+	return find_free_slot();
+}
+
 template<typename Connection>
 void
 connection_list_vector<Connection>::
@@ -0,0 +1,100 @@
+#ifndef COAP_TE_TRANSMISSION_RELIABLE_RECEIVE_BUFFER_IMPL_HPP__
+#define COAP_TE_TRANSMISSION_RELIABLE_RECEIVE_BUFFER_IMPL_HPP__
+
+#include <cstring>
+
+#include "../receive_buffer.hpp"
+#include "../../../../message/reliable/parser.hpp"
+
+namespace CoAP{
+namespace Transmission{
+namespace Reliable{
+
+template<std::size_t Size>
+receive_buffer<Size>::receive_buffer()
+{
+	static_assert(Size > 0, "Size must be bigger than 0");
+}
+
+template<std::size_t Size>
+std::uint8_t*
+receive_buffer<Size>::
+data() noexcept
+{
+	return buffer_ + end_;
+}
+
+template<std::size_t Size>
+std::size_t
+receive_buffer<Size>::
+free() const noexcept
+{
+	return Size - end_;
+}
+
+template<std::size_t Size>
+void
+receive_buffer<Size>::
+commit(std::size_t size) noexcept
+{
+	end_ += size;
+}
+
+template<std::size_t Size>
+std::uint8_t const*
+receive_buffer<Size>::
+next(std::size_t& size, std::size_t max_size, CoAP::Error& ec) noexcept
+{
+	std::size_t used = end_ - begin_,
+				msize = CoAP::Message::Reliable::message_size(buffer_ + begin_, used);
+
+	if(msize > Size || msize > max_size)
+	{
+		ec = CoAP::errc::insufficient_buffer;
+		return nullptr;
+	}
+
+	if(!msize || msize > used)
+	{
+		/**
+		 * Incomplete message: moved to the beginning, so the next read
+		 * has all the free space
+		 */
+		if(begin_)
+		{
+			if(used) std::memmove(buffer_, buffer_ + begin_, used);
+			begin_ = 0;
+			end_ = used;
+		}
+		return nullptr;
+	}
+
+	std::uint8_t const* message = buffer_ + begin_;
+	size = msize;
+	begin_ += msize;
+
+	return message;
+}
+
+template<std::size_t Size>
+std::size_t
+receive_buffer<Size>::
+used() const noexcept
+{
+	return end_ - begin_;
+}
+
+template<std::size_t Size>
+void
+receive_buffer<Size>::
+clear() noexcept
+{
+	begin_ = 0;
+	end_ = 0;
+}
+
+}//Reliable
+}//Transmission
+}//CoAP
+
+#endif /* COAP_TE_TRANSMISSION_RELIABLE_RECEIVE_BUFFER_IMPL_HPP__ */
@@ -0,0 +1,211 @@
+#ifndef COAP_TE_TRANSMISSION_RELIABLE_SEND_QUEUE_IMPL_HPP__
+#define COAP_TE_TRANSMISSION_RELIABLE_SEND_QUEUE_IMPL_HPP__
+
+#include <cstring>
+
+#include "../send_queue.hpp"
+
+namespace CoAP{
+namespace Transmission{
+namespace Reliable{
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+send_queue<Size, HighWatermark, LowWatermark>::
+send_queue()
+{
+	static_assert(Size > 0, "Size must be bigger than 0");
+	static_assert(HighWatermark <= Size, "High watermark must be <= Size");
+	static_assert(LowWatermark < HighWatermark, "Low watermark must be < high watermark");
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+bool
+send_queue<Size, HighWatermark, LowWatermark>::
+push(void const* data, std::size_t size) noexcept
+{
+	if(size > Size - used_) return false;
+
+	std::uint8_t const* d = static_cast<std::uint8_t const*>(data);
+	std::size_t end = (begin_ + used_) % Size,
+				first = Size - end < size ? Size - end : size;
+
+	std::memcpy(buffer_ + end, d, first);
+	if(size > first) std::memcpy(buffer_, d + first, size - first);
+
+	used_ += size;
+	if(!corked_ && used_ >= HighWatermark) writable_ = false;
+
+	return true;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+unsigned
+send_queue<Size, HighWatermark, LowWatermark>::
+pending(void const* data[2], std::size_t size[2]) const noexcept
+{
+	if(!used_) return 0;
+
+	data[0] = buffer_ + begin_;
+	if(begin_ + used_ <= Size)
+	{
+		size[0] = used_;
+		return 1;
+	}
+
+	size[0] = Size - begin_;
+	data[1] = buffer_;
+	size[1] = used_ - size[0];
+
+	return 2;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+void
+send_queue<Size, HighWatermark, LowWatermark>::
+consume(std::size_t size) noexcept
+{
+	if(size >= used_)
+	{
+		begin_ = 0;
+		used_ = 0;
+	}
+	else
+	{
+		begin_ = (begin_ + size) % Size;
+		used_ -= size;
+	}
+
+	if(used_ <= LowWatermark) writable_ = true;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+bool
+send_queue<Size, HighWatermark, LowWatermark>::
+empty() const noexcept
+{
+	return used_ == 0;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+std::size_t
+send_queue<Size, HighWatermark, LowWatermark>::
+used() const noexcept
+{
+	return used_;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+std::size_t
+send_queue<Size, HighWatermark, LowWatermark>::
+free() const noexcept
+{
+	return Size - used_;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+bool
+send_queue<Size, HighWatermark, LowWatermark>::
+writable() const noexcept
+{
+	return writable_;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+bool
+send_queue<Size, HighWatermark, LowWatermark>::
+crossed() noexcept
+{
+	if(writable_ == reported_) return false;
+	reported_ = writable_;
+	return true;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+void
+send_queue<Size, HighWatermark, LowWatermark>::
+cork() noexcept
+{
+	corked_ = true;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+void
+send_queue<Size, HighWatermark, LowWatermark>::
+uncork() noexcept
+{
+	corked_ = false;
+	if(used_ >= HighWatermark) writable_ = false;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+bool
+send_queue<Size, HighWatermark, LowWatermark>::
+corked() const noexcept
+{
+	return corked_;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+bool
+send_queue<Size, HighWatermark, LowWatermark>::
+polling() const noexcept
+{
+	return polling_;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+void
+send_queue<Size, HighWatermark, LowWatermark>::
+polling(bool enable) noexcept
+{
+	polling_ = enable;
+}
+
+template<std::size_t Size,
+		std::size_t HighWatermark,
+		std::size_t LowWatermark>
+void
+send_queue<Size, HighWatermark, LowWatermark>::
+clear() noexcept
+{
+	begin_ = 0;
+	used_ = 0;
+	writable_ = true;
+	reported_ = true;
+	corked_ = false;
+	polling_ = false;
+}
+
+}//Reliable
+}//Transmission
+}//CoAP
+
+#endif /* COAP_TE_TRANSMISSION_RELIABLE_SEND_QUEUE_IMPL_HPP__ */
@@ -24,6 +24,15 @@ find_free_slot() noexcept
 	return nullptr;
 }
 
+template<typename Transaction,
+		unsigned Size>
+Transaction*
+transaction_list<Transaction, Size>::
+find_free_slot(handler) noexcept
+{
+	return find_free_slot();
+}
+
 template<typename Transaction,
 		unsigned Size>
 void
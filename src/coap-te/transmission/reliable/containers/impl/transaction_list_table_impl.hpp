@@ -0,0 +1,202 @@
+#ifndef COAP_TE_TRANSMISSION_RELIABLE_TRANSACTION_LIST_TABLE_IMPL_HPP__
+#define COAP_TE_TRANSMISSION_RELIABLE_TRANSACTION_LIST_TABLE_IMPL_HPP__
+
+#include "../transaction_list_table.hpp"
+#include <type_traits>
+#include <new>
+
+namespace CoAP{
+namespace Transmission{
+namespace Reliable{
+
+template<typename Transaction,
+		unsigned Size>
+transaction_list_table<Transaction, Size>::
+transaction_list_table()
+{
+	static_assert(Size > 0, "Transaction list size must be > 0");
+
+	for(unsigned i = 0; i < Size; i++)
+	{
+		next_[i] = none;
+		prev_[i] = none;
+		owner_[i] = 0;
+		linked_[i] = false;
+	}
+}
+
+template<typename Transaction,
+		unsigned Size>
+Transaction*
+transaction_list_table<Transaction, Size>::
+find_free_slot(handler socket) noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+	{
+		if(list_[i].is_busy()) continue;
+
+		if(linked_[i]) unlink(i);
+		return link(i, socket) ? &list_[i] : nullptr;
+	}
+
+	return nullptr;
+}
+
+template<typename Transaction,
+		unsigned Size>
+void
+transaction_list_table<Transaction, Size>::
+check_all() noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+		list_[i].check();
+}
+
+template<typename Transaction,
+		unsigned Size>
+Transaction*
+transaction_list_table<Transaction, Size>::
+check_all_response(handler socket, CoAP::Message::Reliable::message const& msg) noexcept
+{
+	unsigned i = head(socket);
+	while(i != none)
+	{
+		unsigned next = next_[i];
+		if(!list_[i].is_busy())
+			unlink(i);
+		else if(list_[i].check_response(socket, msg))
+			return &list_[i];
+		i = next;
+	}
+
+	return nullptr;
+}
+
+template<typename Transaction,
+		unsigned Size>
+void
+transaction_list_table<Transaction, Size>::
+cancel_all() noexcept
+{
+	for(unsigned i = 0; i < Size; i++)
+		if(linked_[i]) unlink(i);
+
+	for(unsigned i = 0; i < Size; i++)
+		list_[i].cancel();
+}
+
+/**
+ * The head is always unlinked before cancel, so the callbacks
+ * can take (and link) slots safely
+ */
+template<typename Transaction,
+		unsigned Size>
+void
+transaction_list_table<Transaction, Size>::
+cancel_all(handler socket) noexcept
+{
+	unsigned i;
+	while((i = head(socket)) != none)
+	{
+		unlink(i);
+		if(list_[i].socket() == socket)
+			list_[i].cancel();
+	}
+}
+
+template<typename Transaction,
+		unsigned Size>
+Transaction*
+transaction_list_table<Transaction, Size>::
+operator[](unsigned index) noexcept
+{
+	return index >= Size ? nullptr : &list_[index];
+}
+
+template<typename Transaction,
+		unsigned Size>
+constexpr unsigned
+transaction_list_table<Transaction, Size>::
+size() const noexcept{ return Size; }
+
+template<typename Transaction,
+		unsigned Size>
+unsigned
+transaction_list_table<Transaction, Size>::
+head(handler socket) const noexcept
+{
+	std::size_t index = static_cast<std::size_t>(socket);
+	return index >= heads_size_ ? none : heads_[index];
+}
+
+template<typename Transaction,
+		unsigned Size>
+bool
+transaction_list_table<Transaction, Size>::
+link(unsigned index, handler socket) noexcept
+{
+	if constexpr(std::is_signed<handler>::value)
+		if(socket < 0) return false;
+
+	std::size_t sock = static_cast<std::size_t>(socket);
+	if(sock >= heads_size_ && !grow(sock + 1)) return false;
+
+	unsigned first = heads_[sock];
+	next_[index] = first;
+	prev_[index] = none;
+	if(first != none) prev_[first] = index;
+	heads_[sock] = index;
+
+	owner_[index] = socket;
+	linked_[index] = true;
+
+	return true;
+}
+
+template<typename Transaction,
+		unsigned Size>
+void
+transaction_list_table<Transaction, Size>::
+unlink(unsigned index) noexcept
+{
+	unsigned next = next_[index], prev = prev_[index];
+	if(prev != none)
+		next_[prev] = next;
+	else
+		heads_[static_cast<std::size_t>(owner_[index])] = next;
+	if(next != none) prev_[next] = prev;
+
+	next_[index] = none;
+	prev_[index] = none;
+	linked_[index] = false;
+}
+
+/**
+ * The heads are grown (at least doubled) without exceptions: if the
+ * allocation fails, the socket is not linked
+ */
+template<typename Transaction,
+		unsigned Size>
+bool
+transaction_list_table<Transaction, Size>::
+grow(std::size_t size) noexcept
+{
+	if(size < 2 * heads_size_) size = 2 * heads_size_;
+
+	std::unique_ptr<unsigned[]> heads(new (std::nothrow) unsigned[size]);
+	if(!heads) return false;
+
+	for(std::size_t i = 0; i < size; i++)
+		heads[i] = i < heads_size_ ? heads_[i] : none;
+
+	heads_ = std::move(heads);
+	heads_size_ = size;
+
+	return true;
+}
+
+}//CoAP
+}//Transmission
+}//Reliable
+
+#endif /* COAP_TE_TRANSMISSION_RELIABLE_TRANSACTION_LIST_TABLE_IMPL_HPP__ */
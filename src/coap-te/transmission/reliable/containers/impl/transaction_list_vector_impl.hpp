@@ -26,6 +26,14 @@ find_free_slot() noexcept
 	return &node;
 }
 
+template<typename Transaction>
+Transaction*
+transaction_list_vector<Transaction>::
+find_free_slot(handler) noexcept
+{
+	return find_free_slot();
+}
+
 template<typename Transaction>
 void
 transaction_list_vector<Transaction>::
@@ -0,0 +1,57 @@
+#ifndef COAP_TE_TRANSMISSION_RELIABLE_RECEIVE_BUFFER_HPP__
+#define COAP_TE_TRANSMISSION_RELIABLE_RECEIVE_BUFFER_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "../../../error.hpp"
+
+namespace CoAP{
+namespace Transmission{
+namespace Reliable{
+
+/**
+ * Receive buffer of a stream connection
+ *
+ * The socket is read with as much data as fits ('data'/'free' to read,
+ * 'commit' the bytes read), and the messages are taken out one by one
+ * with 'next', using the message length field. A message that didn't
+ * arrived complete is kept (moved to the buffer beginning) until the
+ * next read.
+ *
+ * Size must be at least the max message size accepted.
+ */
+template<std::size_t Size>
+class receive_buffer{
+	public:
+		static constexpr const std::size_t buffer_size = Size;
+
+		receive_buffer();
+
+		std::uint8_t* data() noexcept;
+		std::size_t free() const noexcept;
+		void commit(std::size_t size) noexcept;
+
+		/**
+		 * Returns the next complete message (and its size), or nullptr
+		 * if none. If a message is bigger than 'max_size' (the max message
+		 * size accepted, at most the buffer size), 'ec' is set (there is no
+		 * way to keep reading the stream).
+		 */
+		std::uint8_t const* next(std::size_t& size, std::size_t max_size, CoAP::Error&) noexcept;
+
+		std::size_t used() const noexcept;
+		void clear() noexcept;
+	private:
+		std::uint8_t	buffer_[Size];
+		std::size_t		begin_ = 0;
+		std::size_t		end_ = 0;
+};
+
+}//Reliable
+}//Transmission
+}//CoAP
+
+#include "impl/receive_buffer_impl.hpp"
+
+#endif /* COAP_TE_TRANSMISSION_RELIABLE_RECEIVE_BUFFER_HPP__ */
@@ -0,0 +1,84 @@
+#ifndef COAP_TE_TRANSMISSION_RELIABLE_SEND_QUEUE_HPP__
+#define COAP_TE_TRANSMISSION_RELIABLE_SEND_QUEUE_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace CoAP{
+namespace Transmission{
+namespace Reliable{
+
+/**
+ * Send queue of a stream connection
+ *
+ * Holds the data that the socket didn't accept (socket buffer full), to
+ * be sent when the socket can be written again. It's a ring buffer, so the
+ * pending data is at most at two chunks ('pending'), sent at once.
+ *
+ * Backpressure: when the data queued reaches HighWatermark the queue is
+ * set as not 'writable', until it drains to LowWatermark. The application
+ * should stop sending (e.g. notifications) to connections not writable.
+ * 'crossed' reports (once) each change of the writable state.
+ *
+ * Corked: all data is queued (even if the socket could accept it), so
+ * many messages are sent at once when uncorked. The data held while corked
+ * is not backpressure: the high watermark is checked only when uncorked.
+ *
+ * 'polling' holds if the socket is being polled to be writable (set by the
+ * engine only while there is data pending).
+ */
+template<std::size_t Size,
+		std::size_t HighWatermark = Size - Size / 4,
+		std::size_t LowWatermark = Size / 4>
+class send_queue{
+	public:
+		static constexpr const std::size_t queue_size = Size;
+		static constexpr const std::size_t high_watermark = HighWatermark;
+		static constexpr const std::size_t low_watermark = LowWatermark;
+
+		send_queue();
+
+		/**
+		 * Queue all data or nothing (return false)
+		 */
+		bool push(void const*, std::size_t) noexcept;
+		/**
+		 * Chunks of data pending (0, 1 or 2), oldest first
+		 */
+		unsigned pending(void const* data[2], std::size_t size[2]) const noexcept;
+		void consume(std::size_t) noexcept;
+
+		bool empty() const noexcept;
+		std::size_t used() const noexcept;
+		std::size_t free() const noexcept;
+		bool writable() const noexcept;
+		/**
+		 * True if 'writable' changed since the last call
+		 */
+		bool crossed() noexcept;
+
+		void cork() noexcept;
+		void uncork() noexcept;
+		bool corked() const noexcept;
+
+		bool polling() const noexcept;
+		void polling(bool) noexcept;
+
+		void clear() noexcept;
+	private:
+		std::uint8_t	buffer_[Size];
+		std::size_t		begin_ = 0;
+		std::size_t		used_ = 0;
+		bool			writable_ = true;
+		bool			reported_ = true;
+		bool			corked_ = false;
+		bool			polling_ = false;
+};
+
+}//Reliable
+}//Transmission
+}//CoAP
+
+#include "impl/send_queue_impl.hpp"
+
+#endif /* COAP_TE_TRANSMISSION_RELIABLE_SEND_QUEUE_HPP__ */
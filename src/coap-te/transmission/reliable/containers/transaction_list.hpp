@@ -19,6 +19,7 @@ class transaction_list{
 		transaction_list();
 
 		Transaction* find_free_slot() noexcept;
+		Transaction* find_free_slot(handler socket) noexcept;
 
 		void check_all() noexcept;
 		Transaction* check_all_response(handler socket, CoAP::Message::Reliable::message const&) noexcept;
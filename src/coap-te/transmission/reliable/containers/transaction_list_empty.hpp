@@ -17,6 +17,7 @@ class transaction_list_empty{
 		transaction_list_empty(){}
 
 		transaction_t* find_free_slot() noexcept{ return nullptr; }
+		transaction_t* find_free_slot(int) noexcept{ return nullptr; }
 
 		void check_all() noexcept{}
 		transaction_t* check_all_response(int, CoAP::Message::Reliable::message const&) noexcept
@@ -0,0 +1,69 @@
+#ifndef COAP_TE_TRANSMISSION_RELIABLE_TRANSACTION_LIST_TABLE_HPP__
+#define COAP_TE_TRANSMISSION_RELIABLE_TRANSACTION_LIST_TABLE_HPP__
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include "../../../message/reliable/types.hpp"
+
+namespace CoAP{
+namespace Transmission{
+namespace Reliable{
+
+/**
+ * Transaction list with the transactions chained by socket
+ *
+ * Each slot taken with 'find_free_slot(socket)' is linked to the chain
+ * of the socket, and the chain heads are indexed by the socket descriptor
+ * (as connection_list_table). So, 'check_all_response(socket)' and
+ * 'cancel_all(socket)' only visit the transactions of that socket, not
+ * all the list.
+ *
+ * Transactions finish by themselves (response, timeout), so the slots
+ * are unlinked lazily: when walking the chain or when reused.
+ *
+ * Uses dynamic allocation (the chain heads, grown with 'new (std::nothrow)'),
+ * so must be explicitly included. If the allocation fails, no slot is given.
+ */
+template<typename Transaction,
+		unsigned Size>
+class transaction_list_table{
+	public:
+		using transaction_t = Transaction;
+		using handler = typename Transaction::handler;
+
+		transaction_list_table();
+
+		Transaction* find_free_slot(handler socket) noexcept;
+
+		void check_all() noexcept;
+		Transaction* check_all_response(handler socket, CoAP::Message::Reliable::message const&) noexcept;
+		void cancel_all() noexcept;
+		void cancel_all(handler socket) noexcept;
+
+		Transaction* operator[](unsigned index) noexcept;
+		constexpr unsigned size() const noexcept;
+	private:
+		static constexpr const unsigned none = Size;
+
+		unsigned head(handler socket) const noexcept;
+		bool link(unsigned index, handler socket) noexcept;
+		void unlink(unsigned index) noexcept;
+		bool grow(std::size_t size) noexcept;
+
+		transaction_t			list_[Size];
+		unsigned				next_[Size];
+		unsigned				prev_[Size];
+		handler					owner_[Size];
+		bool					linked_[Size];
+		std::unique_ptr<unsigned[]>	heads_;		///< Chain head, indexed by socket
+		std::size_t				heads_size_ = 0;
+};
+
+}//CoAP
+}//Transmission
+}//Reliable
+
+#include "impl/transaction_list_table_impl.hpp"
+
+#endif /* COAP_TE_TRANSMISSION_RELIABLE_TRANSACTION_LIST_TABLE_HPP__ */
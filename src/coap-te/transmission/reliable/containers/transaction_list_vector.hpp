@@ -18,6 +18,7 @@ class transaction_list_vector{
 		transaction_list_vector();
 
 		Transaction* find_free_slot() noexcept;
+		Transaction* find_free_slot(handler socket) noexcept;
 
 		void check_all() noexcept;
 		Transaction* check_all_response(handler socket, CoAP::Message::Reliable::message const&) noexcept;
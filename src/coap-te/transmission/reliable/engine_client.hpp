@@ -8,6 +8,7 @@
 #include "../../resource/node.hpp"
 #include "response.hpp"
 #include "request.hpp"
+#include "containers/receive_buffer.hpp"
 
 #include <type_traits>
 
@@ -177,6 +178,7 @@ class engine_client
 		csm_configure		server_csm_;
 		Connection			conn_;
 		std::uint8_t		buffer_[packet_size];
+		receive_buffer<packet_size>	rbuffer_;
 
 		default_response_cb default_cb_;
 };
@@ -78,6 +78,13 @@ class engine_server
 		using default_response_cb = typename std::conditional<has_default_callback,
 				CallbackDefaultFunctor, empty>::type;
 
+		/**
+		 * Called when a connection send queue crosses a watermark: writable
+		 * 'false' at the high watermark, 'true' when drained to the low one.
+		 * Never called if the connection doesn't have a send queue.
+		 */
+		using watermark_response_cb = void(*)(socket, bool writable, void* engine) noexcept;
+
 		engine_server();
 		~engine_server();
 
@@ -152,6 +159,19 @@ class engine_server
 		std::size_t send(socket, const void* buffer, std::size_t buffer_len,
 				CoAP::Error&) noexcept;
 
+		/**
+		 * Backpressure: false if the connection send queue reached its high
+		 * watermark (until it drains to the low watermark). Sending to a
+		 * not writable connection still queues while there is space.
+		 *
+		 * Always true if the connection doesn't have a send queue.
+		 *
+		 * Notifications (requests made from a observer) to a not writable
+		 * connection are not sent ('not_writable' error): use the watermark
+		 * callback to know when to resume.
+		 */
+		bool writable(socket) noexcept;
+
 		std::size_t send_abort(socket,
 				const char* payload, CoAP::Error& ec) noexcept;
 		std::size_t send_abort(socket, CoAP::Message::Option::option_abort&,
@@ -161,6 +181,7 @@ class engine_server
 		resource_root& root_node() noexcept;
 
 		void default_cb(default_response_cb cb) noexcept;
+		void watermark_cb(watermark_response_cb cb) noexcept;
 
 		void process(socket, std::uint8_t const* buffer, std::size_t buffer_len,
 				CoAP::Error& ec) noexcept;
@@ -185,8 +206,18 @@ class engine_server
 		void process_signaling_abort(socket, CoAP::Message::Reliable::message const&) noexcept;
 
 		bool on_read(socket) noexcept;
+		bool read_buffered(socket) noexcept;
 		void on_open(socket) noexcept;
 		void on_close(socket) noexcept;
+		void on_write(socket) noexcept;
+
+		std::size_t send(socket, connection_hold_t&,
+				const void* buffer, std::size_t buffer_len,
+				CoAP::Error&) noexcept;
+		void flush(socket, connection_hold_t&, CoAP::Error&) noexcept;
+		void watermark(socket, connection_hold_t&) noexcept;
+		void cork(socket, connection_hold_t&) noexcept;
+		void uncork(socket, connection_hold_t&) noexcept;
 
 		resource_root		resource_root_;
 
@@ -197,6 +228,7 @@ class engine_server
 		std::uint8_t			buffer_[packet_size];
 
 		default_response_cb default_cb_;
+		watermark_response_cb watermark_cb_ = nullptr;
 };
 
 }//CoAP
@@ -29,6 +29,18 @@ std::size_t make_abort_message(CoAP::Message::Option::option_abort&,
 void process_signaling_csm(csm_configure&,
 		CoAP::Message::Reliable::message const&) noexcept;
 
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+/**
+ * Maximum message size to send BERT blocks to the peer: the smaller of both
+ * Max-Message-Size. Returns 0 if any of the peers didn't indicate the
+ * Block-Wise-Transfer option (BERT not allowed).
+ *
+ * https://tools.ietf.org/html/rfc8323#section-6
+ */
+unsigned bert_message_size(csm_configure const& local,
+		csm_configure const& peer) noexcept;
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+
 }//Reliable
 }//Transmission
 }//CoAP
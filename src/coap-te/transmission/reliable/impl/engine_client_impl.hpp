@@ -110,6 +110,7 @@ close(const char* payload /* = nullptr */ [[maybe_unused]]) noexcept
 	}
 
 	conn_.close();
+	rbuffer_.clear();
 }
 
 template<typename Connection,
@@ -232,6 +233,9 @@ process_request(CoAP::Message::Reliable::message const& request,
 		response response(conn_.native(),
 				request.token, request.token_len,
 				buffer_, Config.max_message_size);
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+		response.bert(bert_message_size(Config, server_csm_));
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
 		if(res->call(request.mcode, request, response, this))
 		{
 			debug(engine_mod, "Method found");
@@ -458,9 +462,14 @@ read_packet(CoAP::Error& ec) noexcept
 {
 	if constexpr(Connection::set_length)
 	{
+		/**
+		 * The socket is read with as much data as available, and all the
+		 * complete messages are processed. A message partially received
+		 * is kept at the buffer until the next read.
+		 */
 		while(true)
 		{
-			std::size_t size = conn_.template receive<BlockTimeMs>(buffer_, 1, ec);
+			std::size_t size = conn_.template receive<BlockTimeMs>(rbuffer_.data(), rbuffer_.free(), ec);
 
 			if(ec)
 			{
@@ -469,58 +478,38 @@ read_packet(CoAP::Error& ec) noexcept
 			}
 
 			if(size == 0) break;
+			rbuffer_.commit(size);
 
-			using namespace CoAP::Message::Reliable;
-			unsigned shift = 0, length_s = 0;
-			extend_length length;
-
-			length = static_cast<extend_length>(buffer_[0] >> 4);
-			if(length == extend_length::one_byte)
-			{
-				shift = 1;
-				length_s = 13;
-			}
-			else if(length == extend_length::two_bytes)
-			{
-				shift = 2;
-				length_s = 269;
-			}
-			else if(length == extend_length::three_bytes)
+#if COAP_TE_TCP_CORK == 1
+			conn_.cork(true);
+#endif /* COAP_TE_TCP_CORK == 1 */
+			std::uint8_t const* msg;
+			while((msg = rbuffer_.next(size, packet_size, ec)) != nullptr)
 			{
-				shift = 3;
-				length_s = 65805;
-			}
-			else
-				length_s = static_cast<unsigned>(length);
+				CoAP::Error ecp;
+				process(msg, size, ecp);
 
-			if(shift)
-			{
-				size = conn_.receive(buffer_ + 1, shift, ec);
-				if(size < shift || ec)
+				if(ecp)
 				{
-					error(engine_mod, "message to small [%zd/u]", size, shift);
-					break;
+					error(engine_mod, ecp, "process");
 				}
 
-				unsigned value = 0;
-				CoAP::Helper::array_to_unsigned(buffer_ + 1, shift, value);
-				length_s += value;
+				/**
+				 * Connection closed while processing (abort/release)
+				 */
+				if(!conn_.is_open()) return true;
 			}
-			length_s += (buffer_[0] & 0x0F) /*token*/ + 1 /*code*/;
-			size = conn_.receive(buffer_ + 1 + shift, length_s, ec);
+#if COAP_TE_TCP_CORK == 1
+			conn_.cork(false);
+#endif /* COAP_TE_TCP_CORK == 1 */
 
-			if(size < length_s || ec)
-			{
-				error(engine_mod, "message to small [%zd/u]", size, length_s);
-				break;
-			}
-
-			CoAP::Error ecp;
-			process(buffer_, size + 1 + shift, ecp);
-
-			if(ecp)
+			if(ec)
 			{
-				error(engine_mod, ecp, "process");
+				/**
+				 * The stream can't be resynchronized
+				 */
+				error(engine_mod, ec, "message too big");
+				close<true>("message too big");
 				break;
 			}
 		}
@@ -75,7 +75,11 @@ close() noexcept
 	if constexpr(has_connection_list)
 	{
 		for(unsigned i = 0; i < conn_list_.size(); i++)
-			close_client<SendAbortMessage>(conn_list_[i]->socket());
+		{
+			connection_hold_t* conn = conn_list_[i];
+			if(conn && conn->is_used())
+				close_client<SendAbortMessage>(conn->socket());
+		}
 	}
 	conn_.close();
 }
@@ -121,7 +125,8 @@ close_client(socket sock, const char* payload [[maybe_unused]]) noexcept
 
 	if constexpr(SendAbortMessage)
 	{
-		send_abort(sock, payload);
+		CoAP::Error ec;
+		send_abort(sock, payload, ec);
 	}
 
 	conn_.close_client(sock);
@@ -154,7 +159,7 @@ process(socket sock, std::uint8_t
 			std::size_t bu = make_response_code_error<set_length>(msg,
 					buffer_, Config.max_message_size,
 					CoAP::Message::code::request_entity_too_large);
-			conn_.send(sock, buffer_, bu, ec);
+			send(sock, buffer_, bu, ec);
 		}
 		return;
 	}
@@ -193,7 +198,7 @@ process(socket sock, std::uint8_t
 			std::size_t bu = make_response_code_error<set_length>(msg,
 							buffer_, Config.max_message_size,
 							CoAP::Message::code::not_implemented);
-			conn_.send(sock, buffer_, bu, ec);
+			send(sock, buffer_, bu, ec);
 		}
 	}
 }
@@ -234,7 +239,7 @@ process_request(socket sock,
 		std::size_t bu = make_response_code_error<set_length>(
 				request, buffer_, Config.max_message_size,
 				CoAP::Message::code::not_found);
-		conn_.send(sock, buffer_, bu, ec);
+		send(sock, buffer_, bu, ec);
 	}
 	else
 	{
@@ -243,12 +248,19 @@ process_request(socket sock,
 		response response(sock,
 				request.token, request.token_len,
 				buffer_, Config.max_message_size);
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+		if constexpr(has_connection_list)
+		{
+			connection_hold_t* conn = conn_list_.find(sock);
+			if(conn) response.bert(bert_message_size(Config, conn->csm()));
+		}
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
 		if(res->call(request.mcode, request, response, this))
 		{
 			debug(engine_mod, "Method found");
 			if(!response.error() && response.buffer_used() > 0)
 			{
-				conn_.send(sock, response.buffer(), response.buffer_used(), ec);
+				send(sock, response.buffer(), response.buffer_used(), ec);
 			}
 		}
 		else
@@ -256,7 +268,7 @@ process_request(socket sock,
 			std::size_t bu = make_response_code_error<set_length>(
 					request, buffer_, Config.max_message_size,
 					CoAP::Message::code::method_not_allowed);
-			conn_.send(sock, buffer_, bu, ec);
+			send(sock, buffer_, bu, ec);
 		}
 	}
 }
@@ -430,6 +442,19 @@ default_cb(default_response_cb cb) noexcept
 	default_cb_ = cb;
 }
 
+template<typename Connection,
+	csm_configure const& Config,
+	typename ConnectionList,
+	typename TransactionList,
+	typename CallbackDefaultFunctor,
+	typename Resource>
+void
+engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefaultFunctor, Resource>::
+watermark_cb(watermark_response_cb cb) noexcept
+{
+	watermark_cb_ = cb;
+}
+
 template<typename Connection,
 	csm_configure const& Config,
 	typename ConnectionList,
@@ -445,11 +470,23 @@ run(CoAP::Error& ec) noexcept
 	using engine = engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefaultFunctor, Resource>;
 	using namespace std::placeholders;
 
-	conn_.template run<BlockTimeMs, MaxEvents>(
-				ec,
-				std::bind(&engine::on_read, this, _1),
-				std::bind(&engine::on_open, this, _1),
-				std::bind(&engine::on_close, this, _1));
+	if constexpr(connection_hold_t::has_send_queue)
+	{
+		conn_.template run<BlockTimeMs, MaxEvents>(
+					ec,
+					std::bind(&engine::on_read, this, _1),
+					std::bind(&engine::on_open, this, _1),
+					std::bind(&engine::on_close, this, _1),
+					std::bind(&engine::on_write, this, _1));
+	}
+	else
+	{
+		conn_.template run<BlockTimeMs, MaxEvents>(
+					ec,
+					std::bind(&engine::on_read, this, _1),
+					std::bind(&engine::on_open, this, _1),
+					std::bind(&engine::on_close, this, _1));
+	}
 
 	if(ec)
 	{
@@ -458,6 +495,22 @@ run(CoAP::Error& ec) noexcept
 		return false;
 	}
 
+#if COAP_TE_USE_SELECT == 1
+	/**
+	 * Select doesn't wait for the sockets to be writable, so pending
+	 * data is sent at each run
+	 */
+	if constexpr(connection_hold_t::has_send_queue)
+	{
+		for(unsigned i = 0; i < conn_list_.size(); i++)
+		{
+			connection_hold_t* conn = conn_list_[i];
+			if(conn && conn->is_used() && !conn->queue().empty())
+				on_write(conn->socket());
+		}
+	}
+#endif /* COAP_TE_USE_SELECT == 1 */
+
 	check_transactions();
 
 	return true;
@@ -476,6 +529,11 @@ on_read(socket sock) noexcept
 	debug(engine_mod, "On read [%d]", sock);
 	CoAP::Error ec;
 
+	if constexpr(Connection::set_length && connection_hold_t::has_receive_buffer)
+	{
+		if(conn_list_.find(sock)) return read_buffered(sock);
+	}
+
 	if constexpr(Connection::set_length)
 	{
 		while(true)
@@ -529,6 +587,15 @@ on_read(socket sock) noexcept
 				length_s += value;
 			}
 			length_s += (buffer_[0] & 0x0F) /*token*/ + 1 /*code*/;
+			if(1 + shift + length_s > packet_size)
+			{
+				/**
+				 * The stream can't be resynchronized
+				 */
+				error(engine_mod, "message too big [%u]", 1 + shift + length_s);
+				close_client<true>(sock, "message too big");
+				return true;
+			}
 			size = conn_.receive(sock, buffer_ + 1 + shift, length_s, ec);
 			if(ec) return false;
 
@@ -577,6 +644,133 @@ on_read(socket sock) noexcept
 	return ec ? false : true;
 }
 
+/**
+ * The socket is read to the connection buffer with as much data as
+ * available, and all the complete messages are processed. A message
+ * partially received is kept at the buffer until the next read.
+ */
+template<typename Connection,
+	csm_configure const& Config,
+	typename ConnectionList,
+	typename TransactionList,
+	typename CallbackDefaultFunctor,
+	typename Resource>
+bool
+engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefaultFunctor, Resource>::
+read_buffered(socket sock) noexcept
+{
+	static_assert(connection_hold_t::receive_buffer_size >= packet_size,
+			"Connection receive buffer must be at least the max message size");
+
+	CoAP::Error ec;
+	connection_hold_t* conn;
+	/**
+	 * Looking up at each read, as the callbacks called at 'uncork' (watermark)
+	 * may close connections
+	 */
+	while((conn = conn_list_.find(sock)) != nullptr)
+	{
+		auto& rbuffer = conn->buffer();
+		std::size_t size = conn_.receive(sock, rbuffer.data(), rbuffer.free(), ec);
+		if(ec)
+		{
+			error(engine_mod, ec, "read");
+			return false;
+		}
+
+		if(size == 0) break;
+		rbuffer.commit(size);
+
+		/**
+		 * All the responses to the messages of this read are sent together
+		 */
+		cork(sock, *conn);
+		std::uint8_t const* msg;
+		while((msg = conn->buffer().next(size, packet_size, ec)) != nullptr)
+		{
+			CoAP::Error ecp;
+			process(sock, msg, size, ecp);
+			if(ecp)
+			{
+				error(engine_mod, ecp, "process");
+			}
+
+			/**
+			 * Processing may close the connection (abort/release), and the
+			 * connection list may move/erase its entries: looking it up again
+			 */
+			conn = conn_list_.find(sock);
+			if(!conn) return true;
+		}
+		uncork(sock, *conn);
+
+		if(ec)
+		{
+			/**
+			 * The stream can't be resynchronized
+			 */
+			error(engine_mod, ec, "message too big");
+			close_client<true>(sock, "message too big");
+			return true;
+		}
+	}
+	return true;
+}
+
+/**
+ * Write coalescing: while corked, the messages sent to the connection are
+ * held and sent at once (one writev) when uncorked. If the connection
+ * doesn't have a send queue, TCP_CORK can be used (COAP_TE_TCP_CORK).
+ */
+template<typename Connection,
+	csm_configure const& Config,
+	typename ConnectionList,
+	typename TransactionList,
+	typename CallbackDefaultFunctor,
+	typename Resource>
+void
+engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefaultFunctor, Resource>::
+cork(socket sock [[maybe_unused]], connection_hold_t& conn [[maybe_unused]]) noexcept
+{
+	if constexpr(connection_hold_t::has_send_queue)
+		conn.queue().cork();
+#if COAP_TE_TCP_CORK == 1
+	else
+		conn_.cork(sock, true);
+#endif /* COAP_TE_TCP_CORK == 1 */
+}
+
+template<typename Connection,
+	csm_configure const& Config,
+	typename ConnectionList,
+	typename TransactionList,
+	typename CallbackDefaultFunctor,
+	typename Resource>
+void
+engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefaultFunctor, Resource>::
+uncork(socket sock [[maybe_unused]], connection_hold_t& conn [[maybe_unused]]) noexcept
+{
+	if constexpr(connection_hold_t::has_send_queue)
+	{
+		/**
+		 * Flushed before uncorking, so only what the socket didn't
+		 * accept is checked against the watermark
+		 */
+		CoAP::Error ec;
+		flush(sock, conn, ec);
+		if(ec)
+		{
+			error(engine_mod, ec, "flush");
+		}
+		conn.queue().uncork();
+		watermark(sock, conn);
+	}
+#if COAP_TE_TCP_CORK == 1
+	else
+		conn_.cork(sock, false);
+#endif /* COAP_TE_TCP_CORK == 1 */
+}
+
 template<typename Connection,
 	csm_configure const& Config,
 	typename ConnectionList,
@@ -591,7 +785,7 @@ on_open(socket sock) noexcept
 	if constexpr(has_connection_list)
 	{
 		debug(engine_mod, "Has conn[%d]", sock);
-		connection_hold_t* conn = conn_list_.find_free_slot();
+		connection_hold_t* conn = conn_list_.find_free_slot(sock);
 		if(!conn)
 		{
 			debug(engine_mod, "Conn not found[%d][%u/%u]", sock, conn_list_.ocupied(), conn_list_.size());
@@ -615,6 +809,28 @@ on_open(socket sock) noexcept
 	send(sock, buffer_, size, ec);
 }
 
+template<typename Connection,
+	csm_configure const& Config,
+	typename ConnectionList,
+	typename TransactionList,
+	typename CallbackDefaultFunctor,
+	typename Resource>
+void
+engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefaultFunctor, Resource>::
+on_write(socket sock) noexcept
+{
+	connection_hold_t* conn = conn_list_.find(sock);
+	if(!conn) return;
+
+	CoAP::Error ec;
+	flush(sock, *conn, ec);
+	if(ec)
+	{
+		error(engine_mod, ec, "flush");
+	}
+	watermark(sock, *conn);
+}
+
 template<typename Connection,
 	csm_configure const& Config,
 	typename ConnectionList,
@@ -54,7 +54,7 @@ send(socket sock, CoAP::Message::Reliable::Factory<BufferSize, Code> const& fac,
 {
 	if constexpr(has_transaction_list)
 	{
-		transaction_t* trans = list_.find_free_slot();
+		transaction_t* trans = list_.find_free_slot(sock);
 		if(!trans)
 		{
 			ec = CoAP::errc::transaction_ocupied;
@@ -95,6 +95,12 @@ engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefau
 send(request<Code>& req,
 		CoAP::Error& ec) noexcept
 {
+	if(req.notification() && !writable(req.socket()))
+	{
+		ec = CoAP::errc::not_writable;
+		return 0;
+	}
+
 	if constexpr(UseTransaction && has_transaction_list)
 		return send<SortOptions, CheckOpOrder, CheckOpRepeat>(req.socket(),
 				req.factory(), default_expiration, req.callback(), req.data(), ec);
@@ -119,6 +125,12 @@ send(request<Code>& req,
 	expiration_time_type time_ex,
 	CoAP::Error& ec) noexcept
 {
+	if(req.notification() && !writable(req.socket()))
+	{
+		ec = CoAP::errc::not_writable;
+		return 0;
+	}
+
 	return send<SortOptions, CheckOpOrder, CheckOpRepeat>(req.socket(),
 			req.factory(), time_ex, req.callback(), req.data(), ec);
 }
@@ -162,9 +174,143 @@ engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefau
 send(socket sock, const void* buffer, std::size_t buffer_len,
 		CoAP::Error& ec) noexcept
 {
+	if constexpr(connection_hold_t::has_send_queue)
+	{
+		connection_hold_t* conn = conn_list_.find(sock);
+		if(conn)
+		{
+			std::size_t size = send(sock, *conn, buffer, buffer_len, ec);
+			watermark(sock, *conn);
+			return size;
+		}
+	}
 	return conn_.send(sock, buffer, buffer_len, ec);
 }
 
+/**
+ * Data is sent directly if nothing is pending, and what the socket
+ * didn't accept is queued. If there is data pending, it's queued
+ * (keeping the order) and the queue is flushed. If corked, it's just
+ * queued (flushed first if there is no space).
+ *
+ * Returns 'buffer_len' if sent/queued, or 0 (and 'ec' set to
+ * 'send_queue_full') if there is no space to queue.
+ */
+template<typename Connection,
+	csm_configure const& Config,
+	typename ConnectionList,
+	typename TransactionList,
+	typename CallbackDefaultFunctor,
+	typename Resource>
+std::size_t
+engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefaultFunctor, Resource>::
+send(socket sock, connection_hold_t& conn,
+		const void* buffer, std::size_t buffer_len,
+		CoAP::Error& ec) noexcept
+{
+	static_assert(connection_hold_t::send_queue_t::queue_size >= packet_size,
+			"Connection send queue must be at least the max message size");
+
+	auto& queue = conn.queue();
+	if(queue.corked() || !queue.empty())
+	{
+		if(!queue.push(buffer, buffer_len))
+		{
+			if(queue.corked())
+			{
+				flush(sock, conn, ec);
+				if(ec) return 0;
+			}
+			if(!queue.push(buffer, buffer_len))
+			{
+				ec = CoAP::errc::send_queue_full;
+				return 0;
+			}
+		}
+		if(!queue.corked()) flush(sock, conn, ec);
+		return ec ? 0 : buffer_len;
+	}
+
+	std::size_t size = conn_.send(sock, buffer, buffer_len, ec);
+	if(ec) return 0;
+
+	if(size < buffer_len &&
+		!queue.push(static_cast<std::uint8_t const*>(buffer) + size, buffer_len - size))
+	{
+		ec = CoAP::errc::send_queue_full;
+		return size;
+	}
+
+	return buffer_len;
+}
+
+template<typename Connection,
+	csm_configure const& Config,
+	typename ConnectionList,
+	typename TransactionList,
+	typename CallbackDefaultFunctor,
+	typename Resource>
+void
+engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefaultFunctor, Resource>::
+flush(socket sock, connection_hold_t& conn, CoAP::Error& ec) noexcept
+{
+	auto& queue = conn.queue();
+
+	void const* data[2];
+	std::size_t size[2];
+	unsigned count = queue.pending(data, size);
+	if(!count) return;
+
+	queue.consume(conn_.send(sock, data, size, count, ec));
+}
+
+template<typename Connection,
+	csm_configure const& Config,
+	typename ConnectionList,
+	typename TransactionList,
+	typename CallbackDefaultFunctor,
+	typename Resource>
+void
+engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefaultFunctor, Resource>::
+watermark(socket sock, connection_hold_t& conn) noexcept
+{
+	auto& queue = conn.queue();
+
+	/**
+	 * The socket is polled to be writable only while there is data pending
+	 * (or every idle connection would wake the poll at each write)
+	 */
+	bool pending = !queue.empty() && !queue.corked();
+	if(pending != queue.polling())
+	{
+		queue.polling(pending);
+		conn_.poll_write(sock, pending);
+	}
+
+	if(!queue.crossed() || !watermark_cb_) return;
+
+	debug(engine_mod, "Watermark [%d][%s]", sock, queue.writable() ? "low" : "high");
+	watermark_cb_(sock, queue.writable(), this);
+}
+
+template<typename Connection,
+	csm_configure const& Config,
+	typename ConnectionList,
+	typename TransactionList,
+	typename CallbackDefaultFunctor,
+	typename Resource>
+bool
+engine_server<Connection, Config, ConnectionList, TransactionList, CallbackDefaultFunctor, Resource>::
+writable(socket sock) noexcept
+{
+	if constexpr(connection_hold_t::has_send_queue)
+	{
+		connection_hold_t* conn = conn_list_.find(sock);
+		if(conn) return conn->queue().writable();
+	}
+	return true;
+}
+
 template<typename Connection,
 	csm_configure const& Config,
 	typename ConnectionList,
@@ -96,6 +96,18 @@ inline void process_signaling_csm(csm_configure& csm,
 	}
 }
 
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+inline unsigned bert_message_size(csm_configure const& local,
+		csm_configure const& peer) noexcept
+{
+	if(!local.block_wise_transfer || !peer.block_wise_transfer)
+		return 0;
+
+	return local.max_message_size < peer.max_message_size ?
+				local.max_message_size : peer.max_message_size;
+}
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+
 }//Reliable
 }//Transmission
 }//CoAP
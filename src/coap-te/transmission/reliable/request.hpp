@@ -33,7 +33,7 @@ class Request{
 		template<bool SetOrderValue>
 		Request(CoAP::Observe::observe<handler, SetOrderValue> const& obs,
 				CoAP::Message::code mcode = CoAP::Message::code::content)
-		: socket_(obs.endpoint())
+		: socket_(obs.endpoint()), notification_(true)
 		{
 			fac_.code(mcode).token(obs.token(), obs.token_len());
 		}
@@ -98,6 +98,14 @@ class Request{
 			return data_;
 		}
 
+		/**
+		 * Made from a observer (not sent if the connection is not writable)
+		 */
+		bool notification() const noexcept
+		{
+			return notification_;
+		}
+
 		template<bool SetLength = true,
 				bool SortOptions = true,
 				bool CheckOpOrder = !SortOptions,
@@ -113,6 +121,7 @@ class Request{
 			fac_.reset();
 			cb_ = nullptr;
 			data_ = nullptr;
+			notification_ = false;
 		}
 
 	private:
@@ -121,6 +130,7 @@ class Request{
 
 		Callback_Functor cb_ = nullptr;
 		void* data_ = nullptr;
+		bool notification_ = false;
 };
 
 }//CoAP
@@ -2,6 +2,8 @@
 #define COAP_TE_TRANSMISSION_RELIABLE_RESPONSE_HPP__
 
 #include "../../message/reliable/factory.hpp"
+#include "../../message/reliable/serialize.hpp"
+#include "../block_wise.hpp"
 
 namespace CoAP{
 namespace Transmission{
@@ -50,6 +52,11 @@ class Response{
 			return socket_;
 		}
 
+		Handler const& endpoint() const noexcept
+		{
+			return socket_;
+		}
+
 		template<bool SetLength = true,
 				bool SortOptions = true,
 				bool CheckOpOrder = !SortOptions,
@@ -74,6 +81,83 @@ class Response{
 					SortOptions, CheckOpOrder, CheckOpRepeat>();
 		}
 
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+		/**
+		 * Maximum message size to send BERT blocks (set by the engine if both
+		 * peers indicated Block-Wise-Transfer at the CSM message). 0 disables BERT.
+		 *
+		 * https://tools.ietf.org/html/rfc8323#section-6
+		 */
+		void bert(unsigned max_message_size) noexcept
+		{
+			bert_size_ = max_message_size;
+		}
+
+		unsigned bert() const noexcept
+		{
+			return bert_size_;
+		}
+
+		/**
+		 * Serialize a Block2 response, slicing the full representation
+		 * according to the Block2 option of the request. If BERT is enabled,
+		 * the payload is the biggest multiple of 1024 bytes that fits at the
+		 * peer Max-Message-Size. If not, 'max_block_size' is used.
+		 *
+		 * https://tools.ietf.org/html/rfc7959#section-2.4
+		 *
+		 * Any payload set before is ignored. If the block requested is beyond the
+		 * representation, a 4.02 (Bad Option) response is serialized.
+		 *
+		 * Returns the number of bytes serialized.
+		 */
+		template<bool SetLength = true,
+				typename Message>
+		std::size_t serialize_block2(Message const& request,
+				void const* representation, std::size_t size,
+				unsigned max_block_size = default_block_size,
+				void const* etag = nullptr, std::size_t etag_len = 0) noexcept
+		{
+			return serialize_block2<SetLength>(request,
+					representation, nullptr, nullptr, size,
+					max_block_size, etag, etag_len);
+		}
+
+		/**
+		 * Same as above, but the block is read directly to the response buffer by
+		 * the provider callback
+		 */
+		template<bool SetLength = true,
+				typename Message>
+		std::size_t serialize_block2(Message const& request,
+				block2_read_cb read, void* data, std::size_t size,
+				unsigned max_block_size = default_block_size,
+				void const* etag = nullptr, std::size_t etag_len = 0) noexcept
+		{
+			return serialize_block2<SetLength>(request,
+					nullptr, read, data, size,
+					max_block_size, etag, etag_len);
+		}
+
+		/**
+		 * Serialize the block requested of a ongoing transfer (see block2_list). The
+		 * transfer is released after the last block is sent.
+		 */
+		template<bool SetLength = true,
+				typename Message>
+		std::size_t serialize_block2(Message const& request,
+				block2_transfer<Handler>& transfer,
+				unsigned max_block_size = default_block_size) noexcept
+		{
+			std::size_t size = serialize_block2<SetLength>(request,
+					transfer.representation, transfer.read, transfer.data, transfer.size,
+					max_block_size, transfer.etag, sizeof(transfer.etag));
+			if(ec_ || !last_block_.more) transfer.clear();
+
+			return size;
+		}
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+
 		std::uint8_t* buffer() noexcept{ return buffer_; }
 		std::size_t buffer_used() const noexcept{ return buffer_used_; }
 		CoAP::Error error() const noexcept{ return ec_; }
@@ -87,6 +171,148 @@ class Response{
 		}
 
 	private:
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+		template<bool SetLength,
+				typename Message>
+		std::size_t serialize_block2(Message const& request,
+				void const* representation,
+				block2_read_cb read, void* data,
+				std::size_t size,
+				unsigned max_block_size,
+				void const* etag, std::size_t etag_len) noexcept
+		{
+			using namespace CoAP::Message;
+
+			block_param& param = last_block_;
+			param = block_param{};
+			bool found = true;
+#if COAP_TE_RELIABLE_CONNECTION == 1
+			unsigned limit = static_cast<unsigned>(
+					bert_size_ < buffer_len_ ? bert_size_ : buffer_len_);
+			if(limit > bert_unit)
+			{
+				found = get_block2_bert(request, size, limit, param);
+				if(found && param.bert)
+				{
+					/**
+					 * Serializing without payload to measure the header/options: the block
+					 * option size doesn't depend of the 'more' flag (SZX = 7).
+					 * 5 bytes are reserved to the payload marker and length extension.
+					 */
+					block_param hparam = param;
+					hparam.length = 0;
+					std::size_t header = serialize_block<SetLength>(Option::code::block2, hparam,
+									nullptr, nullptr, nullptr, size,
+									has_size2(request, param), etag, etag_len);
+					if(ec_) return 0;
+					found = get_block2_bert(request, size,
+							header + 5 < limit ? static_cast<unsigned>(limit - header - 5) : 0,
+							param);
+				}
+			}
+			else
+#endif /* COAP_TE_RELIABLE_CONNECTION == 1 */
+				found = get_block2(request, size, max_block_size, param, true);
+
+			if(!found)
+			{
+				/**
+				 * https://tools.ietf.org/html/rfc7959#section-2.2
+				 */
+				param.more = false;
+				fac_.code(CoAP::Message::code::bad_option);
+				fac_.payload(nullptr, 0);
+				ec_.clear();
+				buffer_used_ = fac_.template serialize<SetLength>(buffer_, buffer_len_, ec_);
+				return buffer_used_;
+			}
+
+			return serialize_block<SetLength>(Option::code::block2, param,
+					representation, read, data, size,
+					has_size2(request, param), etag, etag_len);
+		}
+
+		template<bool SetLength>
+		std::size_t serialize_block(CoAP::Message::Option::code ocode,
+				block_param const& param,
+				void const* representation,
+				block2_read_cb read, void* data,
+				std::size_t size,
+				bool add_size,
+				void const* etag, std::size_t etag_len) noexcept
+		{
+			using namespace CoAP::Message;
+
+			unsigned block;
+			CoAP::Transmission::make_block(block, param);
+			Option::node block_op{ocode, block};
+
+			unsigned size2 = static_cast<unsigned>(size);
+			Option::node size2_op{Option::code::size2, size2};
+
+			Option::node etag_op{Option::code::etag, etag, static_cast<unsigned>(etag_len)};
+
+			fac_.add_option(block_op);
+			if(add_size) fac_.add_option(size2_op);
+			if(etag_len) fac_.add_option(etag_op);
+
+			if(representation)
+				fac_.payload(static_cast<std::uint8_t const*>(representation) + param.offset,
+								param.length);
+			else
+				fac_.payload(nullptr, 0);
+
+			bool provider = !representation && read && param.length;
+
+			ec_.clear();
+			buffer_used_ = provider ?
+					fac_.template serialize<false>(buffer_, buffer_len_, ec_) :
+					fac_.template serialize<SetLength>(buffer_, buffer_len_, ec_);
+
+			fac_.remove_option(block_op);
+			if(add_size) fac_.remove_option(size2_op);
+			if(etag_len) fac_.remove_option(etag_op);
+			fac_.payload(nullptr, 0);
+
+			if(ec_ || !provider) return buffer_used_;
+
+			/**
+			 * Provider: reading block directly to the response buffer. The message
+			 * length is set after (it depends of the payload size)
+			 */
+			if((buffer_len_ - buffer_used_) < (param.length + 1))
+			{
+				ec_ = CoAP::errc::insufficient_buffer;
+				buffer_used_ = 0;
+				return 0;
+			}
+			std::size_t readed = read(buffer_ + buffer_used_ + 1, param.offset, param.length, data);
+			if(readed)
+			{
+				buffer_[buffer_used_] = CoAP::Message::payload_marker;
+				buffer_used_ += readed + 1;
+			}
+
+			if constexpr(SetLength)
+				buffer_used_ = CoAP::Message::Reliable::set_message_length(buffer_,
+						buffer_len_, buffer_used_, buffer_used_ - 2 - token_len_, ec_);
+
+			return buffer_used_;
+		}
+
+		template<typename Message>
+		static bool has_size2(Message const& request, block_param const& param) noexcept
+		{
+			using namespace CoAP::Message;
+
+			Option::option opt;
+			return param.number == 0 || Option::get_option(request, opt, Option::code::size2);
+		}
+
+		unsigned				bert_size_ = 0;
+		block_param				last_block_;
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+
 		CoAP::Message::Reliable::Factory<>
 									fac_;
 		Handler	 					socket_;
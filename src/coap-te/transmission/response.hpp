@@ -5,6 +5,7 @@
 #include "../port/port.hpp"
 #include "../message/factory.hpp"
 #include "../message/serialize.hpp"
+#include "block_wise.hpp"
 
 namespace CoAP{
 namespace Transmission{
@@ -66,9 +67,26 @@ class Response{
 				bool CheckOpRepeat = true>
 		std::size_t serialize() noexcept
 		{
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+			if(auto_block_size_)
+			{
+				if(block2_ongoing()) return serialize_auto_transfer();
+				if(auto_read_) return serialize_auto_representation();
+				if(auto_representation_) fac_.payload(auto_representation_, auto_size_);
+				if(auto_has_block2_
+					&& (fac_.payload_size() > auto_block_size()
+						|| CoAP::Message::Option::block_szx(auto_block2_) == 7))
+					return serialize_auto_representation();
+			}
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
 			ec_.clear();
 			buffer_used_ = fac_.template serialize<SortOptions, CheckOpOrder, CheckOpRepeat>(
 					buffer_, buffer_len_, mid_, ec_);
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+			if(auto_block_size_ && ec_ == CoAP::errc::insufficient_buffer
+				&& fac_.payload_size() > auto_block_size_)
+				return serialize_auto_representation();
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
 			return buffer_used_;
 		}
 
@@ -92,6 +110,208 @@ class Response{
 			return buffer_used_;
 		}
 
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+		/**
+		 * Automatic Block2, set by the engine: 'serialize' slices the payload
+		 * (the full representation) as 'serialize_block2' if the request has a
+		 * Block2 option and the payload is bigger than the block asked, or if
+		 * the payload doesn't fit at the buffer (using 'max_block_size').
+		 * 0 disables.
+		 *
+		 * 'transfer' is the ongoing transfer of this request, or a free slot
+		 * (not used) to start one (see 'representation'). Without it, the
+		 * payload is sliced stateless: the handler generates the representation
+		 * again at every block, and the ETag is the hash of the payload.
+		 */
+		template<typename Message>
+		void auto_block2(Message const& request, unsigned max_block_size,
+				block2_transfer<Endpoint>* transfer = nullptr) noexcept
+		{
+			using namespace CoAP::Message;
+
+			Option::option opt;
+			auto_transfer_ = transfer;
+			auto_block_size_ = max_block_size;
+			auto_has_block2_ = Option::get_option(request, opt, Option::code::block2);
+			auto_block2_ = auto_has_block2_ ? Option::parse_unsigned(opt) : 0;
+			auto_size2_ = Option::get_option(request, opt, Option::code::size2);
+		}
+
+		/**
+		 * Automatic Block2: a transfer of this request is ongoing. The representation
+		 * set at the first block is kept, and 'serialize' sends the block requested
+		 * from it (any payload set is ignored), so the handler doesn't need to
+		 * generate it again.
+		 */
+		bool block2_ongoing() const noexcept
+		{
+			return auto_transfer_ && auto_transfer_->used;
+		}
+
+		/**
+		 * Automatic Block2: full representation, that must be valid until the
+		 * transfer ends (last block sent or expired). If bigger than a block, a
+		 * transfer is started: the next blocks are sliced from it (the handler
+		 * can check 'block2_ongoing' to not generate it again), and all blocks
+		 * carry the same ETag.
+		 *
+		 * If there is no transfer slot, it's sliced stateless (as the payload).
+		 */
+		Response& representation(void const* data, std::size_t size) noexcept
+		{
+			auto_representation_ = data;
+			auto_read_ = nullptr;
+			auto_size_ = size;
+			return *this;
+		}
+
+		/**
+		 * Same as above, but the blocks are read by the provider callback. Stateless
+		 * (no transfer slot), the blocks are sent without ETag.
+		 */
+		Response& representation(block2_read_cb read, void* data, std::size_t size) noexcept
+		{
+			auto_representation_ = nullptr;
+			auto_read_ = read;
+			auto_read_data_ = data;
+			auto_size_ = size;
+			return *this;
+		}
+
+		/**
+		 * Serialize a Block2 response, slicing the full representation
+		 * according to the Block2 option of the request. Size2 is sent at
+		 * the first block (or if requested), and the ETag (if any) at all blocks.
+		 *
+		 * https://tools.ietf.org/html/rfc7959#section-2.4
+		 *
+		 * Any payload set before is ignored. If the block requested is beyond the
+		 * representation, a 4.02 (Bad Option) response is serialized (4.00 if
+		 * it has the reserved SZX = 7).
+		 *
+		 * Returns the number of bytes serialized.
+		 */
+		template<typename Message>
+		std::size_t serialize_block2(Message const& request,
+				void const* representation, std::size_t size,
+				unsigned max_block_size = default_block_size,
+				void const* etag = nullptr, std::size_t etag_len = 0) noexcept
+		{
+			block_param param;
+			if(!get_block2(request, size, max_block_size, param))
+				return serialize_block_out_of_range(block2_reserved(request));
+
+			return serialize_block(CoAP::Message::Option::code::block2, param,
+					representation, nullptr, nullptr, size,
+					has_size2(request, param), etag, etag_len);
+		}
+
+		/**
+		 * Same as above, but the block is read directly to the response buffer by
+		 * the provider callback
+		 */
+		template<typename Message>
+		std::size_t serialize_block2(Message const& request,
+				block2_read_cb read, void* data, std::size_t size,
+				unsigned max_block_size = default_block_size,
+				void const* etag = nullptr, std::size_t etag_len = 0) noexcept
+		{
+			block_param param;
+			if(!get_block2(request, size, max_block_size, param))
+				return serialize_block_out_of_range(block2_reserved(request));
+
+			return serialize_block(CoAP::Message::Option::code::block2, param,
+					nullptr, read, data, size,
+					has_size2(request, param), etag, etag_len);
+		}
+
+		/**
+		 * Serialize the block requested of a ongoing transfer (see block2_list). The
+		 * transfer is released after the last block is sent.
+		 */
+		template<typename Message>
+		std::size_t serialize_block2(Message const& request,
+				block2_transfer<Endpoint>& transfer,
+				unsigned max_block_size = default_block_size) noexcept
+		{
+			block_param param;
+			if(!get_block2(request, transfer.size, max_block_size, param))
+			{
+				transfer.clear();
+				return serialize_block_out_of_range(block2_reserved(request));
+			}
+
+			std::size_t size = serialize_block(CoAP::Message::Option::code::block2, param,
+					transfer.representation, transfer.read, transfer.data, transfer.size,
+					has_size2(request, param), transfer.etag, sizeof(transfer.etag));
+			if(ec_ || !param.more) transfer.clear();
+
+			return size;
+		}
+
+		/**
+		 * Serialize the block defined by 'param', using the block option 'ocode'
+		 * (Block2 or Q-Block2). Size2 is added if 'add_size' is set.
+		 */
+		std::size_t serialize_block(CoAP::Message::Option::code ocode,
+				block_param const& param,
+				void const* representation,
+				block2_read_cb read, void* data,
+				std::size_t size,
+				bool add_size,
+				void const* etag, std::size_t etag_len) noexcept
+		{
+			using namespace CoAP::Message;
+
+			unsigned block;
+			CoAP::Transmission::make_block(block, param);
+			Option::node block_op{ocode, block};
+
+			unsigned size2 = static_cast<unsigned>(size);
+			Option::node size2_op{Option::code::size2, size2};
+
+			Option::node etag_op{Option::code::etag, etag, static_cast<unsigned>(etag_len)};
+
+			fac_.add_option(block_op);
+			if(add_size) fac_.add_option(size2_op);
+			if(etag_len) fac_.add_option(etag_op);
+
+			if(representation)
+				fac_.payload(static_cast<std::uint8_t const*>(representation) + param.offset,
+								param.length);
+			else
+				fac_.payload(nullptr, 0);
+
+			ec_.clear();
+			buffer_used_ = fac_.serialize(buffer_, buffer_len_, mid_, ec_);
+
+			fac_.remove_option(block_op);
+			if(add_size) fac_.remove_option(size2_op);
+			if(etag_len) fac_.remove_option(etag_op);
+			fac_.payload(nullptr, 0);
+
+			if(ec_ || representation || !read || !param.length) return buffer_used_;
+
+			/**
+			 * Provider: reading block directly to the response buffer
+			 */
+			if((buffer_len_ - buffer_used_) < (param.length + 1))
+			{
+				ec_ = CoAP::errc::insufficient_buffer;
+				buffer_used_ = 0;
+				return 0;
+			}
+			std::size_t readed = read(buffer_ + buffer_used_ + 1, param.offset, param.length, data);
+			if(readed)
+			{
+				buffer_[buffer_used_] = payload_marker;
+				buffer_used_ += readed + 1;
+			}
+
+			return buffer_used_;
+		}
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+
 		std::uint8_t* buffer() noexcept{ return buffer_; }
 		std::size_t buffer_used() const noexcept{ return buffer_used_; }
 		CoAP::Error error() const noexcept{ return ec_; }
@@ -106,6 +326,108 @@ class Response{
 		}
 
 	private:
+#if COAP_TE_BLOCKWISE_TRANSFER == 1
+		template<typename Message>
+		static bool has_size2(Message const& request, block_param const& param) noexcept
+		{
+			using namespace CoAP::Message;
+
+			Option::option opt;
+			return param.number == 0 || Option::get_option(request, opt, Option::code::size2);
+		}
+
+		/**
+		 * Block beyond the representation (4.02), or with the reserved SZX = 7 (4.00)
+		 *
+		 * https://tools.ietf.org/html/rfc7959#section-2.2
+		 */
+		std::size_t serialize_block_out_of_range(bool reserved) noexcept
+		{
+			code(reserved ? CoAP::Message::code::bad_request : CoAP::Message::code::bad_option);
+			fac_.payload(nullptr, 0);
+			ec_.clear();
+			buffer_used_ = fac_.serialize(buffer_, buffer_len_, mid_, ec_);
+			return buffer_used_;
+		}
+
+		unsigned auto_block_size() const noexcept
+		{
+			if(!auto_has_block2_) return auto_block_size_;
+
+			unsigned req_size = CoAP::Message::Option::block_size(auto_block2_);
+			return req_size < auto_block_size_ ? req_size : auto_block_size_;
+		}
+
+		/**
+		 * Starts a transfer if there is a slot (and more than one block), or
+		 * slices stateless
+		 */
+		std::size_t serialize_auto_representation() noexcept
+		{
+			void const* representation = auto_read_ ? nullptr : fac_.payload_data();
+			std::size_t size = auto_read_ ? auto_size_ : fac_.payload_size();
+
+			if(auto_transfer_ && size > auto_block_size())
+			{
+				auto_transfer_->representation = representation;
+				auto_transfer_->read = auto_read_;
+				auto_transfer_->data = auto_read_data_;
+				auto_transfer_->size = size;
+				/**
+				 * The payload memory is only kept if set as 'representation'
+				 */
+				auto_transfer_->used = auto_read_ || auto_representation_;
+				if(auto_transfer_->used) return serialize_auto_transfer();
+			}
+
+			block_param param;
+			if(!get_block2(auto_has_block2_, auto_block2_, size, auto_block_size_, param))
+				return serialize_block_out_of_range(auto_has_block2_
+						&& CoAP::Message::Option::block_szx(auto_block2_) == 7);
+
+			/**
+			 * Stateless: the ETag is the hash of the representation, so it's the
+			 * same at all blocks while the representation doesn't change
+			 */
+			std::uint32_t etag = 0;
+			if(representation) etag = CoAP::Cache::hash(representation, size);
+
+			return serialize_block(CoAP::Message::Option::code::block2, param,
+					representation, auto_read_, auto_read_data_, size,
+					param.number == 0 || auto_size2_,
+					&etag, representation ? sizeof(etag) : 0);
+		}
+
+		std::size_t serialize_auto_transfer() noexcept
+		{
+			block2_transfer<Endpoint>& transfer = *auto_transfer_;
+			block_param param;
+			if(!get_block2(auto_has_block2_, auto_block2_, transfer.size, auto_block_size_, param))
+			{
+				transfer.clear();
+				return serialize_block_out_of_range(auto_has_block2_
+						&& CoAP::Message::Option::block_szx(auto_block2_) == 7);
+			}
+
+			std::size_t size = serialize_block(CoAP::Message::Option::code::block2, param,
+					transfer.representation, transfer.read, transfer.data, transfer.size,
+					param.number == 0 || auto_size2_, transfer.etag, sizeof(transfer.etag));
+			if(ec_ || !param.more) transfer.clear();
+
+			return size;
+		}
+
+		unsigned	auto_block_size_ = 0;
+		unsigned	auto_block2_ = 0;
+		bool		auto_has_block2_ = false;
+		bool		auto_size2_ = false;
+		block2_transfer<Endpoint>*	auto_transfer_ = nullptr;
+		void const*			auto_representation_ = nullptr;
+		block2_read_cb		auto_read_ = nullptr;
+		void*				auto_read_data_ = nullptr;
+		std::size_t			auto_size_ = 0;
+#endif /* COAP_TE_BLOCKWISE_TRANSFER == 1 */
+
 		CoAP::Message::Factory<> 	fac_;
 		Endpoint 					ep_;
 		std::uint16_t 				mid_;
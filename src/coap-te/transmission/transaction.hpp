@@ -7,6 +7,7 @@
 
 #include "types.hpp"
 #include "../message/factory.hpp"
+#include "../message/request_template.hpp"
 #include "../message/types.hpp"
 #include "../internal/meta.hpp"
 
@@ -66,6 +67,15 @@ class transaction
 				std::uint16_t mid,
 				CoAP::Error&) noexcept;
 
+		/**
+		 * To be used with internal buffer (copy of the pre-serialized request)
+		 */
+		template<std::size_t TemplateSize,
+				unsigned TemplateRegions>
+		std::size_t serialize(CoAP::Message::request_template<TemplateSize, TemplateRegions> const&,
+				std::uint16_t mid,
+				CoAP::Error&) noexcept;
+
 		bool init(configure const&,
 				endpoint_t const&,
 				Callback_Functor, void*,
@@ -88,6 +98,13 @@ class transaction
 		template<bool CheckMaxSpan = false>
 		bool check() noexcept;
 
+		/**
+		 * Only the header (type, code, message id and token) of the
+		 * response is used to match the transaction
+		 */
+		template<bool CheckEndpoint = true, bool CheckToken = true>
+		bool match_response(endpoint_t const& ep,
+				CoAP::Message::message const& response) const noexcept;
 		template<bool CheckEndpoint = true, bool CheckToken = true>
 		bool check_response(endpoint_t const& ep,
 				CoAP::Message::message const& response) noexcept;
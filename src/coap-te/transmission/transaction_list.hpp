@@ -29,6 +29,12 @@ class transaction_list{
 		Transaction* find_free_slot() noexcept;
 
 		void check_all() noexcept;
+		/**
+		 * Search the transaction of the response (only the header is
+		 * checked), without calling the callback
+		 */
+		template<bool CheckEndpoint, bool CheckToken>
+		Transaction* find_response(endpoint const&, CoAP::Message::message const&) noexcept;
 		template<bool CheckEndpoint, bool CheckToken>
 		Transaction* check_all_response(endpoint const&, CoAP::Message::message const&) noexcept;
 
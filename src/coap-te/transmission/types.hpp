@@ -17,7 +17,7 @@ struct configure{
 	double			ack_random_factor 				= 1.5;	//ACK_RANDOM_FACTOR
 	unsigned int	max_restransmission 			= 4;	//MAX_RETRANSMIT
 //	unsigned int	max_interaction 				= 1;	//NSTART
-//	unsigned int	default_leisure_seconds 		= 5;	//DEFAULT_LEISURE
+	unsigned int	default_leisure_seconds 		= 5;	//DEFAULT_LEISURE
 //	double			probing_rate_byte_per_seconds 	= 1;	//PROBING_RATE
 };
 